@@ -22,6 +22,7 @@
 #include "Cafe/OS/libs/snd_core/ax.h"
 #include "Cafe/OS/RPL/rpl.h"
 #include "Cafe/HW/Latte/Core/Latte.h"
+#include "Cafe/HW/Latte/Core/LatteCapture.h"
 #include "Cafe/Filesystem/FST/FST.h"
 #include "Common/FileStream.h"
 #include "GamePatch.h"
@@ -1001,6 +1002,7 @@ namespace CafeSystem
 		if(!sSystemRunning)
 			return;
         coreinit::OSSchedulerEnd();
+        LatteCapture_Shutdown();
         Latte_Stop();
         // reset Cafe OS userspace modules
         snd_core::reset();
@@ -1013,6 +1015,7 @@ namespace CafeSystem
 			(*it)->TitleStop();
         // reset Cemu subsystems
         PPCRecompiler_Shutdown();
+        PPCInterpreterSlim_resetBlockCache();
         GraphicPack2::Reset();
         UnmountCurrentTitle();
         MlcStorageUnmountAllTitles();
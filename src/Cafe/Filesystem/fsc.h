@@ -203,6 +203,7 @@ bool FSCDeviceWUD_Mount(std::string_view mountPath, std::string_view destination
 
 // wua device
 bool FSCDeviceWUA_Mount(std::string_view mountPath, std::string_view destinationBaseDir, class ZArchiveReader* archive, sint32 priority);
+void FSCDeviceWUA_PurgeCache(class ZArchiveReader* archive);
 
 // wuhb device
 bool FSCDeviceWUHB_Mount(std::string_view mountPath, std::string_view destinationBaseDir, class WUHBReader* wuhbReader, sint32 priority);
@@ -1,5 +1,221 @@
 #include "Cafe/Filesystem/fsc.h"
+#include "util/helpers/helpers.h"
 #include <zarchive/zarchivereader.h>
+#include <list>
+#include <deque>
+#include <condition_variable>
+
+// cache of decompressed file data shared across all open WUA files
+// data is stored in fixed size blocks which are evicted in LRU order. Sequential reads will queue up the following blocks for decompression on a background thread
+class WuaBlockCache
+{
+	static constexpr uint32 BLOCK_SIZE = 64 * 1024;
+	static constexpr size_t MAX_CACHED_BLOCKS = 512; // 32MiB
+	static constexpr size_t MAX_QUEUED_PREFETCHES = 64;
+	static constexpr uint32 BYPASS_READ_SIZE = 512 * 1024; // reads of this size or bigger go straight to the archive
+
+	struct BlockKey
+	{
+		ZArchiveReader* archive;
+		ZArchiveNodeHandle nodeHandle;
+		uint32 blockIndex;
+
+		bool operator==(const BlockKey& other) const
+		{
+			return archive == other.archive && nodeHandle == other.nodeHandle && blockIndex == other.blockIndex;
+		}
+	};
+
+	struct BlockKeyHasher
+	{
+		size_t operator()(const BlockKey& key) const
+		{
+			size_t h = std::hash<ZArchiveReader*>()(key.archive);
+			h ^= ((size_t)key.nodeHandle * 0x9E3779B97F4A7C15ULL) + ((size_t)key.blockIndex << 1);
+			return h;
+		}
+	};
+
+	using BlockData = std::shared_ptr<const std::vector<uint8>>;
+
+	struct CachedBlock
+	{
+		BlockData data;
+		std::list<BlockKey>::iterator lruItr;
+	};
+
+	struct PrefetchRequest
+	{
+		BlockKey key;
+		uint32 fileSize;
+	};
+
+public:
+	~WuaBlockCache()
+	{
+		std::unique_lock _l(m_mutex);
+		m_stopThread = true;
+		_l.unlock();
+		m_prefetchCondVar.notify_one();
+		if (m_prefetchThread.joinable())
+			m_prefetchThread.join();
+	}
+
+	uint32 Read(ZArchiveReader* archive, ZArchiveNodeHandle nodeHandle, uint32 fileSize, uint32 offset, uint32 size, uint8* buffer)
+	{
+		if (size >= BYPASS_READ_SIZE)
+			return (uint32)archive->ReadFromFile(nodeHandle, offset, size, buffer);
+		uint32 bytesRead = 0;
+		while (bytesRead < size)
+		{
+			uint32 pos = offset + bytesRead;
+			uint32 blockOffset = pos % BLOCK_SIZE;
+			BlockData block = GetBlock({archive, nodeHandle, pos / BLOCK_SIZE}, fileSize);
+			if (blockOffset >= block->size())
+				break;
+			uint32 copySize = std::min<uint32>((uint32)block->size() - blockOffset, size - bytesRead);
+			memcpy(buffer + bytesRead, block->data() + blockOffset, copySize);
+			bytesRead += copySize;
+			if (block->size() < BLOCK_SIZE)
+				break; // end of file or read error
+		}
+		return bytesRead;
+	}
+
+	// queue decompression of the blocks following the given file offset
+	void Prefetch(ZArchiveReader* archive, ZArchiveNodeHandle nodeHandle, uint32 fileSize, uint32 offset, uint32 blockCount)
+	{
+		uint32 firstBlock = offset / BLOCK_SIZE;
+		uint32 endBlock = std::min<uint32>(firstBlock + blockCount, (fileSize + BLOCK_SIZE - 1) / BLOCK_SIZE);
+		std::unique_lock _l(m_mutex);
+		if (m_stopThread)
+			return;
+		for (uint32 i = firstBlock; i < endBlock; i++)
+		{
+			BlockKey key{archive, nodeHandle, i};
+			if (m_blocks.find(key) != m_blocks.end() || m_blocksInFlight.find(key) != m_blocksInFlight.end())
+				continue;
+			if (std::find_if(m_prefetchQueue.begin(), m_prefetchQueue.end(), [&](const PrefetchRequest& r) { return r.key == key; }) != m_prefetchQueue.end())
+				continue;
+			if (m_prefetchQueue.size() >= MAX_QUEUED_PREFETCHES)
+				m_prefetchQueue.pop_front(); // drop the oldest request, it's the least likely to still be useful
+			m_prefetchQueue.push_back({key, fileSize});
+		}
+		if (!m_prefetchThread.joinable())
+			m_prefetchThread = std::thread(&WuaBlockCache::PrefetchThread, this);
+		_l.unlock();
+		m_prefetchCondVar.notify_one();
+	}
+
+	// drop all blocks and pending prefetches of an archive. Must be called before the archive is deleted
+	void Purge(ZArchiveReader* archive)
+	{
+		std::unique_lock _l(m_mutex);
+		std::erase_if(m_prefetchQueue, [&](const PrefetchRequest& r) { return r.key.archive == archive; });
+		m_blockLoadedCondVar.wait(_l, [&]() {
+			return std::none_of(m_blocksInFlight.begin(), m_blocksInFlight.end(), [&](const BlockKey& key) { return key.archive == archive; });
+		});
+		for (auto it = m_blocks.begin(); it != m_blocks.end();)
+		{
+			if (it->first.archive == archive)
+			{
+				m_lruList.erase(it->second.lruItr);
+				it = m_blocks.erase(it);
+			}
+			else
+				++it;
+		}
+	}
+
+	static WuaBlockCache& instance()
+	{
+		static WuaBlockCache _instance;
+		return _instance;
+	}
+
+private:
+	static BlockData LoadBlock(const BlockKey& key, uint32 fileSize)
+	{
+		uint32 blockStart = key.blockIndex * BLOCK_SIZE;
+		uint32 blockSize = blockStart < fileSize ? std::min<uint32>(fileSize - blockStart, BLOCK_SIZE) : 0;
+		auto data = std::make_shared<std::vector<uint8>>(blockSize);
+		if (blockSize > 0)
+			data->resize((size_t)key.archive->ReadFromFile(key.nodeHandle, blockStart, blockSize, data->data()));
+		return data;
+	}
+
+	// m_mutex must be held
+	void InsertBlock(const BlockKey& key, BlockData data)
+	{
+		while (m_blocks.size() >= MAX_CACHED_BLOCKS)
+		{
+			m_blocks.erase(m_lruList.back());
+			m_lruList.pop_back();
+		}
+		m_lruList.push_front(key);
+		m_blocks.emplace(key, CachedBlock{std::move(data), m_lruList.begin()});
+	}
+
+	BlockData GetBlock(const BlockKey& key, uint32 fileSize)
+	{
+		std::unique_lock _l(m_mutex);
+		while (true)
+		{
+			auto it = m_blocks.find(key);
+			if (it != m_blocks.end())
+			{
+				m_lruList.splice(m_lruList.begin(), m_lruList, it->second.lruItr);
+				return it->second.data;
+			}
+			if (m_blocksInFlight.find(key) == m_blocksInFlight.end())
+				break;
+			m_blockLoadedCondVar.wait(_l); // block is currently being decompressed by the prefetch thread
+		}
+		m_blocksInFlight.emplace(key);
+		_l.unlock();
+		BlockData data = LoadBlock(key, fileSize);
+		_l.lock();
+		m_blocksInFlight.erase(key);
+		InsertBlock(key, data);
+		_l.unlock();
+		m_blockLoadedCondVar.notify_all();
+		return data;
+	}
+
+	void PrefetchThread()
+	{
+		SetThreadName("WUA-Prefetch");
+		std::unique_lock _l(m_mutex);
+		while (true)
+		{
+			m_prefetchCondVar.wait(_l, [&]() { return m_stopThread || !m_prefetchQueue.empty(); });
+			if (m_stopThread)
+				return;
+			PrefetchRequest request = m_prefetchQueue.front();
+			m_prefetchQueue.pop_front();
+			if (m_blocks.find(request.key) != m_blocks.end() || m_blocksInFlight.find(request.key) != m_blocksInFlight.end())
+				continue;
+			m_blocksInFlight.emplace(request.key);
+			_l.unlock();
+			BlockData data = LoadBlock(request.key, request.fileSize);
+			_l.lock();
+			m_blocksInFlight.erase(request.key);
+			InsertBlock(request.key, std::move(data));
+			m_blockLoadedCondVar.notify_all();
+		}
+	}
+
+	std::mutex m_mutex;
+	std::unordered_map<BlockKey, CachedBlock, BlockKeyHasher> m_blocks;
+	std::list<BlockKey> m_lruList; // most recently used first
+	std::unordered_set<BlockKey, BlockKeyHasher> m_blocksInFlight;
+	std::condition_variable m_blockLoadedCondVar;
+	// prefetching
+	std::deque<PrefetchRequest> m_prefetchQueue;
+	std::condition_variable m_prefetchCondVar;
+	std::thread m_prefetchThread;
+	bool m_stopThread{false};
+};
 
 class FSCDeviceWuaFileCtx : public FSCVirtualFile
 {
@@ -54,10 +270,15 @@ public:
 		if (m_fscType != FSC_TYPE_FILE)
 			return 0;
 		cemu_assert(size < (2ULL * 1024 * 1024 * 1024)); // single read operation larger than 2GiB not supported
-		uint32 bytesLeft = fscDeviceWuaFile_getFileSize() - m_seek;
+		uint32 fileSize = fscDeviceWuaFile_getFileSize();
+		uint32 bytesLeft = fileSize - m_seek;
 		uint32 bytesToRead = (std::min)(bytesLeft, (uint32)size);
-		uint32 bytesSuccessfullyRead = (uint32)m_archive->ReadFromFile(m_nodeHandle, m_seek, bytesToRead, buffer);
+		bool isSequential = m_seek == m_lastReadEnd;
+		uint32 bytesSuccessfullyRead = WuaBlockCache::instance().Read(m_archive, m_nodeHandle, fileSize, m_seek, bytesToRead, (uint8*)buffer);
 		m_seek += bytesSuccessfullyRead;
+		m_lastReadEnd = m_seek;
+		if (isSequential && m_seek < fileSize)
+			WuaBlockCache::instance().Prefetch(m_archive, m_nodeHandle, fileSize, m_seek, PREFETCH_BLOCK_COUNT);
 		return bytesSuccessfullyRead;
 	}
 
@@ -112,7 +333,9 @@ private:
 	sint32 m_fscType;
 	ZArchiveNodeHandle m_nodeHandle;
 	// file
+	static constexpr uint32 PREFETCH_BLOCK_COUNT = 4;
 	uint32 m_seek{0};
+	uint32 m_lastReadEnd{0}; // used to detect sequential reads
 	// directory
 	uint32 m_iteratorIndex{0};
 };
@@ -170,4 +393,9 @@ public:
 bool FSCDeviceWUA_Mount(std::string_view mountPath, std::string_view destinationBaseDir, ZArchiveReader* archive, sint32 priority)
 {
 	return fsc_mount(mountPath, destinationBaseDir, &fscDeviceWUAC::instance(), archive, priority) == FSC_STATUS_OK;
-}
\ No newline at end of file
+}
+
+void FSCDeviceWUA_PurgeCache(ZArchiveReader* archive)
+{
+	WuaBlockCache::instance().Purge(archive);
+}
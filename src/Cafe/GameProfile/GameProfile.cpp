@@ -8,6 +8,7 @@
 #include "util/IniParser/IniParser.h"
 #include "util/helpers/StringHelpers.h"
 #include "Cafe/CafeSystem.h"
+#include "Cafe/HW/Espresso/Recompiler/PPCRecompiler.h"
 
 std::unique_ptr<GameProfile> g_current_game_profile = std::make_unique<GameProfile>();
 
@@ -173,6 +174,7 @@ void gameProfile_load()
 
 	// apply some settings immediately
 	ppcThreadQuantum = g_current_game_profile->GetThreadQuantum();
+	ppcRecompilerSkipSpinLoops = g_current_game_profile->ShouldSkipSpinLoops();
 
 	if (ppcThreadQuantum != GameProfile::kThreadQuantumDefault)
 		cemuLog_log(LogType::Force, "Thread quantum set to {}", ppcThreadQuantum);
@@ -248,6 +250,7 @@ bool GameProfile::Load(uint64_t title_id)
 		else if (boost::iequals(iniParser.GetCurrentSectionName(), "CPU"))
 		{
 			gameProfile_loadIntegerOption(iniParser, "threadQuantum", m_threadQuantum, 1000U, 536870912U);
+			gameProfile_loadBooleanOption2(iniParser, "skipSpinLoops", m_skipSpinLoops);
 			if (!gameProfile_loadEnumOption(iniParser, "cpuMode", m_cpuMode))
 			{
 				// try to load the old enum value strings
@@ -303,6 +306,7 @@ void GameProfile::Save(uint64_t title_id)
 	fs->writeLine("[CPU]");
 	WRITE_OPTIONAL_ENTRY(cpuMode);
 	WRITE_ENTRY(threadQuantum);
+	WRITE_ENTRY(skipSpinLoops);
 
 	fs->writeLine("");
 
@@ -340,6 +344,7 @@ void GameProfile::ResetOptional()
 	// cpu settings
 	m_threadQuantum = kThreadQuantumDefault;
 	m_cpuMode.reset(); // CPUModeOption::kSingleCoreRecompiler;
+	m_skipSpinLoops = true;
 	// audio
 	m_disableAudio = false;
 	// controller settings
@@ -361,6 +366,7 @@ void GameProfile::Reset()
 	// cpu settings
 	m_threadQuantum = kThreadQuantumDefault;
 	m_cpuMode = CPUMode::Auto;
+	m_skipSpinLoops = true;
 	// audio
 	m_disableAudio = false;
 	// controller settings
@@ -35,6 +35,7 @@ public:
 
 	[[nodiscard]] uint32 GetThreadQuantum() const { return m_threadQuantum; }
 	[[nodiscard]] const std::optional<CPUMode>& GetCPUMode() const { return m_cpuMode; }
+	[[nodiscard]] bool ShouldSkipSpinLoops() const { return m_skipSpinLoops; }
 
 	[[nodiscard]] bool IsAudioDisabled() const { return m_disableAudio; }
 
@@ -58,6 +59,7 @@ private:
 	// cpu settings
 	uint32 m_threadQuantum = kThreadQuantumDefault; // values: 20000 45000 60000 80000 100000
 	std::optional<CPUMode> m_cpuMode{}; // = CPUModeOption::kSingleCoreRecompiler;
+	bool m_skipSpinLoops = true; // recompiled guest loops which only poll memory yield their timeslice
 	// audio
 	bool m_disableAudio = false;
 	// controller settings
@@ -17,17 +17,25 @@
 
 std::vector<GraphicPackPtr> GraphicPack2::s_graphic_packs;
 std::vector<GraphicPackPtr> GraphicPack2::s_active_graphic_packs;
+std::unordered_map<uint64, std::vector<GraphicPackPtr>> GraphicPack2::s_graphic_packs_by_title;
 std::atomic_bool GraphicPack2::s_isReady;
 
 #define GP_LEGACY_VERSION		(2)
 
 void GraphicPack2::LoadGraphicPack(fs::path graphicPackPath)
+{
+	GraphicPackPtr gp = ParseGraphicPack(graphicPackPath);
+	if (gp)
+		RegisterGraphicPack(gp);
+}
+
+GraphicPackPtr GraphicPack2::ParseGraphicPack(const fs::path& graphicPackPath)
 {
 	fs::path rulesPath = graphicPackPath;
 	rulesPath.append("rules.txt");
 	std::unique_ptr<FileStream> fs_rules(FileStream::openFile2(rulesPath));
 	if (!fs_rules)
-		return;
+		return nullptr;
 	std::vector<uint8> rulesData;
 	fs_rules->extract(rulesData);
 	IniParser iniParser(rulesData, _pathToUtf8(rulesPath));
@@ -35,12 +43,12 @@ void GraphicPack2::LoadGraphicPack(fs::path graphicPackPath)
 	if (!iniParser.NextSection())
 	{
 		cemuLog_log(LogType::Force, "{}: Does not contain any sections", _pathToUtf8(rulesPath));
-		return;
+		return nullptr;
 	}
 	if (!boost::iequals(iniParser.GetCurrentSectionName(), "Definition"))
 	{
 		cemuLog_log(LogType::Force, "{}: [Definition] must be the first section", _pathToUtf8(rulesPath));
-		return;
+		return nullptr;
 	}
 
 	auto option_version = iniParser.FindOption("version");
@@ -51,20 +59,20 @@ void GraphicPack2::LoadGraphicPack(fs::path graphicPackPath)
 		if (ec != std::errc{})
 		{
 			cemuLog_log(LogType::Force, "{}: Unable to parse version", _pathToUtf8(rulesPath));
-			return;
+			return nullptr;
 		}
 		if (versionNum > GP_LEGACY_VERSION)
-		{
-			GraphicPack2::LoadGraphicPack(rulesPath, iniParser);
-			return;
-		}
+			return CreateGraphicPack(rulesPath, iniParser);
 	}
 	cemuLog_log(LogType::Force, "{}: Outdated graphic pack", _pathToUtf8(rulesPath));
+	return nullptr;
 }
 
 void GraphicPack2::LoadAll()
 {
+	// collect pack directories first, the directory walk itself is cheap compared to parsing the rules
 	std::error_code ec;
+	std::vector<fs::path> gfxPackPaths;
 	fs::path basePath = ActiveSettings::GetUserDataPath("graphicPacks");
 	for (fs::recursive_directory_iterator it(basePath, ec); it != end(it); ++it)
 	{
@@ -73,14 +81,45 @@ void GraphicPack2::LoadAll()
 		fs::path gfxPackPath = it->path();
 		if (fs::exists(gfxPackPath / "rules.txt", ec))
 		{
-			LoadGraphicPack(gfxPackPath);
+			gfxPackPaths.emplace_back(gfxPackPath);
 			it.disable_recursion_pending(); // dont recurse deeper in a gfx pack directory
 			continue;
 		}
 	}
+	// parse rules.txt files in parallel
+	// results are stored by index and registered afterwards so the order of the pack list does not depend on thread timing
+	std::vector<GraphicPackPtr> parsedPacks(gfxPackPaths.size());
+	std::atomic_size_t nextIndex = 0;
+	auto parseWorker = [&]()
+	{
+		size_t index;
+		while ((index = nextIndex.fetch_add(1)) < gfxPackPaths.size())
+			parsedPacks[index] = ParseGraphicPack(gfxPackPaths[index]);
+	};
+	const size_t numThreads = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), (gfxPackPaths.size() + 15) / 16);
+	std::vector<std::thread> workers;
+	for (size_t i = 1; i < numThreads; i++)
+		workers.emplace_back(parseWorker);
+	parseWorker();
+	for (auto& worker : workers)
+		worker.join();
+	for (auto& gp : parsedPacks)
+	{
+		if (gp)
+			RegisterGraphicPack(gp);
+	}
 }
 
 bool GraphicPack2::LoadGraphicPack(const fs::path& rulesPath, IniParser& rules)
+{
+	GraphicPackPtr gp = CreateGraphicPack(rulesPath, rules);
+	if (!gp)
+		return false;
+	RegisterGraphicPack(gp);
+	return true;
+}
+
+GraphicPackPtr GraphicPack2::CreateGraphicPack(const fs::path& rulesPath, IniParser& rules)
 {
 	try
 	{
@@ -117,16 +156,34 @@ bool GraphicPack2::LoadGraphicPack(const fs::path& rulesPath, IniParser& rules)
 
 		gp->UpdatePresetVisibility();
 		gp->ValidatePresetSelections();
-
-		s_graphic_packs.emplace_back(gp);
-		return true;
+		return gp;
 	}
 	catch (const std::exception&)
 	{
-		return false;
+		return nullptr;
 	}
 }
 
+void GraphicPack2::RegisterGraphicPack(const GraphicPackPtr& gp)
+{
+	s_graphic_packs.emplace_back(gp);
+	for (uint64 titleId : gp->GetTitleIds())
+	{
+		auto& titlePacks = s_graphic_packs_by_title[titleId];
+		if (titlePacks.empty() || titlePacks.back() != gp) // ignore duplicate title ids
+			titlePacks.emplace_back(gp);
+	}
+}
+
+const std::vector<GraphicPackPtr>& GraphicPack2::GetGraphicPacksForTitle(uint64 titleId)
+{
+	static const std::vector<GraphicPackPtr> s_empty;
+	const auto it = s_graphic_packs_by_title.find(titleId);
+	if (it == s_graphic_packs_by_title.cend())
+		return s_empty;
+	return it->second;
+}
+
 bool GraphicPack2::ActivateGraphicPack(const std::shared_ptr<GraphicPack2>& graphic_pack)
 {
 	if (graphic_pack->Activate())
@@ -164,14 +221,11 @@ void GraphicPack2::ActivateForCurrentTitle()
 {
 	uint64 titleId = CafeSystem::GetForegroundTitleId();
 	// activate graphic packs
-	for (const auto& gp : GraphicPack2::GetGraphicPacks())
+	for (const auto& gp : GraphicPack2::GetGraphicPacksForTitle(titleId))
 	{
 		if (!gp->IsEnabled())
 			continue;
 
-		if (!gp->ContainsTitleId(titleId))
-			continue;
-
 		if (GraphicPack2::ActivateGraphicPack(gp))
 		{
 			if (gp->GetPresets().empty())
@@ -210,6 +264,7 @@ void GraphicPack2::Reset()
 void GraphicPack2::ClearGraphicPacks()
 {
 	s_graphic_packs.clear();
+	s_graphic_packs_by_title.clear();
 	s_active_graphic_packs.clear();
 }
 
@@ -753,7 +808,9 @@ bool GraphicPack2::IsPresetVisible(const PresetPtr& preset) const
 	{
 		TExpressionParser<int> p;
 		FillPresetConstants(p);
-		return p.Evaluate(preset->condition) != 0;
+		if (!preset->compiledCondition)
+			preset->compiledCondition = p.Compile(preset->condition);
+		return p.Evaluate(*preset->compiledCondition) != 0;
 	}
 	catch (const std::exception& ex)
 	{
@@ -1257,12 +1314,10 @@ std::vector<std::pair<MPTR, MPTR>> GraphicPack2::GetActiveRAMMappings()
 {
 	uint64 currentTitleId = CafeSystem::GetForegroundTitleId();
 	std::vector<std::pair<MPTR, MPTR>> v;
-	for (const auto& gp : GraphicPack2::GetGraphicPacks())
+	for (const auto& gp : GraphicPack2::GetGraphicPacksForTitle(currentTitleId))
 	{
 		if (!gp->IsEnabled())
 			continue;
-		if (!gp->ContainsTitleId(currentTitleId))
-			continue;
 		if (!gp->m_ramMappings.empty())
 			v.insert(v.end(), gp->m_ramMappings.begin(), gp->m_ramMappings.end());
 	}
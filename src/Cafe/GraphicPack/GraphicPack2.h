@@ -81,6 +81,7 @@ public:
 		std::string category; // preset category (empty for default)
 		std::string name; // displayed name
 		std::string condition;
+		std::optional<TExpressionParser<int>::CompiledExpression> compiledCondition; // compiled on first visibility check
 		std::unordered_map<std::string, PresetVar> variables;
 		bool active = false; // selected/active preset
 		bool visible = true; // set by condition or true
@@ -164,6 +165,7 @@ public:
 
 	static const std::vector<std::shared_ptr<GraphicPack2>>& GetGraphicPacks() { return s_graphic_packs; }
 	static const std::vector<std::shared_ptr<GraphicPack2>>& GetActiveGraphicPacks() { return s_active_graphic_packs; }
+	static const std::vector<std::shared_ptr<GraphicPack2>>& GetGraphicPacksForTitle(uint64 titleId);
 	static void LoadGraphicPack(fs::path graphicPackPath);
 	static bool LoadGraphicPack(const fs::path& rulesPath, class IniParser& rules);
 	static bool ActivateGraphicPack(const std::shared_ptr<GraphicPack2>& graphic_pack);
@@ -178,8 +180,14 @@ private:
 	bool Activate();
 	bool Deactivate();
 
+	// parsing is thread-safe, registering is not
+	static std::shared_ptr<GraphicPack2> ParseGraphicPack(const fs::path& graphicPackPath);
+	static std::shared_ptr<GraphicPack2> CreateGraphicPack(const fs::path& rulesPath, class IniParser& rules);
+	static void RegisterGraphicPack(const std::shared_ptr<GraphicPack2>& gp);
+
 	static std::vector<std::shared_ptr<GraphicPack2>> s_graphic_packs;
 	static std::vector<std::shared_ptr<GraphicPack2>> s_active_graphic_packs;
+	static std::unordered_map<uint64, std::vector<std::shared_ptr<GraphicPack2>>> s_graphic_packs_by_title;
 	static std::atomic_bool s_isReady;
 
 	template<typename TType>
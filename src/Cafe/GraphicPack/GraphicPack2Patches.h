@@ -3,6 +3,7 @@
 class PatchGroup;
 
 #include "GraphicPackError.h"
+#include "Cemu/ExpressionParser/ExpressionParser.h"
 
 struct PatchContext_t
 {
@@ -27,6 +28,8 @@ struct PatchContext_t
 	//MEMPTR<void> codeCaveEnd;
 	const RPLModule* matchedModule;
 	std::unordered_map<std::string, uint32> map_values;
+	// expressions are compiled once and then re-evaluated in every resolver pass
+	std::unordered_map<std::string, ExpressionParser::CompiledExpression> compiledExpressions;
 	// error information
 	//std::unordered_set<std::string> unresolvedSymbols;
 	std::set<UnresolvedSymbol> unresolvedSymbols;
@@ -245,8 +245,11 @@ EXPRESSION_RESOLVE_RESULT _resolveExpression(PatchContext_t& ctx, std::string& e
 		// add all the graphic pack constants
 		ep.AddConstantCallback(_cbResolveConstant);
 		ep.SetFunctionCallback(_cbResolveFunction);
+		auto it = ctx.compiledExpressions.find(expressionString);
+		if (it == ctx.compiledExpressions.end())
+			it = ctx.compiledExpressions.emplace(expressionString, ep.Compile(expressionString)).first;
 		resolverState.hasUnknownVariable = false;
-		result = (T)ep.Evaluate(expressionString);
+		result = (T)ep.Evaluate(it->second);
 		if (resolverState.hasUnknownVariable)
 			return EXPRESSION_RESOLVE_RESULT::UNKNOWN_VARIABLE;
 	}
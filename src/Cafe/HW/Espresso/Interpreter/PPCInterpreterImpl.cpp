@@ -2,6 +2,8 @@
 #include "PPCInterpreterHelper.h"
 #include "Cafe/HW/Espresso/Debugger/Debugger.h"
 #include "Cafe/HW/Espresso/Debugger/GDBStub.h"
+#include "util/helpers/fspinlock.h"
+#include "util/highresolutiontimer/HighResolutionTimer.h"
 
 class PPCItpCafeOSUsermode
 {
@@ -437,36 +439,42 @@ public:
 #include "PPCInterpreterLoadStore.hpp"
 #include "PPCInterpreterALU.hpp"
 
-	static void executeInstruction(PPCInterpreter_t* hCPU)
-	{
-		if constexpr(ppcItpCtrl::allowSupervisorMode)
-		{
-			hCPU->global->tb++;
-		}
+	typedef void(*InstructionHandler)(PPCInterpreter_t* hCPU, uint32 opcode);
 
-#ifdef __DEBUG_OUTPUT_INSTRUCTION
-		debug_printf("%08x: ", hCPU->instructionPointer);
+	static void PPCInterpreter_ZERO(PPCInterpreter_t* hCPU, uint32 opcode)
+	{
+		debug_printf("ZERO[NOP] | 0x%08X\n", (unsigned int)hCPU->instructionPointer);
+#ifdef CEMU_DEBUG_ASSERT
+		assert_dbg();
+		while (true) std::this_thread::sleep_for(std::chrono::seconds(1));
 #endif
+		hCPU->instructionPointer += 4;
+	}
 
-		uint32 opcode = ppcItpCtrl::memory_readCodeU32(hCPU, hCPU->instructionPointer);
+	static void PPCInterpreter_TWI(PPCInterpreter_t* hCPU, uint32 opcode)
+	{
+		cemuLog_logDebug(LogType::Force, "Unsupported TWI instruction executed at {:08x}", hCPU->instructionPointer);
+		PPCInterpreter_nextInstruction(hCPU);
+	}
 
+	static void PPCInterpreter_unknownInstruction(PPCInterpreter_t* hCPU, uint32 opcode)
+	{
+		cemuLog_logDebug(LogType::Force, "Unknown instruction {:08x} at {:08x}", opcode, hCPU->instructionPointer);
+		cemu_assert_unimplemented();
+		hCPU->instructionPointer += 4;
+	}
+
+	// maps an opcode to the handler which implements it. Operands are extracted by the handler
+	static InstructionHandler decodeInstruction(uint32 opcode)
+	{
 		switch ((opcode >> 26))
 		{
 		case 0:
-			debug_printf("ZERO[NOP] | 0x%08X\n", (unsigned int)hCPU->instructionPointer);
-	#ifdef CEMU_DEBUG_ASSERT		
-			assert_dbg();
-			while (true) std::this_thread::sleep_for(std::chrono::seconds(1));
-	#endif
-			hCPU->instructionPointer += 4;
-			break;
+			return PPCInterpreter_ZERO;
 		case 1: // virtual HLE
-			PPCInterpreter_virtualHLE(hCPU, opcode);
-			break;
+			return PPCInterpreter_virtualHLE;
 		case 3:
-			cemuLog_logDebug(LogType::Force, "Unsupported TWI instruction executed at {:08x}", hCPU->instructionPointer);
-			PPCInterpreter_nextInstruction(hCPU);
-			break;
+			return PPCInterpreter_TWI;
 		case 4:
 			switch (PPC_getBits(opcode, 30, 5))
 			{
@@ -474,775 +482,524 @@ public:
 				switch (PPC_getBits(opcode, 25, 5))
 				{
 				case 0: // Sonic All Stars Racing
-					PPCInterpreter_PS_CMPU0(hCPU, opcode);
-					break;
+					return PPCInterpreter_PS_CMPU0;
 				case 1:
-					PPCInterpreter_PS_CMPO0(hCPU, opcode);
-					break;
+					return PPCInterpreter_PS_CMPO0;
 				case 2: // Assassin's Creed 3, Sonic All Stars Racing
-					PPCInterpreter_PS_CMPU1(hCPU, opcode);
-					break;
+					return PPCInterpreter_PS_CMPU1;
 				default:
-					cemuLog_logDebug(LogType::Force, "Unknown execute {:04x} as [4->0] at {:08x}", PPC_getBits(opcode, 25, 5), hCPU->instructionPointer);
-					cemu_assert_unimplemented();
-					hCPU->instructionPointer += 4;
-					break;
+					return PPCInterpreter_unknownInstruction;
 				}
-				break;
 			case 6:
-				PPCInterpreter_PSQ_LX(hCPU, opcode);
-				break;
+				return PPCInterpreter_PSQ_LX;
 			case 7:
-				PPCInterpreter_PSQ_STX(hCPU, opcode);
-				break;
+				return PPCInterpreter_PSQ_STX;
 			case 8:
 				switch (PPC_getBits(opcode, 25, 5))
 				{
 				case 1:
-					PPCInterpreter_PS_NEG(hCPU, opcode);
-					break;
+					return PPCInterpreter_PS_NEG;
 				case 2:
-					PPCInterpreter_PS_MR(hCPU, opcode);
-					break;
+					return PPCInterpreter_PS_MR;
 				case 4:
-					PPCInterpreter_PS_NABS(hCPU, opcode);
-					break;
+					return PPCInterpreter_PS_NABS;
 				case 8:
-					PPCInterpreter_PS_ABS(hCPU, opcode);
-					break;
+					return PPCInterpreter_PS_ABS;
 				default:
-					cemuLog_logDebug(LogType::Force, "Unknown execute {:04x} as [4->8] at {:08x}", PPC_getBits(opcode, 25, 5), hCPU->instructionPointer);
-					cemu_assert_unimplemented();
-					hCPU->instructionPointer += 4;
-					break;
+					return PPCInterpreter_unknownInstruction;
 				}
-				break;
 			case 10:
-				PPCInterpreter_PS_SUM0(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_SUM0;
 			case 11:
-				PPCInterpreter_PS_SUM1(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_SUM1;
 			case 12:
-				PPCInterpreter_PS_MULS0(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_MULS0;
 			case 13:
-				PPCInterpreter_PS_MULS1(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_MULS1;
 			case 14:
-				PPCInterpreter_PS_MADDS0(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_MADDS0;
 			case 15:
-				PPCInterpreter_PS_MADDS1(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_MADDS1;
 			case 16: // sub category - merge
 				switch (PPC_getBits(opcode, 25, 5))
 				{
 				case 16:
-					PPCInterpreter_PS_MERGE00(hCPU, opcode);
-					break;
+					return PPCInterpreter_PS_MERGE00;
 				case 17:
-					PPCInterpreter_PS_MERGE01(hCPU, opcode);
-					break;
+					return PPCInterpreter_PS_MERGE01;
 				case 18:
-					PPCInterpreter_PS_MERGE10(hCPU, opcode);
-					break;
+					return PPCInterpreter_PS_MERGE10;
 				case 19:
-					PPCInterpreter_PS_MERGE11(hCPU, opcode);
-					break;
+					return PPCInterpreter_PS_MERGE11;
 				default:
-					cemuLog_logDebug(LogType::Force, "Unknown execute {:04x} as [4->16] at {:08x}", PPC_getBits(opcode, 25, 5), hCPU->instructionPointer);
-					cemu_assert_unimplemented();
-					hCPU->instructionPointer += 4;
-					break;
+					return PPCInterpreter_unknownInstruction;
 				}
-				break;
 			case 18:
-				PPCInterpreter_PS_DIV(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_DIV;
 			case 20:
-				PPCInterpreter_PS_SUB(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_SUB;
 			case 21:
-				PPCInterpreter_PS_ADD(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_ADD;
 			case 22:
-				PPCInterpreter_DCBZL(hCPU, opcode);
-				break;
+				return PPCInterpreter_DCBZL;
 			case 23:
-				PPCInterpreter_PS_SEL(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_SEL;
 			case 24:
-				PPCInterpreter_PS_RES(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_RES;
 			case 25:
-				PPCInterpreter_PS_MUL(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_MUL;
 			case 26: // sub category with only one entry - RSQRTE
-				PPCInterpreter_PS_RSQRTE(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_RSQRTE;
 			case 28:
-				PPCInterpreter_PS_MSUB(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_MSUB;
 			case 29:
-				PPCInterpreter_PS_MADD(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_MADD;
 			case 30:
-				PPCInterpreter_PS_NMSUB(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_NMSUB;
 			case 31:
-				PPCInterpreter_PS_NMADD(hCPU, opcode);
-				break;
+				return PPCInterpreter_PS_NMADD;
 			default:
-				cemuLog_logDebug(LogType::Force, "Unknown execute {:04x} as [4] at {:08x}", PPC_getBits(opcode, 30, 5), hCPU->instructionPointer);
-				cemu_assert_unimplemented();
-				hCPU->instructionPointer += 4;
-				break;
+				return PPCInterpreter_unknownInstruction;
 			}
-			break;
 		case 7:
-			PPCInterpreter_MULLI(hCPU, opcode);
-			break;
+			return PPCInterpreter_MULLI;
 		case 8:
-			PPCInterpreter_SUBFIC(hCPU, opcode);
-			break;
+			return PPCInterpreter_SUBFIC;
 		case 10:
-			PPCInterpreter_CMPLI(hCPU, opcode);
-			break;
+			return PPCInterpreter_CMPLI;
 		case 11:
-			PPCInterpreter_CMPI(hCPU, opcode);
-			break;
+			return PPCInterpreter_CMPI;
 		case 12:
-			PPCInterpreter_ADDIC(hCPU, opcode);
-			break;
+			return PPCInterpreter_ADDIC;
 		case 13:
-			PPCInterpreter_ADDIC_(hCPU, opcode);
-			break;
+			return PPCInterpreter_ADDIC_;
 		case 14:
-			PPCInterpreter_ADDI(hCPU, opcode);
-			break;
+			return PPCInterpreter_ADDI;
 		case 15:
-			PPCInterpreter_ADDIS(hCPU, opcode);
-			break;
+			return PPCInterpreter_ADDIS;
 		case 16:
-			PPCInterpreter_BCX(hCPU, opcode);
-			break;
+			return PPCInterpreter_BCX;
 		case 17:
 			if (PPC_getBits(opcode, 30, 1) == 1)
-			{
-				PPCInterpreter_SC(hCPU, opcode);
-			}
-			else
-			{
-				cemuLog_logDebug(LogType::Force, "Unsupported Opcode [0x17 --> 0x0]");
-				cemu_assert_unimplemented();
-				hCPU->instructionPointer += 4;
-			}
-			break;
+				return PPCInterpreter_SC;
+			return PPCInterpreter_unknownInstruction;
 		case 18:
-			PPCInterpreter_BX(hCPU, opcode);
-			break;
+			return PPCInterpreter_BX;
 		case 19: // opcode category
 			switch (PPC_getBits(opcode, 30, 10))
 			{
 			case 0:
-				PPCInterpreter_MCRF(hCPU, opcode);
-				break;
+				return PPCInterpreter_MCRF;
 			case 16:
-				PPCInterpreter_BCLRX(hCPU, opcode);
-				break;
+				return PPCInterpreter_BCLRX;
 			case 33:
-				PPCInterpreter_CRNOR(hCPU, opcode);
-				break;
+				return PPCInterpreter_CRNOR;
 			case 50:
-				PPCInterpreter_RFI(hCPU, opcode);
-				break;
+				return PPCInterpreter_RFI;
 			case 129:
-				PPCInterpreter_CRANDC(hCPU, opcode);
-				break;
+				return PPCInterpreter_CRANDC;
 			case 150:
-				PPCInterpreter_ISYNC(hCPU, opcode);
-				break;
+				return PPCInterpreter_ISYNC;
 			case 193:
-				PPCInterpreter_CRXOR(hCPU, opcode);
-				break;
+				return PPCInterpreter_CRXOR;
 			case 225:
-				PPCInterpreter_CRNAND(hCPU, opcode);
-				break;
+				return PPCInterpreter_CRNAND;
 			case 257:
-				PPCInterpreter_CRAND(hCPU, opcode);
-				break;
+				return PPCInterpreter_CRAND;
 			case 289:
-				PPCInterpreter_CREQV(hCPU, opcode);
-				break;
+				return PPCInterpreter_CREQV;
 			case 417:
-				PPCInterpreter_CRORC(hCPU, opcode);
-				break;
+				return PPCInterpreter_CRORC;
 			case 449:
-				PPCInterpreter_CROR(hCPU, opcode);
-				break;
+				return PPCInterpreter_CROR;
 			case 528:
-				PPCInterpreter_BCCTR(hCPU, opcode);
-				break;
+				return PPCInterpreter_BCCTR;
 			default:
-				cemuLog_logDebug(LogType::Force, "Unknown execute {:04x} as [19] at {:08x}\n", PPC_getBits(opcode, 30, 10), hCPU->instructionPointer);
-				cemu_assert_unimplemented();
-				hCPU->instructionPointer += 4;
-				break;
+				return PPCInterpreter_unknownInstruction;
 			}
-			break;
 		case 20:
-			PPCInterpreter_RLWIMI(hCPU, opcode);
-			break;
+			return PPCInterpreter_RLWIMI;
 		case 21:
-			PPCInterpreter_RLWINM(hCPU, opcode);
-			break;
+			return PPCInterpreter_RLWINM;
 		case 23:
-			PPCInterpreter_RLWNM(hCPU, opcode);
-			break;
+			return PPCInterpreter_RLWNM;
 		case 24:
-			PPCInterpreter_ORI(hCPU, opcode);
-			break;
+			return PPCInterpreter_ORI;
 		case 25:
-			PPCInterpreter_ORIS(hCPU, opcode);
-			break;
+			return PPCInterpreter_ORIS;
 		case 26:
-			PPCInterpreter_XORI(hCPU, opcode);
-			break;
+			return PPCInterpreter_XORI;
 		case 27:
-			PPCInterpreter_XORIS(hCPU, opcode);
-			break;
+			return PPCInterpreter_XORIS;
 		case 28:
-			PPCInterpreter_ANDI_(hCPU, opcode);
-			break;
+			return PPCInterpreter_ANDI_;
 		case 29:
-			PPCInterpreter_ANDIS_(hCPU, opcode);
-			break;
+			return PPCInterpreter_ANDIS_;
 		case 31: // opcode category
 			switch (PPC_getBits(opcode, 30, 10))
 			{
 			case 0:
-				PPCInterpreter_CMP(hCPU, opcode);
-				break;
+				return PPCInterpreter_CMP;
 			case 4:
-				PPCInterpreter_TW(hCPU, opcode);
-				break;
+				return PPCInterpreter_TW;
 			case 8:
-				PPCInterpreter_SUBFC(hCPU, opcode);
-				break;
+				return PPCInterpreter_SUBFC;
 			case 10:
-				PPCInterpreter_ADDC(hCPU, opcode);
-				break;
+				return PPCInterpreter_ADDC;
 			case 11:
-				PPCInterpreter_MULHWU_(hCPU, opcode);
-				break;
+				return PPCInterpreter_MULHWU_;
 			case 19:
-				PPCInterpreter_MFCR(hCPU, opcode);
-				break;
+				return PPCInterpreter_MFCR;
 			case 20:
-				PPCInterpreter_LWARX(hCPU, opcode);
-				break;
+				return PPCInterpreter_LWARX;
 			case 23:
-				PPCInterpreter_LWZX(hCPU, opcode);
-				break;
+				return PPCInterpreter_LWZX;
 			case 24:
-				PPCInterpreter_SLWX(hCPU, opcode);
-				break;
+				return PPCInterpreter_SLWX;
 			case 26:
-				PPCInterpreter_CNTLZW(hCPU, opcode);
-				break;
+				return PPCInterpreter_CNTLZW;
 			case 28:
-				PPCInterpreter_ANDX(hCPU, opcode);
-				break;
+				return PPCInterpreter_ANDX;
 			case 32:
-				PPCInterpreter_CMPL(hCPU, opcode);
-				break;
+				return PPCInterpreter_CMPL;
 			case 40:
-				PPCInterpreter_SUBF(hCPU, opcode);
-				break;
+				return PPCInterpreter_SUBF;
 			case 54:
-				PPCInterpreter_DCBST(hCPU, opcode);
-				break;
+				return PPCInterpreter_DCBST;
 			case 55:
-				PPCInterpreter_LWZXU(hCPU, opcode);
-				break;
+				return PPCInterpreter_LWZXU;
 			case 60:
-				PPCInterpreter_ANDCX(hCPU, opcode);
-				break;
+				return PPCInterpreter_ANDCX;
 			case 75:
-				PPCInterpreter_MULHW_(hCPU, opcode);
-				break;
+				return PPCInterpreter_MULHW_;
 			case 83:
-				PPCInterpreter_MFMSR(hCPU, opcode);
-				break;
+				return PPCInterpreter_MFMSR;
 			case 86:
-				PPCInterpreter_DCBF(hCPU, opcode);
-				break;
+				return PPCInterpreter_DCBF;
 			case 87:
-				PPCInterpreter_LBZX(hCPU, opcode);
-				break;
+				return PPCInterpreter_LBZX;
 			case 104:
-				PPCInterpreter_NEG(hCPU, opcode);
-				break;
+				return PPCInterpreter_NEG;
 			case 119: // Sonic Lost World
-				PPCInterpreter_LBZXU(hCPU, opcode);
-				break;
+				return PPCInterpreter_LBZXU;
 			case 124:
-				PPCInterpreter_NORX(hCPU, opcode);
-				break;
+				return PPCInterpreter_NORX;
 			case 136:
-				PPCInterpreter_SUBFE(hCPU, opcode);
-				break;
+				return PPCInterpreter_SUBFE;
 			case 138:
-				PPCInterpreter_ADDE(hCPU, opcode);
-				break;
+				return PPCInterpreter_ADDE;
 			case 144:
-				PPCInterpreter_MTCRF(hCPU, opcode);
-				break;
+				return PPCInterpreter_MTCRF;
 			case 146:
-				PPCInterpreter_MTMSR(hCPU, opcode);
-				break;
+				return PPCInterpreter_MTMSR;
 			case 150:
-				PPCInterpreter_STWCX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STWCX;
 			case 151:
-				PPCInterpreter_STWX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STWX;
 			case 183:
-				PPCInterpreter_STWUX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STWUX;
 			case 200:
-				PPCInterpreter_SUBFZE(hCPU, opcode);
-				break;
+				return PPCInterpreter_SUBFZE;
 			case 202:
-				PPCInterpreter_ADDZE(hCPU, opcode);
-				break;
+				return PPCInterpreter_ADDZE;
 			case 210:
-				PPCInterpreter_MTSR(hCPU, opcode);
-				break;
+				return PPCInterpreter_MTSR;
 			case 215:
-				PPCInterpreter_STBX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STBX;
 			case 232: // Trine 2
-				PPCInterpreter_SUBFME(hCPU, opcode);
-				break;
+				return PPCInterpreter_SUBFME;
 			case 234:
-				PPCInterpreter_ADDME(hCPU, opcode);
-				break;
+				return PPCInterpreter_ADDME;
 			case 235:
-				PPCInterpreter_MULLW(hCPU, opcode);
-				break;
+				return PPCInterpreter_MULLW;
 			case 247:
-				PPCInterpreter_STBUX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STBUX;
 			case 266:
-				PPCInterpreter_ADD(hCPU, opcode);
-				break;
+				return PPCInterpreter_ADD;
 			case 278:
-				PPCInterpreter_DCBT(hCPU, opcode);
-				break;
+				return PPCInterpreter_DCBT;
 			case 279:
-				PPCInterpreter_LHZX(hCPU, opcode);
-				break;
+				return PPCInterpreter_LHZX;
 			case 284:
-				PPCInterpreter_EQV(hCPU, opcode);
-				break;
+				return PPCInterpreter_EQV;
 			case 306:
-				PPCInterpreter_TLBIE(hCPU, opcode);
-				break;
+				return PPCInterpreter_TLBIE;
 			case 311: // Wii U Menu v177 (US)
-				PPCInterpreter_LHZUX(hCPU, opcode);
-				break;
+				return PPCInterpreter_LHZUX;
 			case 316:
-				PPCInterpreter_XOR(hCPU, opcode);
-				break;
+				return PPCInterpreter_XOR;
 			case 339:
-				PPCInterpreter_MFSPR(hCPU, opcode);
-				break;
+				return PPCInterpreter_MFSPR;
 			case 343:
-				PPCInterpreter_LHAX(hCPU, opcode);
-				break;
+				return PPCInterpreter_LHAX;
 			case 371:
-				PPCInterpreter_MFTB(hCPU, opcode);
-				break;
+				return PPCInterpreter_MFTB;
 			case 375: // Wii U Menu v177 (US)
-				PPCInterpreter_LHAUX(hCPU, opcode);
-				break;
+				return PPCInterpreter_LHAUX;
 			case 407:
-				PPCInterpreter_STHX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STHX;
 			case 412:
-				PPCInterpreter_ORC(hCPU, opcode);
-				break;
+				return PPCInterpreter_ORC;
 			case 439:
-				PPCInterpreter_STHUX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STHUX;
 			case 444:
-				PPCInterpreter_OR(hCPU, opcode);
-				break;
+				return PPCInterpreter_OR;
 			case 459:
-				PPCInterpreter_DIVWU(hCPU, opcode);
-				break;
+				return PPCInterpreter_DIVWU;
 			case 467:
-				PPCInterpreter_MTSPR(hCPU, opcode);
-				break;
+				return PPCInterpreter_MTSPR;
 			case 470:
-				PPCInterpreter_DCBI(hCPU, opcode);
-				break;
+				return PPCInterpreter_DCBI;
 			case 476:
-				PPCInterpreter_NANDX(hCPU, opcode);
-				break;
+				return PPCInterpreter_NANDX;
 			case 491:
-				PPCInterpreter_DIVW(hCPU, opcode);
-				break;
+				return PPCInterpreter_DIVW;
 			case 512:
-				PPCInterpreter_MCRXR(hCPU, opcode);
-				break;
+				return PPCInterpreter_MCRXR;
 			case 520: // Affordable Space Adventures + other Unity games
-				PPCInterpreter_SUBFCO(hCPU, opcode);
-				break;
+				return PPCInterpreter_SUBFCO;
 			case 522:
-				PPCInterpreter_ADDCO(hCPU, opcode);
-				break;
+				return PPCInterpreter_ADDCO;
 			case 523: // 11 | OE
-				PPCInterpreter_MULHWU_(hCPU, opcode); // OE is ignored
-				break;
+				return PPCInterpreter_MULHWU_; // OE is ignored
 			case 533:
-				PPCInterpreter_LSWX(hCPU, opcode);
-				break;
+				return PPCInterpreter_LSWX;
 			case 534:
-				PPCInterpreter_LWBRX(hCPU, opcode);
-				break;
+				return PPCInterpreter_LWBRX;
 			case 535:
-				PPCInterpreter_LFSX(hCPU, opcode);
-				break;
+				return PPCInterpreter_LFSX;
 			case 536:
-				PPCInterpreter_SRWX(hCPU, opcode);
-				break;
+				return PPCInterpreter_SRWX;
 			case 552:
-				PPCInterpreter_SUBFO(hCPU, opcode);
-				break;
+				return PPCInterpreter_SUBFO;
 			case 566:
-				PPCInterpreter_TLBSYNC(hCPU, opcode);
-				break;
+				return PPCInterpreter_TLBSYNC;
 			case 567:
-				PPCInterpreter_LFSUX(hCPU, opcode);
-				break;
+				return PPCInterpreter_LFSUX;
 			case 587: // 75 | OE
-				PPCInterpreter_MULHW_(hCPU, opcode); // OE is ignored for MULHW
-				break;
+				return PPCInterpreter_MULHW_; // OE is ignored for MULHW
 			case 595:
-				PPCInterpreter_MFSR(hCPU, opcode);
-				break;
+				return PPCInterpreter_MFSR;
 			case 597:
-				PPCInterpreter_LSWI(hCPU, opcode);
-				break;
+				return PPCInterpreter_LSWI;
 			case 598:
-				PPCInterpreter_SYNC(hCPU, opcode);
-				break;
+				return PPCInterpreter_SYNC;
 			case 599:
-				PPCInterpreter_LFDX(hCPU, opcode);
-				break;
+				return PPCInterpreter_LFDX;
 			case 616:
-				PPCInterpreter_NEGO(hCPU, opcode);
-				break;
+				return PPCInterpreter_NEGO;
 			case 631:
-				PPCInterpreter_LFDUX(hCPU, opcode);
-				break;
+				return PPCInterpreter_LFDUX;
 			case 648: // 136 | OE
-				PPCInterpreter_SUBFEO(hCPU, opcode);
-				break;
+				return PPCInterpreter_SUBFEO;
 			case 650: // 138 | OE
-				PPCInterpreter_ADDEO(hCPU, opcode);
-				break;
+				return PPCInterpreter_ADDEO;
 			case 662:
-				PPCInterpreter_STWBRX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STWBRX;
 			case 663:
-				PPCInterpreter_STFSX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STFSX;
 			case 661:
-				PPCInterpreter_STSWX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STSWX;
 			case 695:
-				PPCInterpreter_STFSUX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STFSUX;
 			case 712: // 200 | OE
-				PPCInterpreter_SUBFZEO(hCPU, opcode);
-				break;
+				return PPCInterpreter_SUBFZEO;
 			case 714: // 202 | OE
-				PPCInterpreter_ADDZEO(hCPU, opcode);
-				break;
+				return PPCInterpreter_ADDZEO;
 			case 725:
-				PPCInterpreter_STSWI(hCPU, opcode);
-				break;
+				return PPCInterpreter_STSWI;
 			case 727:
-				PPCInterpreter_STFDX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STFDX;
 			case 744: // 232 | OE
-				PPCInterpreter_SUBFMEO(hCPU, opcode);
-				break;
+				return PPCInterpreter_SUBFMEO;
 			case 746: // 234 | OE
-				PPCInterpreter_ADDMEO(hCPU, opcode);
-				break;
+				return PPCInterpreter_ADDMEO;
 			case 747:
-				PPCInterpreter_MULLWO(hCPU, opcode);
-				break;
+				return PPCInterpreter_MULLWO;
 			case 759:
-				PPCInterpreter_STFDUX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STFDUX;
 			case 778:
-				PPCInterpreter_ADDO(hCPU, opcode);
-				break;
+				return PPCInterpreter_ADDO;
 			case 790:
-				PPCInterpreter_LHBRX(hCPU, opcode);
-				break;
+				return PPCInterpreter_LHBRX;
 			case 792:
-				PPCInterpreter_SRAW(hCPU, opcode);
-				break;
+				return PPCInterpreter_SRAW;
 			case 824:
-				PPCInterpreter_SRAWI(hCPU, opcode);
-				break;
+				return PPCInterpreter_SRAWI;
 			case 854:
-				PPCInterpreter_EIEIO(hCPU, opcode);
-				break;
+				return PPCInterpreter_EIEIO;
 			case 918:
-				PPCInterpreter_STHBRX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STHBRX;
 			case 922:
-				PPCInterpreter_EXTSH(hCPU, opcode);
-				break;
+				return PPCInterpreter_EXTSH;
 			case 954:
-				PPCInterpreter_EXTSB(hCPU, opcode);
-				break;
+				return PPCInterpreter_EXTSB;
 			case 971:
-				PPCInterpreter_DIVWUO(hCPU, opcode);
-				break;
+				return PPCInterpreter_DIVWUO;
 			case 982:
-				PPCInterpreter_ICBI(hCPU, opcode);
-				break;
+				return PPCInterpreter_ICBI;
 			case 983:
-				PPCInterpreter_STFIWX(hCPU, opcode);
-				break;
+				return PPCInterpreter_STFIWX;
 			case 1003:
-				PPCInterpreter_DIVWO(hCPU, opcode);
-				break;
+				return PPCInterpreter_DIVWO;
 			case 1014:
-				PPCInterpreter_DCBZ(hCPU, opcode);
-				break;
+				return PPCInterpreter_DCBZ;
 			default:
-				cemuLog_logDebug(LogType::Force, "Unknown execute {:04x} as [31] at {:08x}\n", PPC_getBits(opcode, 30, 10), hCPU->instructionPointer);
-				cemu_assert_unimplemented();
-				hCPU->instructionPointer += 4;
-				break;
+				return PPCInterpreter_unknownInstruction;
 			}
-			break;
 		case 32:
-			PPCInterpreter_LWZ(hCPU, opcode);
-			break;
+			return PPCInterpreter_LWZ;
 		case 33:
-			PPCInterpreter_LWZU(hCPU, opcode);
-			break;
+			return PPCInterpreter_LWZU;
 		case 34:
-			PPCInterpreter_LBZ(hCPU, opcode);
-			break;
+			return PPCInterpreter_LBZ;
 		case 35:
-			PPCInterpreter_LBZU(hCPU, opcode);
-			break;
+			return PPCInterpreter_LBZU;
 		case 36:
-			PPCInterpreter_STW(hCPU, opcode);
-			break;
+			return PPCInterpreter_STW;
 		case 37:
-			PPCInterpreter_STWU(hCPU, opcode);
-			break;
+			return PPCInterpreter_STWU;
 		case 38:
-			PPCInterpreter_STB(hCPU, opcode);
-			break;
+			return PPCInterpreter_STB;
 		case 39:
-			PPCInterpreter_STBU(hCPU, opcode);
-			break;
+			return PPCInterpreter_STBU;
 		case 40:
-			PPCInterpreter_LHZ(hCPU, opcode);
-			break;
+			return PPCInterpreter_LHZ;
 		case 41:
-			PPCInterpreter_LHZU(hCPU, opcode);
-			break;
+			return PPCInterpreter_LHZU;
 		case 42:
-			PPCInterpreter_LHA(hCPU, opcode);
-			break;
+			return PPCInterpreter_LHA;
 		case 43:
-			PPCInterpreter_LHAU(hCPU, opcode);
-			break;
+			return PPCInterpreter_LHAU;
 		case 44:
-			PPCInterpreter_STH(hCPU, opcode);
-			break;
+			return PPCInterpreter_STH;
 		case 45:
-			PPCInterpreter_STHU(hCPU, opcode);
-			break;
+			return PPCInterpreter_STHU;
 		case 46:
-			PPCInterpreter_LMW(hCPU, opcode);
-			break;
+			return PPCInterpreter_LMW;
 		case 47:
-			PPCInterpreter_STMW(hCPU, opcode);
-			break;
+			return PPCInterpreter_STMW;
 		case 48:
-			PPCInterpreter_LFS(hCPU, opcode);
-			break;
+			return PPCInterpreter_LFS;
 		case 49:
-			PPCInterpreter_LFSU(hCPU, opcode);
-			break;
+			return PPCInterpreter_LFSU;
 		case 50:
-			PPCInterpreter_LFD(hCPU, opcode);
-			break;
+			return PPCInterpreter_LFD;
 		case 51:
-			PPCInterpreter_LFDU(hCPU, opcode);
-			break;
+			return PPCInterpreter_LFDU;
 		case 52:
-			PPCInterpreter_STFS(hCPU, opcode);
-			break;
+			return PPCInterpreter_STFS;
 		case 53:
-			PPCInterpreter_STFSU(hCPU, opcode);
-			break;
+			return PPCInterpreter_STFSU;
 		case 54:
-			PPCInterpreter_STFD(hCPU, opcode);
-			break;
+			return PPCInterpreter_STFD;
 		case 55:
-			PPCInterpreter_STFDU(hCPU, opcode);
-			break;
+			return PPCInterpreter_STFDU;
 		case 56:
-			PPCInterpreter_PSQ_L(hCPU, opcode);
-			break;
+			return PPCInterpreter_PSQ_L;
 		case 57:
-			PPCInterpreter_PSQ_LU(hCPU, opcode);
-			break;
+			return PPCInterpreter_PSQ_LU;
 		case 59: // opcode category
 			switch (PPC_getBits(opcode, 30, 5))
 			{
 			case 18:
-				PPCInterpreter_FDIVS(hCPU, opcode);
-				break;
+				return PPCInterpreter_FDIVS;
 			case 20:
-				PPCInterpreter_FSUBS(hCPU, opcode);
-				break;
+				return PPCInterpreter_FSUBS;
 			case 21:
-				PPCInterpreter_FADDS(hCPU, opcode);
-				break;
+				return PPCInterpreter_FADDS;
 			case 24:
-				PPCInterpreter_FRES(hCPU, opcode);
-				break;
+				return PPCInterpreter_FRES;
 			case 25:
-				PPCInterpreter_FMULS(hCPU, opcode);
-				break;
+				return PPCInterpreter_FMULS;
 			case 28:
-				PPCInterpreter_FMSUBS(hCPU, opcode);
-				break;
+				return PPCInterpreter_FMSUBS;
 			case 29:
-				PPCInterpreter_FMADDS(hCPU, opcode);
-				break;
+				return PPCInterpreter_FMADDS;
 			case 30:
-				PPCInterpreter_FNMSUBS(hCPU, opcode);
-				break;
+				return PPCInterpreter_FNMSUBS;
 			case 31:
-				PPCInterpreter_FNMADDS(hCPU, opcode);
-				break;
+				return PPCInterpreter_FNMADDS;
 			default:
-				cemuLog_logDebug(LogType::Force, "Unknown execute {:04x} as [59] at {:08x}\n", PPC_getBits(opcode, 30, 10), hCPU->instructionPointer);
-				cemu_assert_unimplemented();
-				hCPU->instructionPointer += 4;
-				break;
+				return PPCInterpreter_unknownInstruction;
 			}
-			break;
 		case 60:
-			PPCInterpreter_PSQ_ST(hCPU, opcode);
-			break;
+			return PPCInterpreter_PSQ_ST;
 		case 61:
-			PPCInterpreter_PSQ_STU(hCPU, opcode);
-			break;
+			return PPCInterpreter_PSQ_STU;
 		case 63: // opcode category
 			switch (PPC_getBits(opcode, 30, 5))
 			{
 			case 0:
-				PPCInterpreter_FCMPU(hCPU, opcode);
-				break;
+				return PPCInterpreter_FCMPU;
 			case 12:
-				PPCInterpreter_FRSP(hCPU, opcode);
-				break;
+				return PPCInterpreter_FRSP;
 			case 15:
-				PPCInterpreter_FCTIWZ(hCPU, opcode);
-				break;
+				return PPCInterpreter_FCTIWZ;
 			case 18:
-				PPCInterpreter_FDIV(hCPU, opcode);
-				break;
+				return PPCInterpreter_FDIV;
 			case 20:
-				PPCInterpreter_FSUB(hCPU, opcode);
-				break;
+				return PPCInterpreter_FSUB;
 			case 21:
-				PPCInterpreter_FADD(hCPU, opcode);
-				break;
+				return PPCInterpreter_FADD;
 			case 23:
-				PPCInterpreter_FSEL(hCPU, opcode);
-				break;
+				return PPCInterpreter_FSEL;
 			case 25:
-				PPCInterpreter_FMUL(hCPU, opcode);
-				break;
+				return PPCInterpreter_FMUL;
 			case 26:
-				PPCInterpreter_FRSQRTE(hCPU, opcode);
-				break;
+				return PPCInterpreter_FRSQRTE;
 			case 28:
-				PPCInterpreter_FMSUB(hCPU, opcode);
-				break;
+				return PPCInterpreter_FMSUB;
 			case 29:
-				PPCInterpreter_FMADD(hCPU, opcode);
-				break;
+				return PPCInterpreter_FMADD;
 			case 30:
-				PPCInterpreter_FNMSUB(hCPU, opcode);
-				break;
+				return PPCInterpreter_FNMSUB;
 			case 31:
-				PPCInterpreter_FNMADD(hCPU, opcode);
-				break;
+				return PPCInterpreter_FNMADD;
 			default:
 				switch (PPC_getBits(opcode, 30, 10))
 				{
 				case 14:
-					PPCInterpreter_FCTIW(hCPU, opcode);
-					break;
+					return PPCInterpreter_FCTIW;
 				case 32:
-					PPCInterpreter_FCMPO(hCPU, opcode);
-					break;
+					return PPCInterpreter_FCMPO;
 				case 38:
-					PPCInterpreter_MTFSB1X(hCPU, opcode);
-					break;
+					return PPCInterpreter_MTFSB1X;
 				case 40:
-					PPCInterpreter_FNEG(hCPU, opcode);
-					break;
+					return PPCInterpreter_FNEG;
 				case 72:
-					PPCInterpreter_FMR(hCPU, opcode);
-					break;
+					return PPCInterpreter_FMR;
 				case 136: // Darksiders 2
-					PPCInterpreter_FNABS(hCPU, opcode);
-					break;
+					return PPCInterpreter_FNABS;
 				case 264:
-					PPCInterpreter_FABS(hCPU, opcode);
-					break;
+					return PPCInterpreter_FABS;
 				case 583:
-					PPCInterpreter_MFFS(hCPU, opcode);
-					break;
+					return PPCInterpreter_MFFS;
 				case 711:
-					PPCInterpreter_MTFSF(hCPU, opcode);
-					break;
+					return PPCInterpreter_MTFSF;
 				default:
-					cemuLog_logDebug(LogType::Force, "Unknown execute {:04x} as [63] at {:08x}\n", PPC_getBits(opcode, 30, 10), hCPU->instructionPointer);
-					cemu_assert_unimplemented();
-					PPCInterpreter_nextInstruction(hCPU);
-					break;
+					return PPCInterpreter_unknownInstruction;
 				}
 			}
-			break;
 		default:
-			cemuLog_logDebug(LogType::Force, "Unknown execute {:04x} at {:08x}\n", PPC_getBits(opcode, 5, 6), (unsigned int)hCPU->instructionPointer);
-			cemu_assert_unimplemented();
+			return PPCInterpreter_unknownInstruction;
 		}
 	}
+
+	static void executeInstruction(PPCInterpreter_t* hCPU)
+	{
+		if constexpr(ppcItpCtrl::allowSupervisorMode)
+		{
+			hCPU->global->tb++;
+		}
+
+#ifdef __DEBUG_OUTPUT_INSTRUCTION
+		debug_printf("%08x: ", hCPU->instructionPointer);
+#endif
+
+		uint32 opcode = ppcItpCtrl::memory_readCodeU32(hCPU, hCPU->instructionPointer);
+		decodeInstruction(opcode)(hCPU, opcode);
+	}
 };
 
 // Slim interpreter, trades some features for extra performance
@@ -1263,3 +1020,202 @@ void PPCInterpreterFull_executeInstruction(PPCInterpreter_t* hCPU)
 {
 	PPCInterpreterContainer<PPCItpSupervisorWithMMU>::executeInstruction(hCPU);
 }
+
+// Predecoded block cache for the slim interpreter
+// Straight-line runs of instructions are decoded once into a list of handler pointers and replayed until the range is invalidated
+// Blocks end on branches, system calls and HLE gateways and never cross a 4KB page boundary, which bounds how far back invalidation has to look
+
+constexpr uint32 PPC_ITP_BLOCK_MAX_INSTRUCTIONS = 32;
+constexpr uint32 PPC_ITP_BLOCK_PAGE_SHIFT = 16; // each lookup page covers 64KB of guest address space
+constexpr uint32 PPC_ITP_BLOCK_PAGE_ENTRIES = (1 << PPC_ITP_BLOCK_PAGE_SHIFT) / 4;
+
+struct PPCItpPredecodedBlock
+{
+	struct Instruction
+	{
+		void(*handler)(PPCInterpreter_t* hCPU, uint32 opcode);
+		uint32 opcode;
+	};
+
+	uint32 address;
+	uint32 instructionCount;
+	Instruction instructions[PPC_ITP_BLOCK_MAX_INSTRUCTIONS];
+};
+
+struct PPCItpBlockPage
+{
+	std::atomic<PPCItpPredecodedBlock*> entries[PPC_ITP_BLOCK_PAGE_ENTRIES]{};
+};
+
+static std::atomic<PPCItpBlockPage*> s_itpBlockPages[1 << (32 - PPC_ITP_BLOCK_PAGE_SHIFT)];
+static FSpinlock s_itpBlockCacheLock;
+static std::vector<PPCItpPredecodedBlock*> s_itpRetiredBlocks; // invalidated blocks may still be executed by other cores, they are only freed on cache reset
+
+static bool PPCInterpreterSlim_isBlockTerminator(uint32 opcode)
+{
+	switch (opcode >> 26)
+	{
+	case 0: // invalid
+	case 1: // HLE gateway
+	case 16: // bc
+	case 17: // sc
+	case 18: // b
+		return true;
+	case 19:
+	{
+		uint32 subOpcode = PPC_getBits(opcode, 30, 10);
+		return subOpcode == 16 || subOpcode == 50 || subOpcode == 150 || subOpcode == 528; // bclr, rfi, isync, bcctr
+	}
+	default:
+		break;
+	}
+	return false;
+}
+
+static PPCItpPredecodedBlock* PPCInterpreterSlim_createBlock(uint32 address)
+{
+	std::unique_lock _l(s_itpBlockCacheLock);
+	PPCItpBlockPage* page = s_itpBlockPages[address >> PPC_ITP_BLOCK_PAGE_SHIFT].load(std::memory_order_relaxed);
+	if (!page)
+	{
+		page = new PPCItpBlockPage();
+		s_itpBlockPages[address >> PPC_ITP_BLOCK_PAGE_SHIFT].store(page, std::memory_order_release);
+	}
+	auto& entry = page->entries[(address & ((1 << PPC_ITP_BLOCK_PAGE_SHIFT) - 1)) / 4];
+	PPCItpPredecodedBlock* block = entry.load(std::memory_order_relaxed);
+	if (block)
+		return block; // created by another core in the meantime
+	block = new PPCItpPredecodedBlock();
+	block->address = address;
+	block->instructionCount = 0;
+	uint32 currentAddress = address;
+	while (block->instructionCount < PPC_ITP_BLOCK_MAX_INSTRUCTIONS)
+	{
+		uint32 opcode = PPCItpCafeOSUsermode::memory_readCodeU32(nullptr, currentAddress);
+		block->instructions[block->instructionCount].handler = PPCInterpreterContainer<PPCItpCafeOSUsermode>::decodeInstruction(opcode);
+		block->instructions[block->instructionCount].opcode = opcode;
+		block->instructionCount++;
+		currentAddress += 4;
+		if (PPCInterpreterSlim_isBlockTerminator(opcode) || (currentAddress & 0xFFF) == 0)
+			break;
+	}
+	entry.store(block, std::memory_order_release);
+	return block;
+}
+
+static inline PPCItpPredecodedBlock* PPCInterpreterSlim_getBlock(uint32 address)
+{
+	PPCItpBlockPage* page = s_itpBlockPages[address >> PPC_ITP_BLOCK_PAGE_SHIFT].load(std::memory_order_acquire);
+	if (page)
+	{
+		PPCItpPredecodedBlock* block = page->entries[(address & ((1 << PPC_ITP_BLOCK_PAGE_SHIFT) - 1)) / 4].load(std::memory_order_acquire);
+		if (block)
+			return block;
+	}
+	return PPCInterpreterSlim_createBlock(address);
+}
+
+// executes instructions until remainingCycles is exhausted, equivalent to calling PPCInterpreterSlim_executeInstruction() in a loop
+void PPCInterpreterSlim_executeInstructions(PPCInterpreter_t* hCPU)
+{
+	while ((--hCPU->remainingCycles) >= 0)
+	{
+		PPCItpPredecodedBlock* block = PPCInterpreterSlim_getBlock(hCPU->instructionPointer);
+		const PPCItpPredecodedBlock::Instruction* instruction = block->instructions;
+		const PPCItpPredecodedBlock::Instruction* instructionEnd = block->instructions + block->instructionCount;
+		uint32 expectedIP = block->address;
+		while (true)
+		{
+			instruction->handler(hCPU, instruction->opcode);
+			instruction++;
+			expectedIP += 4;
+			// leave the block if it ended or if the instruction redirected control flow (including thread switches from within HLE functions)
+			if (instruction == instructionEnd || hCPU->instructionPointer != expectedIP)
+				break;
+			if ((--hCPU->remainingCycles) < 0)
+				return;
+		}
+	}
+}
+
+void PPCInterpreterSlim_invalidateRange(uint32 startAddr, uint32 endAddr)
+{
+	if (endAddr <= startAddr)
+		return;
+	std::unique_lock _l(s_itpBlockCacheLock);
+	// blocks never cross a 4KB boundary, so only blocks starting in the same page up to PPC_ITP_BLOCK_MAX_INSTRUCTIONS before the range can overlap it
+	uint32 scanStart = startAddr & ~3;
+	scanStart = std::max<uint32>(scanStart & ~0xFFF, scanStart - std::min<uint32>(scanStart, (PPC_ITP_BLOCK_MAX_INSTRUCTIONS - 1) * 4));
+	uint64 currentAddr = scanStart;
+	while (currentAddr < endAddr)
+	{
+		PPCItpBlockPage* page = s_itpBlockPages[currentAddr >> PPC_ITP_BLOCK_PAGE_SHIFT].load(std::memory_order_relaxed);
+		if (!page)
+		{
+			currentAddr = ((currentAddr >> PPC_ITP_BLOCK_PAGE_SHIFT) + 1) << PPC_ITP_BLOCK_PAGE_SHIFT;
+			continue;
+		}
+		auto& entry = page->entries[(currentAddr & ((1 << PPC_ITP_BLOCK_PAGE_SHIFT) - 1)) / 4];
+		PPCItpPredecodedBlock* block = entry.load(std::memory_order_relaxed);
+		if (block && (block->address + block->instructionCount * 4) > startAddr)
+		{
+			entry.store(nullptr, std::memory_order_release);
+			s_itpRetiredBlocks.emplace_back(block);
+		}
+		currentAddr += 4;
+	}
+}
+
+// frees all predecoded blocks. Must only be called while no PPC code is being executed
+void PPCInterpreterSlim_resetBlockCache()
+{
+	std::unique_lock _l(s_itpBlockCacheLock);
+	for (auto& pageEntry : s_itpBlockPages)
+	{
+		PPCItpBlockPage* page = pageEntry.load(std::memory_order_relaxed);
+		if (!page)
+			continue;
+		for (auto& entry : page->entries)
+			delete entry.load(std::memory_order_relaxed);
+		delete page;
+		pageEntry.store(nullptr, std::memory_order_relaxed);
+	}
+	for (auto& block : s_itpRetiredBlocks)
+		delete block;
+	s_itpRetiredBlocks.clear();
+}
+
+// compares the throughput of the per-instruction decoder against the predecoded block path
+// disabled by default since it requires mapped guest memory and overwrites the code at the benchmark address
+void PPCInterpreterSlim_benchmark()
+{
+	return;
+
+	const uint32 codeAddr = 0x02000000;
+	const sint32 instructionCount = 100'000'000;
+	// loop: addi r3,r3,1; xor r4,r4,r3; rlwinm r5,r4,4,0,27; add r6,r6,r5; cmpw r3,r7; b loop
+	const uint32 loopCode[] = { 0x38630001, 0x7C841A78, 0x54852036, 0x7CC62A14, 0x7C033800, 0x4BFFFFEC };
+	for (size_t i = 0; i < std::size(loopCode); i++)
+		*(uint32be*)(memory_base + codeAddr + i * 4) = loopCode[i];
+	PPCInterpreterSlim_invalidateRange(codeAddr, codeAddr + sizeof(loopCode));
+
+	PPCInterpreter_t* hCPU = PPCInterpreter_createInstance(codeAddr);
+	BenchmarkTimer bt;
+	// per-instruction decoding
+	hCPU->instructionPointer = codeAddr;
+	hCPU->remainingCycles = instructionCount;
+	bt.Start();
+	while ((--hCPU->remainingCycles) >= 0)
+		PPCInterpreterSlim_executeInstruction(hCPU);
+	bt.Stop();
+	double decodeMS = bt.GetElapsedMilliseconds();
+	// predecoded blocks
+	hCPU->instructionPointer = codeAddr;
+	hCPU->remainingCycles = instructionCount;
+	bt.Start();
+	PPCInterpreterSlim_executeInstructions(hCPU);
+	bt.Stop();
+	double predecodedMS = bt.GetElapsedMilliseconds();
+	cemuLog_log(LogType::Force, "Interpreter benchmark: {:.2f} MIPS (decode per instruction), {:.2f} MIPS (predecoded)", (double)instructionCount / decodeMS / 1000.0, (double)instructionCount / predecodedMS / 1000.0);
+	cemu_assert_debug(false);
+}
@@ -81,10 +81,7 @@ PPCInterpreter_t* PPCCore_executeCallbackInternal(uint32 functionMPTR)
 			// try to enter recompiler immediately
 			PPCRecompiler_attemptEnter(hCPU, hCPU->instructionPointer);
 			// execute any remaining instructions in interpreter
-			while ((--hCPU->remainingCycles) >= 0)
-			{
-				PPCInterpreterSlim_executeInstruction(hCPU);
-			};
+			PPCInterpreterSlim_executeInstructions(hCPU);
 		}
 		if (hCPU->instructionPointer == 0)
 		{
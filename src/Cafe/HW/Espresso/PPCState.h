@@ -161,6 +161,9 @@ void PPCInterpreter_jumpToInstruction(PPCInterpreter_t* cpuInterpreter, uint32 n
 
 void PPCInterpreterSlim_executeInstruction(PPCInterpreter_t* hCPU);
 void PPCInterpreterFull_executeInstruction(PPCInterpreter_t* hCPU);
+void PPCInterpreterSlim_executeInstructions(PPCInterpreter_t* hCPU);
+void PPCInterpreterSlim_invalidateRange(uint32 startAddr, uint32 endAddr);
+void PPCInterpreterSlim_resetBlockCache();
 
 // misc
 
@@ -52,6 +52,8 @@ static std::mutex s_singleRecompilationMutex;
 #endif
 
 bool ppcRecompilerEnabled = false;
+bool ppcRecompilerSkipSpinLoops = true;
+PPCRecompilerSpinLoopStats ppcRecompilerSpinLoopStats;
 
 void PPCRecompiler_recompileAtAddress(uint32 address);
 
@@ -607,6 +609,7 @@ void PPCRecompiler_deleteFunction(PPCRecFunction_t* func)
 
 void PPCRecompiler_invalidateRange(uint32 startAddr, uint32 endAddr)
 {
+	PPCInterpreterSlim_invalidateRange(startAddr, endAddr);
 	if (ppcRecompilerEnabled == false)
 		return;
 	if (startAddr >= PPC_REC_CODE_AREA_SIZE)
@@ -143,6 +143,16 @@ typedef struct
 
 extern PPCRecompilerInstanceData_t* ppcRecompilerInstanceData;
 extern bool ppcRecompilerEnabled;
+extern bool ppcRecompilerSkipSpinLoops; // if true, guest loops which only poll memory give up their timeslice instead of burning cycles. Set by game profile
+
+struct PPCRecompilerSpinLoopStats
+{
+	std::atomic_uint32_t numDetected{}; // number of recompiled spin loops
+	std::atomic_uint64_t numYields{};
+	std::atomic_uint64_t skippedCycles{};
+};
+
+extern PPCRecompilerSpinLoopStats ppcRecompilerSpinLoopStats;
 
 void PPCRecompiler_init();
 void PPCRecompiler_Shutdown();
@@ -3071,6 +3071,138 @@ void PPCRecompiler_HandleCycleCheckCount(ppcImlGenContext_t& ppcImlGenContext, P
 	exitSegment->SetNextSegmentForOverwriteHints(splitSeg->nextSegmentBranchNotTaken);
 }
 
+// returns true if the basic block is a short loop which only polls memory or the time base, e.g. waiting for a flag set by another thread
+// every iteration that does not exit the loop leaves the guest state unchanged, so instead of spinning the thread can yield its timeslice
+bool PPCRecompiler_IsBasicBlockASpinLoop(PPCBasicBlockInfo& basicBlockInfo)
+{
+	constexpr uint32 kMaxSpinLoopInstructions = 8;
+	if (!basicBlockInfo.hasBranchTarget || basicBlockInfo.branchTarget != basicBlockInfo.startAddress)
+		return false;
+	uint32 instructionCount = (basicBlockInfo.lastAddress - basicBlockInfo.startAddress) / 4 + 1;
+	if (instructionCount > kMaxSpinLoopInstructions)
+		return false;
+	// the loop must end with a conditional branch that does not touch CTR or LR
+	uint32 branchOpcode = *(uint32be*)(memory_base + basicBlockInfo.lastAddress);
+	if (Espresso::GetPrimaryOpcode(branchOpcode) != Espresso::PrimaryOpcode::BC)
+		return false;
+	uint32 BD, BI;
+	Espresso::BOField BO;
+	bool AA, LK;
+	Espresso::decodeOp_BC(branchOpcode, BD, BO, BI, AA, LK);
+	if (AA || LK || BO.conditionIgnore() || !BO.decrementerIgnore())
+		return false;
+	// all other instructions must be free of side effects and each GPR they write must be written before it is read
+	// otherwise an iteration could depend on the previous one (e.g. a counter)
+	uint32 gprWritten = 0;
+	uint32 gprReadBeforeWrite = 0;
+	auto readGPR = [&](uint32 r) { if (!(gprWritten & (1u << r))) gprReadBeforeWrite |= (1u << r); };
+	auto readBaseGPR = [&](uint32 r) { if (r != 0) readGPR(r); }; // r0 as base register means zero
+	auto writeGPR = [&](uint32 r) { gprWritten |= (1u << r); };
+	for (uint32 addr = basicBlockInfo.startAddress; addr < basicBlockInfo.lastAddress; addr += 4)
+	{
+		uint32 opcode = *(uint32be*)(memory_base + addr);
+		uint32 rD = (opcode >> 21) & 0x1F;
+		uint32 rA = (opcode >> 16) & 0x1F;
+		uint32 rB = (opcode >> 11) & 0x1F;
+		switch (Espresso::GetPrimaryOpcode(opcode))
+		{
+		case Espresso::PrimaryOpcode::LWZ:
+		case Espresso::PrimaryOpcode::LBZ:
+		case Espresso::PrimaryOpcode::LHZ:
+		case Espresso::PrimaryOpcode::LHA:
+		case Espresso::PrimaryOpcode::ADDI:
+		case Espresso::PrimaryOpcode::ADDIS:
+			readBaseGPR(rA);
+			writeGPR(rD);
+			break;
+		case Espresso::PrimaryOpcode::CMPI:
+		case Espresso::PrimaryOpcode::CMPLI:
+			readGPR(rA);
+			break;
+		case Espresso::PrimaryOpcode::RLWINM:
+		case Espresso::PrimaryOpcode::ORI:
+		case Espresso::PrimaryOpcode::ORIS:
+		case Espresso::PrimaryOpcode::XORI:
+		case Espresso::PrimaryOpcode::XORIS:
+		case Espresso::PrimaryOpcode::ANDI_:
+		case Espresso::PrimaryOpcode::ANDIS_:
+			readGPR(rD); // rS
+			writeGPR(rA);
+			break;
+		case Espresso::PrimaryOpcode::GROUP_19:
+			if (Espresso::GetGroup19Opcode(opcode) != Espresso::Opcode19::ISYNC)
+				return false;
+			break;
+		case Espresso::PrimaryOpcode::GROUP_31:
+		{
+			// note: the extended opcode includes the OE bit, so overflow-enabled arithmetic (which modifies XER) is rejected
+			uint32 opcode31 = (uint32)Espresso::GetGroup31Opcode(opcode);
+			if (opcode31 == 0 || opcode31 == 32) // CMP, CMPL
+			{
+				readGPR(rA);
+				readGPR(rB);
+			}
+			else if (opcode31 == 23 || opcode31 == 87 || opcode31 == 279 || opcode31 == 343) // LWZX, LBZX, LHZX, LHAX
+			{
+				readBaseGPR(rA);
+				readGPR(rB);
+				writeGPR(rD);
+			}
+			else if (opcode31 == 40 || opcode31 == 266) // SUBF, ADD
+			{
+				readGPR(rA);
+				readGPR(rB);
+				writeGPR(rD);
+			}
+			else if (opcode31 == 28 || opcode31 == 60 || opcode31 == 316 || opcode31 == 444) // AND, ANDC, XOR, OR
+			{
+				readGPR(rD); // rS
+				readGPR(rB);
+				writeGPR(rA);
+			}
+			else if (opcode31 == (uint32)Espresso::Opcode31::MFTB)
+				writeGPR(rD);
+			else if (opcode31 == 598 || opcode31 == 854) // SYNC, EIEIO
+				;
+			else
+				return false;
+			break;
+		}
+		default:
+			return false;
+		}
+	}
+	return (gprReadBeforeWrite & gprWritten) == 0;
+}
+
+ATTR_MS_ABI void PPCRecompiler_YieldSpinLoop()
+{
+	PPCInterpreter_t* hCPU = PPCInterpreter_getCurrentInstance();
+	// scheduling is disabled while interrupts are off, the thread may be waiting on a lock held by another core
+	if (hCPU->coreInterruptMask == 0 || hCPU->remainingCycles < 0)
+		return;
+	ppcRecompilerSpinLoopStats.numYields++;
+	ppcRecompilerSpinLoopStats.skippedCycles += (uint64)hCPU->remainingCycles + 1;
+	PPCInterpreter_relinquishTimeslice();
+}
+
+// redirect the back edge of a spin loop through a segment which gives up the remaining timeslice
+// the loop body runs once more and the cycle check at the end of the loop, placed before the back edge, then leaves the recompiler so the scheduler can switch to another thread
+void PPCRecompiler_InsertSpinLoopYield(ppcImlGenContext_t& ppcImlGenContext, PPCBasicBlockInfo& basicBlockInfo)
+{
+	IMLSegment* loopSegment = basicBlockInfo.GetFirstSegmentInChain();
+	IMLSegment* branchSegment = basicBlockInfo.GetSegmentForInstructionAppend();
+	if (branchSegment->GetBranchTaken() != loopSegment || !branchSegment->HasSuffixInstruction() || branchSegment->GetLastInstruction()->type != PPCREC_IML_TYPE_CONDITIONAL_JUMP)
+		return;
+	IMLSegment* yieldSegment = ppcImlGenContext.NewSegment();
+	yieldSegment->AppendInstruction()->make_call_imm((uintptr_t)PPCRecompiler_YieldSpinLoop, IMLREG_INVALID, IMLREG_INVALID, IMLREG_INVALID, IMLREG_INVALID);
+	yieldSegment->AppendInstruction()->make_jump();
+	branchSegment->SetLinkBranchTaken(yieldSegment);
+	yieldSegment->SetLinkBranchTaken(loopSegment);
+	ppcRecompilerSpinLoopStats.numDetected++;
+	cemuLog_log(LogType::Recompiler, "Spin loop detected at 0x{:08x}", basicBlockInfo.startAddress);
+}
+
 void PPCRecompiler_SetSegmentsUncertainFlow(ppcImlGenContext_t& ppcImlGenContext)
 {
 	for (IMLSegment* segIt : ppcImlGenContext.segmentList2)
@@ -3187,6 +3319,16 @@ bool PPCRecompiler_GenerateIML(ppcImlGenContext_t& ppcImlGenContext, PPCFunction
 		ppcImlGenContext.currentBasicBlock = nullptr;
 	}
 
+	// let spin loops yield instead of running until the timeslice is used up
+	if (ppcRecompilerSkipSpinLoops)
+	{
+		for (PPCBasicBlockInfo& basicBlockInfo : basicBlockList)
+		{
+			if (PPCRecompiler_IsBasicBlockASpinLoop(basicBlockInfo))
+				PPCRecompiler_InsertSpinLoopYield(ppcImlGenContext, basicBlockInfo);
+		}
+	}
+
 	// mark segments with unknown jump destination (e.g. BLR and most macros)
 	PPCRecompiler_SetSegmentsUncertainFlow(ppcImlGenContext);
 
@@ -289,6 +289,68 @@ void _fetchShaderDecompiler_parseCF(LatteFetchShader* parsedFetchShader, uint32*
 	cemu_assert_debug(false); // program must be terminated with an instruction that has EOP set?
 }
 
+// formats for which the attribute decoder can skip the byte swap of the given endian mode
+bool _isHostEndianConvertibleFormat(LatteParsedFetchShaderAttribute_t* attrib)
+{
+	if (attrib->endianSwap == LatteConst::VertexFetchEndianMode::SWAP_U32)
+	{
+		return attrib->format == FMT_32_32_32_32 || attrib->format == FMT_32_32_32_32_FLOAT ||
+			attrib->format == FMT_32_32_32 || attrib->format == FMT_32_32_32_FLOAT ||
+			attrib->format == FMT_32_32 || attrib->format == FMT_32_32_FLOAT ||
+			attrib->format == FMT_32 || attrib->format == FMT_32_FLOAT ||
+			attrib->format == FMT_2_10_10_10 || attrib->format == FMT_8_8_8_8;
+	}
+	else if (attrib->endianSwap == LatteConst::VertexFetchEndianMode::SWAP_U16)
+	{
+		return attrib->format == FMT_16_16_16_16 || attrib->format == FMT_16_16_16_16_FLOAT ||
+			attrib->format == FMT_16_16 || attrib->format == FMT_16_16_FLOAT ||
+			attrib->format == FMT_16 || attrib->format == FMT_16_FLOAT;
+	}
+	return false;
+}
+
+// vertex data of a buffer group can be converted to host endianness once on the CPU if every attribute uses a supported byte swap
+// and attributes which share bytes agree on how they are swapped. Swapped attributes need to be aligned to the swap size within the vertex
+void _calculateHostEndianLayout(LatteParsedFetchShaderBufferGroup_t& bufferGroup)
+{
+	bufferGroup.canConvertToHostEndian = false;
+	bufferGroup.hostEndianLayoutKey = 0;
+	uint64 layoutKey = 0;
+	bool hasByteSwap = false;
+	for (sint32 i = 0; i < bufferGroup.attribCount; i++)
+	{
+		LatteParsedFetchShaderAttribute_t* attrib = bufferGroup.attrib + i;
+		if (attrib->endianSwap == LatteConst::VertexFetchEndianMode::SWAP_NONE)
+			continue;
+		if (!_isHostEndianConvertibleFormat(attrib))
+			return;
+		uint32 swapSize = attrib->endianSwap == LatteConst::VertexFetchEndianMode::SWAP_U32 ? 4 : 2;
+		if ((attrib->offset % swapSize) != 0)
+			return;
+		uint32 attribSize = LatteShaderRecompiler_getAttributeSize(attrib);
+		for (sint32 f = 0; f < bufferGroup.attribCount; f++)
+		{
+			LatteParsedFetchShaderAttribute_t* otherAttrib = bufferGroup.attrib + f;
+			if (f == i)
+				continue;
+			uint32 otherSize = LatteShaderRecompiler_getAttributeSize(otherAttrib);
+			if (otherAttrib->offset >= attrib->offset + attribSize || attrib->offset >= otherAttrib->offset + otherSize)
+				continue;
+			if (otherAttrib->endianSwap != attrib->endianSwap)
+				return;
+		}
+		layoutKey = std::rotl<uint64>(layoutKey, 11);
+		layoutKey += (uint64)attrib->offset;
+		layoutKey = std::rotl<uint64>(layoutKey, 5);
+		layoutKey += (uint64)attribSize;
+		layoutKey = std::rotl<uint64>(layoutKey, 2);
+		layoutKey += (uint64)attrib->endianSwap;
+		hasByteSwap = true;
+	}
+	bufferGroup.canConvertToHostEndian = hasByteSwap;
+	bufferGroup.hostEndianLayoutKey = layoutKey;
+}
+
 // parse fetch shader and create LatteFetchShader object
 // also registers the fs in the cache (s_fetchShaderByHash)
 // can be assumed to be thread-safe, if called simultaneously on the same fetch shader only one shader will become registered. The others will be destroyed
@@ -384,6 +446,7 @@ LatteFetchShader* LatteShaderRecompiler_createFetchShader(LatteFetchShader::Cach
 			vboOffset = (vboOffset+attribAlignment-1)&~(attribAlignment-1);
 		}
 		bufferGroup.vboStride = vboOffset;
+		_calculateHostEndianLayout(bufferGroup);
 	}
 	LatteShader_calculateFSKey(newFetchShader);
 	newFetchShader->CalculateFetchShaderVkHash();
@@ -28,6 +28,9 @@ struct LatteParsedFetchShaderBufferGroup_t
 	// calculated info
 	bool hasVtxIndexAccess{};
 	bool hasInstanceIndexAccess{};
+	// if set, the byte swaps of all attributes can be applied to the vertex data ahead of time (see LatteBufferCache_retrieveVertexStreamInCache)
+	bool canConvertToHostEndian{};
+	uint64 hostEndianLayoutKey{}; // identifies the byte swaps applied to a vertex
 
 	uint32 getCurrentBufferStride(uint32* contextRegister) const;
 };
@@ -69,4 +72,6 @@ struct LatteFetchShader
 	static std::unordered_map<CacheHash, LatteFetchShader*> s_fetchShaderByHash;
 };
 
+uint32 LatteShaderRecompiler_getAttributeSize(LatteParsedFetchShaderAttribute_t* attrib);
+
 LatteFetchShader* LatteShaderRecompiler_createFetchShader(LatteFetchShader::CacheHash fsHash, uint32* contextRegister, uint32* fsProgramCode, uint32 fsProgramSize);
\ No newline at end of file
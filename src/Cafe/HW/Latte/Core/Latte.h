@@ -14,6 +14,8 @@ struct gx2GPUSharedArea_t
 	volatile uint32 swapInterval; // vsync swap interval (0 means vsync is deactivated)
 };
 
+#define LATTE_REG_TRACKING_BLOCK_SHIFT	(5) // registers are tracked in blocks of 32
+
 struct LatteGPUState_t
 {
 	union
@@ -22,6 +24,9 @@ struct LatteGPUState_t
 		LatteContextRegister contextNew;
 	};
 	MPTR contextRegisterShadowAddr[LATTE_MAX_REGISTER];
+	// register write tracking, see LatteReg_markWritten()
+	uint64 registerWriteStamp;
+	uint64 registerBlockWriteStamp[LATTE_MAX_REGISTER >> LATTE_REG_TRACKING_BLOCK_SHIFT];
 	// context control
 	uint32 contextControl0;
 	uint32 contextControl1;
@@ -51,6 +56,7 @@ struct LatteGPUState_t
 	// OpenGL control
 	uint32 glVendor; // GLVENDOR_*
 	bool isDRCPrimary = false;
+	bool isCaptureReplay; // commands are fed from a capture file. There is no CPU side to wait for or to notify
 	// temporary (replace with proper solution later)
 	bool tvBufferUsesSRGB;
 	bool drcBufferUsesSRGB;
@@ -73,6 +79,47 @@ struct LatteGPUState_t
 
 extern LatteGPUState_t LatteGPUState;
 
+// register write tracking
+// every write to a block of registers stores a new stamp for that block. State derived from registers (e.g. pipeline and descriptor set hashes) can remember the stamp at which it was calculated and only needs to be recalculated if one of the blocks it depends on has a newer stamp
+// all code which writes to LatteGPUState.contextRegister must call one of the marking functions
+
+// registers in range [regStart, regEnd) were modified
+inline void LatteReg_markWritten(uint32 regStart, uint32 regEnd)
+{
+	cemu_assert_debug(regStart < regEnd && regEnd <= LATTE_MAX_REGISTER);
+	uint64 stamp = ++LatteGPUState.registerWriteStamp;
+	uint32 blockEnd = (regEnd - 1) >> LATTE_REG_TRACKING_BLOCK_SHIFT;
+	for (uint32 block = regStart >> LATTE_REG_TRACKING_BLOCK_SHIFT; block <= blockEnd; block++)
+		LatteGPUState.registerBlockWriteStamp[block] = stamp;
+}
+
+inline void LatteReg_markAllWritten()
+{
+	LatteReg_markWritten(0, LATTE_MAX_REGISTER);
+}
+
+inline uint64 LatteReg_getWriteStamp()
+{
+	return LatteGPUState.registerWriteStamp;
+}
+
+// returns true if any register in range [regStart, regEnd) was modified after the write stamp was queried
+inline bool LatteReg_wasWrittenSince(uint32 regStart, uint32 regEnd, uint64 stamp)
+{
+	uint32 blockEnd = (regEnd - 1) >> LATTE_REG_TRACKING_BLOCK_SHIFT;
+	for (uint32 block = regStart >> LATTE_REG_TRACKING_BLOCK_SHIFT; block <= blockEnd; block++)
+	{
+		if (LatteGPUState.registerBlockWriteStamp[block] > stamp)
+			return true;
+	}
+	return false;
+}
+
+inline bool LatteReg_wasWrittenSince(uint32 reg, uint64 stamp)
+{
+	return LatteGPUState.registerBlockWriteStamp[reg >> LATTE_REG_TRACKING_BLOCK_SHIFT] > stamp;
+}
+
 // texture
 
 #include "Cafe/HW/Latte/Core/LatteTexture.h"
@@ -132,6 +179,8 @@ void LatteTextureReadback_StartTransfer(LatteTextureView* textureView);
 bool LatteTextureReadback_Update(bool forceStart = false);
 void LatteTextureReadback_NotifyTextureDeletion(LatteTexture* texture);
 void LatteTextureReadback_UpdateFinishedTransfers(bool forceFinish);
+bool LatteTextureReadback_IsMemoryWritePending(MPTR physAddress);
+void LatteTextureReadback_WaitForMemoryWrites();
 
 // query
 
@@ -1,7 +1,19 @@
 #include "Cafe/HW/Latte/Renderer/Renderer.h"
+#include "Cafe/HW/Latte/ISA/RegDefines.h"
+#include "Cafe/HW/Latte/Core/FetchShader.h"
+#include "Cafe/HW/Latte/Core/LatteBufferCache.h"
 #include "util/ChunkedHeap/ChunkedHeap.h"
 #include "util/helpers/fspinlock.h"
 #include "config/ActiveSettings.h"
+#include "config/CemuConfig.h"
+#include "Common/cpu_features.h"
+#include <numeric>
+
+#if defined(ARCH_X86_64) && defined(__GNUC__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 #define CACHE_PAGE_SIZE		0x400
 #define CACHE_PAGE_SIZE_M1	(CACHE_PAGE_SIZE-1)
@@ -512,6 +524,42 @@ public:
 
 	bool HasStreamoutData() const { return m_hasStreamoutData; };
 
+	bool HasStreamoutDataInRange(MPTR rangeBegin, MPTR rangeEnd) const
+	{
+		if (!m_hasStreamoutData)
+			return false;
+		rangeBegin = std::max(rangeBegin, m_rangeBegin);
+		rangeEnd = std::min(rangeEnd, m_rangeEnd);
+		if (rangeBegin >= rangeEnd)
+			return false;
+		uint32 pageIndex = getPageIndexFromAddr(rangeBegin);
+		uint32 numPages = getPageCountFromRange(rangeBegin, rangeEnd);
+		for (uint32 i = 0; i < numPages; i++)
+		{
+			if (m_pageInfo[pageIndex + i].hasStreamoutData)
+				return true;
+		}
+		return false;
+	}
+
+	// combined hash of all pages overlapping the range. Changes whenever cached data within the range is updated
+	uint64 GetPageHashSum(MPTR rangeBegin, MPTR rangeEnd) const
+	{
+		rangeBegin = std::max(rangeBegin, m_rangeBegin);
+		rangeEnd = std::min(rangeEnd, m_rangeEnd);
+		if (rangeBegin >= rangeEnd)
+			return 0;
+		uint32 pageIndex = getPageIndexFromAddr(rangeBegin);
+		uint32 numPages = getPageCountFromRange(rangeBegin, rangeEnd);
+		uint64 hashSum = 0;
+		for (uint32 i = 0; i < numPages; i++)
+		{
+			hashSum = std::rotl<uint64>(hashSum, 3);
+			hashSum += m_pageInfo[pageIndex + i].hash;
+		}
+		return hashSum;
+	}
+
 private:
 	struct CachePageInfo
 	{
@@ -979,9 +1027,358 @@ void LatteBufferCache_invalidatePage(MPTR physAddress)
 		node->invalidate(physAddress, physAddress+CACHE_PAGE_SIZE);
 }
 
+// vertex streams converted to host endianness
+// most vertex data is static. Instead of byte swapping every attribute in each vertex shader invocation the swaps are applied once on upload
+// a stream is only converted after its data stayed unchanged for a few frames. The vertex shader is then specialized to skip the byte swaps for the buffer (see LatteBufferCache_getHostEndianVertexBufferMask)
+
+#define VERTEX_STREAM_STABLE_FRAMES		10	// number of frames without modifications until a stream is converted
+#define VERTEX_STREAM_MAX_FRAME_AGE		60
+
+bool s_convertVertexStreams = false;
+
+struct VertexStreamKey
+{
+	MPTR address;
+	uint32 stride;
+	uint64 layoutKey;
+
+	bool operator==(const VertexStreamKey& other) const
+	{
+		return address == other.address && stride == other.stride && layoutKey == other.layoutKey;
+	}
+};
+
+struct VertexStreamKeyHash
+{
+	size_t operator()(const VertexStreamKey& key) const
+	{
+		uint64 h = key.layoutKey;
+		h = std::rotl<uint64>(h, 17) + (uint64)key.address;
+		h = std::rotl<uint64>(h, 13) + (uint64)key.stride;
+		return (size_t)h;
+	}
+};
+
+struct VertexStream
+{
+	bool canConvert{};
+	// source tracking
+	uint64 sourceHash{};
+	uint32 size{}; // largest size requested by any drawcall
+	uint32 lastChangeFrame{};
+	uint32 lastUseFrame{};
+	// converted copy
+	bool isConverted{};
+	bool hasCacheAlloc{};
+	uint32 cacheOffset{};
+	uint32 cacheAllocSize{};
+	uint32 convertedSize{};
+	// source byte for each byte of a vertex
+	std::vector<uint16> vertexPermutation;
+	// same permutation as byte selection for every 16 byte chunk (as used by pshufb), repeats every lcm(stride, 16) bytes
+	// empty if the stride is not a multiple of 4
+	std::vector<uint8> shuffleMask;
+};
+
+std::unordered_map<VertexStreamKey, VertexStream, VertexStreamKeyHash> s_vertexStreams;
+std::vector<uint8> s_vertexStreamConvertBuffer;
+std::vector<uint32> s_vertexStreamDeallocateQueue;
+
+// returns false if the byte swaps of the layout cannot be expressed as a per-vertex permutation for the given stride
+bool _vertexStream_buildPermutation(VertexStream& stream, const LatteParsedFetchShaderBufferGroup_t& bufferGroup, uint32 stride)
+{
+	if (stride == 0)
+		return false;
+	std::vector<uint16>& vertexPermutation = stream.vertexPermutation;
+	vertexPermutation.resize(stride);
+	for (uint32 i = 0; i < stride; i++)
+		vertexPermutation[i] = (uint16)i;
+	for (sint32 i = 0; i < bufferGroup.attribCount; i++)
+	{
+		LatteParsedFetchShaderAttribute_t* attrib = bufferGroup.attrib + i;
+		if (attrib->endianSwap == LatteConst::VertexFetchEndianMode::SWAP_NONE)
+			continue;
+		uint32 swapSize = attrib->endianSwap == LatteConst::VertexFetchEndianMode::SWAP_U32 ? 4 : 2;
+		uint32 attribSize = LatteShaderRecompiler_getAttributeSize(attrib);
+		if ((attrib->offset + attribSize) > stride)
+			return false;
+		for (uint32 b = 0; b < attribSize; b++)
+			vertexPermutation[attrib->offset + b] = (uint16)(attrib->offset + (b & ~(swapSize - 1)) + (swapSize - 1 - (b & (swapSize - 1))));
+	}
+	if ((stride % 4) != 0)
+		return true;
+	// since stride is a multiple of 4 and swapped elements are aligned to their size, no element crosses a 16 byte chunk
+	uint32 period = stride * 16 / std::gcd(stride, 16u);
+	stream.shuffleMask.resize(period);
+	for (uint32 p = 0; p < period; p++)
+	{
+		uint32 vertexByte = p % stride;
+		uint32 srcIndex = p - vertexByte + vertexPermutation[vertexByte];
+		cemu_assert_debug((srcIndex & ~15) == (p & ~15));
+		stream.shuffleMask[p] = (uint8)(srcIndex & 15);
+	}
+	return true;
+}
+
+// converts bytes [begin, size)
+void _vertexStream_convertGeneric(const uint8* src, uint8* dst, uint32 begin, uint32 size, const uint16* vertexPermutation, uint32 stride)
+{
+	uint32 vertexByte = begin % stride;
+	uint32 vertexBase = begin - vertexByte;
+	for (uint32 i = begin; i < size; i++)
+	{
+		uint32 srcIndex = vertexBase + vertexPermutation[vertexByte];
+		dst[i] = srcIndex < size ? src[srcIndex] : 0;
+		vertexByte++;
+		if (vertexByte >= stride)
+		{
+			vertexByte = 0;
+			vertexBase += stride;
+		}
+	}
+}
+
+#if defined(ARCH_X86_64)
+ATTRIBUTE_SSE41
+void _vertexStream_convert_SSE41(const uint8* src, uint8* dst, uint32 size, const VertexStream& stream)
+{
+	const uint8* shuffleMask = stream.shuffleMask.data();
+	uint32 period = (uint32)stream.shuffleMask.size();
+	uint32 numChunks = size / 16;
+	uint32 maskIndex = 0;
+	for (uint32 i = 0; i < numChunks; i++)
+	{
+		__m128i data = _mm_loadu_si128((const __m128i*)(src + i * 16));
+		__m128i mask = _mm_loadu_si128((const __m128i*)(shuffleMask + maskIndex));
+		_mm_storeu_si128((__m128i*)(dst + i * 16), _mm_shuffle_epi8(data, mask));
+		maskIndex += 16;
+		if (maskIndex >= period)
+			maskIndex = 0;
+	}
+	_vertexStream_convertGeneric(src, dst, numChunks * 16, size, stream.vertexPermutation.data(), (uint32)stream.vertexPermutation.size());
+}
+#elif defined(__aarch64__)
+void _vertexStream_convert_NEON(const uint8* src, uint8* dst, uint32 size, const VertexStream& stream)
+{
+	const uint8* shuffleMask = stream.shuffleMask.data();
+	uint32 period = (uint32)stream.shuffleMask.size();
+	uint32 numChunks = size / 16;
+	uint32 maskIndex = 0;
+	for (uint32 i = 0; i < numChunks; i++)
+	{
+		uint8x16_t data = vld1q_u8(src + i * 16);
+		uint8x16_t mask = vld1q_u8(shuffleMask + maskIndex);
+		vst1q_u8(dst + i * 16, vqtbl1q_u8(data, mask));
+		maskIndex += 16;
+		if (maskIndex >= period)
+			maskIndex = 0;
+	}
+	_vertexStream_convertGeneric(src, dst, numChunks * 16, size, stream.vertexPermutation.data(), (uint32)stream.vertexPermutation.size());
+}
+#endif
+
+// release converted copies which are not used in the current frame
+// copies used by earlier drawcalls of this frame may still be referenced by commands which have not executed yet
+void _vertexStream_releaseUnused()
+{
+	for (auto& it : s_vertexStreams)
+	{
+		VertexStream& stream = it.second;
+		if (!stream.hasCacheAlloc || stream.lastUseFrame == LatteGPUState.frameCounter)
+			continue;
+		g_gpuBufferHeap->freeOffset(stream.cacheOffset);
+		stream.hasCacheAlloc = false;
+		stream.isConverted = false;
+	}
+}
+
+void _vertexStream_convert(VertexStream& stream, MPTR physAddress)
+{
+	uint32 size = stream.size;
+	uint32 allocSize = (size + 15) & ~15;
+	if (stream.hasCacheAlloc && stream.cacheAllocSize < allocSize)
+	{
+		s_vertexStreamDeallocateQueue.emplace_back(stream.cacheOffset); // release after current drawcall
+		stream.hasCacheAlloc = false;
+	}
+	if (!stream.hasCacheAlloc)
+	{
+		if (!g_gpuBufferHeap->allocOffset(allocSize, 256, stream.cacheOffset))
+		{
+			cemuLog_log(LogType::Force, "Out-of-memory in GPU buffer (trying to allocate converted vertex stream: {}KB) Cleaning up cache...", (allocSize + 1023) / 1024);
+			_vertexStream_releaseUnused();
+			BufferCacheNode::CleanupCacheAggressive(physAddress, physAddress + size);
+			if (!g_gpuBufferHeap->allocOffset(allocSize, 256, stream.cacheOffset))
+			{
+				cemuLog_log(LogType::Force, "Failed to free enough memory in GPU buffer");
+				cemu_assert(false);
+			}
+		}
+		stream.hasCacheAlloc = true;
+		stream.cacheAllocSize = allocSize;
+	}
+	if (s_vertexStreamConvertBuffer.size() < allocSize)
+		s_vertexStreamConvertBuffer.resize(allocSize);
+	const uint8* src = memory_getPointerFromPhysicalOffset(physAddress);
+	uint8* dst = s_vertexStreamConvertBuffer.data();
+#if defined(ARCH_X86_64)
+	if (!stream.shuffleMask.empty() && g_CPUFeatures.x86.sse4_1 && g_CPUFeatures.x86.ssse3)
+		_vertexStream_convert_SSE41(src, dst, size, stream);
+	else
+		_vertexStream_convertGeneric(src, dst, 0, size, stream.vertexPermutation.data(), (uint32)stream.vertexPermutation.size());
+#elif defined(__aarch64__)
+	if (!stream.shuffleMask.empty())
+		_vertexStream_convert_NEON(src, dst, size, stream);
+	else
+		_vertexStream_convertGeneric(src, dst, 0, size, stream.vertexPermutation.data(), (uint32)stream.vertexPermutation.size());
+#else
+	_vertexStream_convertGeneric(src, dst, 0, size, stream.vertexPermutation.data(), (uint32)stream.vertexPermutation.size());
+#endif
+	g_renderer->bufferCache_upload(dst, size, stream.cacheOffset);
+	stream.isConverted = true;
+	stream.convertedSize = size;
+}
+
+bool _vertexStream_hasStreamoutData(MPTR rangeBegin, MPTR rangeEnd)
+{
+	bool hasStreamoutData = false;
+	g_gpuBufferCache.forEachOverlapping(rangeBegin, rangeEnd, [&](BufferCacheNode* node, MPTR rangeBegin, MPTR rangeEnd)
+		{
+			hasStreamoutData |= node->HasStreamoutDataInRange(rangeBegin, rangeEnd);
+		}
+	);
+	return hasStreamoutData;
+}
+
+// returns true if the stream can be read in host endianness. Data written by streamout only exists in GPU memory and is never converted
+bool _vertexStream_isHostEndianEligible(const VertexStream& stream, MPTR physAddress)
+{
+	if (!stream.canConvert || (LatteGPUState.frameCounter - stream.lastChangeFrame) < VERTEX_STREAM_STABLE_FRAMES)
+		return false;
+	return !_vertexStream_hasStreamoutData(physAddress, physAddress + stream.size);
+}
+
+// returns the mask of vertex buffers for which the active vertex shader should expect host endian data
+// evaluated when the vertex shader is selected at the start of a draw pass. The command processor calls it again before each further drawcall of the pass and starts a new pass if a buffer of the active vertex shader no longer qualifies
+uint16 LatteBufferCache_getHostEndianVertexBufferMask(LatteFetchShader* fetchShader, uint32* contextRegister)
+{
+	if (!s_convertVertexStreams || !fetchShader)
+		return 0;
+	uint16 mask = 0;
+	for (auto& bufferGroup : fetchShader->bufferGroups)
+	{
+		if (!bufferGroup.canConvertToHostEndian)
+			continue;
+		uint32 bufferIndex = bufferGroup.attributeBufferIndex;
+		if (bufferIndex >= Latte::GPU_LIMITS::NUM_VERTEX_BUFFERS)
+			continue;
+		uint32 bufferBaseRegisterIndex = mmSQ_VTX_ATTRIBUTE_BLOCK_START + bufferIndex * 7;
+		MPTR bufferAddress = contextRegister[bufferBaseRegisterIndex + 0];
+		uint32 bufferStride = (contextRegister[bufferBaseRegisterIndex + 2] >> 11) & 0xFFFF;
+		if (bufferAddress == MPTR_NULL)
+			continue;
+		auto it = s_vertexStreams.find({ bufferAddress, bufferStride, bufferGroup.hostEndianLayoutKey });
+		if (it == s_vertexStreams.end())
+			continue;
+		if (!_vertexStream_isHostEndianEligible(it->second, bufferAddress))
+			continue;
+		mask |= (1 << bufferIndex);
+	}
+	return mask;
+}
+
+// same as LatteBufferCache_retrieveDataInCache() but also tracks modifications of the vertex stream
+// if useHostEndian is set the returned offset points to a copy of the data with the byte swaps of the buffer group layout applied
+uint32 LatteBufferCache_retrieveVertexStreamInCache(MPTR physAddress, uint32 size, const LatteParsedFetchShaderBufferGroup_t& bufferGroup, uint32 stride, bool useHostEndian)
+{
+	if (!s_convertVertexStreams)
+		return LatteBufferCache_retrieveDataInCache(physAddress, size);
+	auto it = s_vertexStreams.find({ physAddress, stride, bufferGroup.hostEndianLayoutKey });
+	if (it == s_vertexStreams.end())
+	{
+		it = s_vertexStreams.try_emplace({ physAddress, stride, bufferGroup.hostEndianLayoutKey }).first;
+		it->second.canConvert = _vertexStream_buildPermutation(it->second, bufferGroup, stride);
+		it->second.lastChangeFrame = LatteGPUState.frameCounter;
+	}
+	VertexStream& stream = it->second;
+	stream.size = std::max(stream.size, size);
+	stream.lastUseFrame = LatteGPUState.frameCounter;
+	auto range = LatteBufferCache_reserveRange(physAddress, stream.size);
+	range->flagInUse();
+	range->checkAndSyncModificationsIfChrononChanged(physAddress, stream.size);
+	uint64 sourceHash = range->GetPageHashSum(physAddress, physAddress + stream.size);
+	if (sourceHash != stream.sourceHash)
+	{
+		stream.sourceHash = sourceHash;
+		stream.lastChangeFrame = LatteGPUState.frameCounter;
+		stream.isConverted = false;
+	}
+	if (!useHostEndian)
+		return range->getBufferOffset(physAddress);
+	if (!_vertexStream_isHostEndianEligible(stream, physAddress))
+	{
+		// the pass is restarted before a drawcall if one of its host endian streams stops qualifying, so the only expected case is data which changed since the previous drawcall
+		// converting the current content is still correct for that. The following drawcall will select the byte swapping shader variant again
+		if (!stream.canConvert || _vertexStream_hasStreamoutData(physAddress, physAddress + stream.size))
+		{
+			cemuLog_logDebugOnce(LogType::Force, "Vertex stream at {:08x} with stride {} is bound for a host endian vertex shader but cannot be converted", physAddress, stride);
+			cemu_assert_debug(false);
+			return range->getBufferOffset(physAddress);
+		}
+	}
+	if (!stream.isConverted || stream.convertedSize < stream.size)
+		_vertexStream_convert(stream, physAddress);
+	return stream.cacheOffset;
+}
+
+void _vertexStream_cleanup()
+{
+	if (s_vertexStreams.empty())
+		return;
+	uint32 heapSize;
+	uint32 allocationSize;
+	uint32 allocNum;
+	g_gpuBufferHeap->getStats(heapSize, allocationSize, allocNum);
+	// converted copies only duplicate data, drop them early once the heap fills up
+	bool isHeapUnderPressure = allocationSize >= (heapSize * 3 / 4);
+	auto it = s_vertexStreams.begin();
+	while (it != s_vertexStreams.end())
+	{
+		VertexStream& stream = it->second;
+		uint32 frameAge = LatteGPUState.frameCounter - stream.lastUseFrame;
+		if (frameAge >= VERTEX_STREAM_MAX_FRAME_AGE || (isHeapUnderPressure && frameAge >= 2))
+		{
+			if (stream.hasCacheAlloc)
+				s_vertexStreamDeallocateQueue.emplace_back(stream.cacheOffset);
+			it = s_vertexStreams.erase(it);
+			continue;
+		}
+		++it;
+	}
+}
+
+void _vertexStream_processDeallocations()
+{
+	for (auto& itr : s_vertexStreamDeallocateQueue)
+		g_gpuBufferHeap->freeOffset(itr);
+	s_vertexStreamDeallocateQueue.clear();
+}
+
+void _vertexStream_unloadAll()
+{
+	for (auto& it : s_vertexStreams)
+	{
+		if (it.second.hasCacheAlloc)
+			g_gpuBufferHeap->freeOffset(it.second.cacheOffset);
+	}
+	s_vertexStreams.clear();
+	_vertexStream_processDeallocations();
+}
+
 void LatteBufferCache_processDeallocations()
 {
 	BufferCacheNode::ProcessDeallocations();
+	_vertexStream_processDeallocations();
 }
 
 void LatteBufferCache_init(size_t bufferSize)
@@ -989,10 +1386,12 @@ void LatteBufferCache_init(size_t bufferSize)
     cemu_assert_debug(g_gpuBufferCache.empty());
 	g_gpuBufferHeap.reset(new VHeap(nullptr, (uint32)bufferSize));
 	g_renderer->bufferCache_init((uint32)bufferSize);
+	s_convertVertexStreams = GetConfig().convert_vertex_streams;
 }
 
 void LatteBufferCache_UnloadAll()
 {
+	_vertexStream_unloadAll();
     BufferCacheNode::UnloadAll();
 }
 
@@ -1096,6 +1495,7 @@ void LatteBufferCache_notifySwapTVScanBuffer()
 {
 	if( ActiveSettings::FlushGPUCacheOnSwap() )
 		g_currentCacheChronon++;
+	_vertexStream_cleanup();
 }
 
 void LatteBufferCache_incrementalCleanup()
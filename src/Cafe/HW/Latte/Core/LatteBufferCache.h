@@ -1,9 +1,14 @@
 #pragma once
 
+struct LatteFetchShader;
+struct LatteParsedFetchShaderBufferGroup_t;
+
 void LatteBufferCache_init(size_t bufferSize);
 void LatteBufferCache_UnloadAll();
 
 uint32 LatteBufferCache_retrieveDataInCache(MPTR physAddress, uint32 size);
+uint32 LatteBufferCache_retrieveVertexStreamInCache(MPTR physAddress, uint32 size, const LatteParsedFetchShaderBufferGroup_t& bufferGroup, uint32 stride, bool useHostEndian);
+uint16 LatteBufferCache_getHostEndianVertexBufferMask(LatteFetchShader* fetchShader, uint32* contextRegister);
 void LatteBufferCache_copyStreamoutDataToCache(MPTR physAddress, uint32 size, uint32 streamoutBufferOffset);
 void LatteBufferCache_invalidate(MPTR physAddress, uint32 size);
 
@@ -169,6 +169,8 @@ bool LatteBufferCache_Sync(uint32 minIndex, uint32 maxIndex, uint32 baseInstance
 	LatteFetchShader* parsedFetchShader = LatteSHRC_GetActiveFetchShader();
 	if (!parsedFetchShader)
 		return false;
+	LatteDecompilerShader* vertexShader = LatteSHRC_GetActiveVertexShader();
+	uint16 hostEndianVertexBufferMask = vertexShader ? vertexShader->hostEndianVertexBufferMask : 0;
 	for (auto& bufferGroup : parsedFetchShader->bufferGroups)
 	{
 		uint32 bufferIndex = bufferGroup.attributeBufferIndex;
@@ -197,7 +199,8 @@ bool LatteBufferCache_Sync(uint32 minIndex, uint32 maxIndex, uint32 baseInstance
 
 
 #if BOOST_OS_MACOS
-		if(bufferStride % 4 != 0)
+		// the workaround is Vulkan specific. VulkanRenderer::GetInstance() does not check the type of g_renderer, which can also be the null renderer
+		if(bufferStride % 4 != 0 && g_renderer->GetType() == RendererAPI::Vulkan)
 		{
 			if (VulkanRenderer* vkRenderer = VulkanRenderer::GetInstance())
 			{
@@ -208,11 +211,14 @@ bool LatteBufferCache_Sync(uint32 minIndex, uint32 maxIndex, uint32 baseInstance
 		}
 #endif
 
-		uint32 bindOffset = LatteBufferCache_retrieveDataInCache(bufferAddress, fixedBufferSize);
+		uint32 bindOffset;
+		if (bufferGroup.canConvertToHostEndian)
+			bindOffset = LatteBufferCache_retrieveVertexStreamInCache(bufferAddress, fixedBufferSize, bufferGroup, bufferStride, ((hostEndianVertexBufferMask >> bufferIndex) & 1) != 0);
+		else
+			bindOffset = LatteBufferCache_retrieveDataInCache(bufferAddress, fixedBufferSize);
 		g_renderer->buffer_bindVertexBuffer(bufferIndex, bindOffset, fixedBufferSize);
 	}
 	// sync uniform buffers
-	LatteDecompilerShader* vertexShader = LatteSHRC_GetActiveVertexShader();
 	if (vertexShader)
 		LatteBufferCache_syncGPUUniformBuffers(vertexShader, mmSQ_VTX_UNIFORM_BLOCK_START, LatteConst::ShaderType::Vertex);
 	LatteDecompilerShader* geometryShader = LatteSHRC_GetActiveGeometryShader();
@@ -0,0 +1,631 @@
+#include "Cafe/HW/Latte/Core/LatteCapture.h"
+#include "Cafe/HW/Latte/Core/Latte.h"
+#include "Cafe/HW/Latte/Core/LattePM4.h"
+#include "Cafe/HW/MMU/MMU.h"
+#include "Cafe/OS/libs/TCL/TCL.h"
+#include "Cafe/CafeSystem.h"
+#include "Common/FileStream.h"
+#include "util/helpers/helpers.h"
+#include "util/highresolutiontimer/HighResolutionTimer.h"
+
+#include <zstd.h>
+
+void Latte_Start();
+void Latte_Stop();
+
+// file layout: uncompressed header (magic, version, title id, memory range table) followed by a single zstd stream of records
+// the file stores values in host byte order and is not meant to be portable between architectures
+static constexpr uint32 CAPTURE_MAGIC = 0x5041434C; // 'LCAP'
+static constexpr uint32 CAPTURE_VERSION = 1;
+static constexpr uint32 CAPTURE_PAGE_SIZE = 4096;
+static constexpr uint32 CAPTURE_MAX_IB_DEPTH = 4;
+
+enum class CaptureRecordType : uint8
+{
+	Registers = 1, // full GPU register state, only written once at the start
+	Memory = 2, // guest memory contents: address, size, data
+	RingWords = 3, // command words written to the ring buffer: count, words
+	Frame = 4, // a frame boundary (swap request) was submitted
+	End = 5,
+};
+
+class CaptureFileWriter
+{
+public:
+	CaptureFileWriter(FileStream* file) : m_file(file)
+	{
+		m_cctx = ZSTD_createCCtx();
+		ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_compressionLevel, 3);
+		m_outBuffer.resize(ZSTD_CStreamOutSize());
+	}
+
+	~CaptureFileWriter()
+	{
+		ZSTD_freeCCtx(m_cctx);
+		delete m_file;
+	}
+
+	void WriteRaw(const void* data, uint32 size)
+	{
+		m_file->writeData(data, size);
+	}
+
+	void Write(const void* data, size_t size)
+	{
+		m_uncompressedSize += size;
+		ZSTD_inBuffer input{ data, size, 0 };
+		while (input.pos < input.size)
+			Compress(input, ZSTD_e_continue);
+	}
+
+	template<typename T>
+	void Write(const T& v)
+	{
+		Write(&v, sizeof(T));
+	}
+
+	void Finish()
+	{
+		ZSTD_inBuffer input{ nullptr, 0, 0 };
+		while (Compress(input, ZSTD_e_end) != 0);
+	}
+
+	uint64 GetUncompressedSize() const { return m_uncompressedSize; }
+
+private:
+	size_t Compress(ZSTD_inBuffer& input, ZSTD_EndDirective mode)
+	{
+		ZSTD_outBuffer output{ m_outBuffer.data(), m_outBuffer.size(), 0 };
+		size_t remaining = ZSTD_compressStream2(m_cctx, &output, &input, mode);
+		cemu_assert(!ZSTD_isError(remaining));
+		if (output.pos > 0)
+			m_file->writeData(m_outBuffer.data(), (sint32)output.pos);
+		return remaining;
+	}
+
+	FileStream* m_file;
+	ZSTD_CCtx* m_cctx;
+	std::vector<uint8> m_outBuffer;
+	uint64 m_uncompressedSize{};
+};
+
+class CaptureFileReader
+{
+public:
+	CaptureFileReader(FileStream* file) : m_file(file)
+	{
+		m_dctx = ZSTD_createDCtx();
+		m_inBuffer.resize(ZSTD_DStreamInSize());
+	}
+
+	~CaptureFileReader()
+	{
+		ZSTD_freeDCtx(m_dctx);
+		delete m_file;
+	}
+
+	bool ReadRaw(void* data, uint32 size)
+	{
+		return m_file->readData(data, size) == size;
+	}
+
+	bool Read(void* data, size_t size)
+	{
+		ZSTD_outBuffer output{ data, size, 0 };
+		while (output.pos < output.size)
+		{
+			if (m_input.pos == m_input.size)
+			{
+				uint32 bytesRead = m_file->readData(m_inBuffer.data(), (uint32)m_inBuffer.size());
+				if (bytesRead == 0)
+					return false;
+				m_input = { m_inBuffer.data(), bytesRead, 0 };
+			}
+			size_t r = ZSTD_decompressStream(m_dctx, &output, &m_input);
+			if (ZSTD_isError(r))
+				return false;
+		}
+		return true;
+	}
+
+	template<typename T>
+	bool Read(T& v)
+	{
+		return Read(&v, sizeof(T));
+	}
+
+private:
+	FileStream* m_file;
+	ZSTD_DCtx* m_dctx;
+	std::vector<uint8> m_inBuffer;
+	ZSTD_inBuffer m_input{ nullptr, 0, 0 };
+};
+
+/* Capture */
+
+enum class CaptureState
+{
+	Off,
+	StartPending,
+	Recording,
+	StopPending,
+};
+
+struct CapturedMemoryRange
+{
+	MPTR base;
+	uint32 size;
+	std::vector<uint64> pageHashes;
+};
+
+std::mutex s_captureMutex;
+std::atomic<CaptureState> s_captureState{ CaptureState::Off };
+fs::path s_capturePendingPath;
+
+struct
+{
+	CaptureFileWriter* writer{};
+	std::vector<CapturedMemoryRange> ranges;
+	bool frameBoundaryPending{};
+	uint32 numFrames{};
+	uint64 numRingWords{};
+}s_capture;
+
+static bool _CaptureIsMemoryRangeIncluded(MMURange* range)
+{
+	if (!range->isMapped())
+		return false;
+	switch (range->areaId)
+	{
+	case MMU_MEM_AREA_ID::CODE_TRAMPOLINE:
+	case MMU_MEM_AREA_ID::CODE_CAVE:
+	case MMU_MEM_AREA_ID::CPU_LC0:
+	case MMU_MEM_AREA_ID::CPU_LC1:
+	case MMU_MEM_AREA_ID::CPU_LC2:
+	case MMU_MEM_AREA_ID::CPU_PER_CORE:
+		return false; // never accessed by the GPU
+	default:
+		return true;
+	}
+}
+
+static uint64 _CaptureHashPage(const uint8* mem)
+{
+	static const uint64 k0 = 0x55F23EAD;
+	static const uint64 k1 = 0x185FDC6D;
+	static const uint64 k2 = 0xF7431F49;
+	static const uint64 k3 = 0xA4C7AE9D;
+
+	const uint64* ptr = (const uint64*)mem;
+	const uint64* end = ptr + (CAPTURE_PAGE_SIZE / sizeof(uint64));
+	uint64 h0 = 0;
+	uint64 h1 = 0;
+	uint64 h2 = 0;
+	uint64 h3 = 0;
+	while (ptr < end)
+	{
+		h0 = std::rotr(h0, 7);
+		h1 = std::rotr(h1, 7);
+		h2 = std::rotr(h2, 7);
+		h3 = std::rotr(h3, 7);
+		h0 += ptr[0] * k0;
+		h1 += ptr[1] * k1;
+		h2 += ptr[2] * k2;
+		h3 += ptr[3] * k3;
+		ptr += 4;
+	}
+	return h0 + h1 + h2 + h3;
+}
+
+static void _CaptureWriteMemory(MPTR address, uint32 size)
+{
+	s_capture.writer->Write(CaptureRecordType::Memory);
+	s_capture.writer->Write<uint32>(address);
+	s_capture.writer->Write<uint32>(size);
+	s_capture.writer->Write(memory_getPointerFromVirtualOffset(address), size);
+}
+
+static void _CaptureWriteRegisters()
+{
+	s_capture.writer->Write(CaptureRecordType::Registers);
+	s_capture.writer->Write(LatteGPUState.contextRegister, sizeof(LatteGPUState.contextRegister));
+	s_capture.writer->Write(LatteGPUState.contextRegisterShadowAddr, sizeof(LatteGPUState.contextRegisterShadowAddr));
+	s_capture.writer->Write<uint32>(LatteGPUState.contextControl0);
+	s_capture.writer->Write<uint32>(LatteGPUState.contextControl1);
+	s_capture.writer->Write<uint32>(LatteGPUState.drawContext.numInstances);
+}
+
+// write all pages which changed since the last call
+static void _CaptureWriteMemoryDelta()
+{
+	for (auto& range : s_capture.ranges)
+	{
+		const uint8* basePtr = memory_base + range.base;
+		const uint32 numPages = range.size / CAPTURE_PAGE_SIZE;
+		uint32 runStart = 0;
+		uint32 runLength = 0;
+		for (uint32 p = 0; p < numPages; p++)
+		{
+			uint64 h = _CaptureHashPage(basePtr + p * CAPTURE_PAGE_SIZE);
+			if (h != range.pageHashes[p])
+			{
+				range.pageHashes[p] = h;
+				if (runLength == 0)
+					runStart = p;
+				runLength++;
+				continue;
+			}
+			if (runLength > 0)
+			{
+				_CaptureWriteMemory(range.base + runStart * CAPTURE_PAGE_SIZE, runLength * CAPTURE_PAGE_SIZE);
+				runLength = 0;
+			}
+		}
+		if (runLength > 0)
+			_CaptureWriteMemory(range.base + runStart * CAPTURE_PAGE_SIZE, runLength * CAPTURE_PAGE_SIZE);
+	}
+}
+
+// indirect buffers are stored by value so that the replayed command stream matches exactly what the GPU processed
+// also detects frame boundaries
+static void _CaptureScanCommands(uint32be* cmd, uint32 numWords, uint32 depth)
+{
+	uint32be* cmdEnd = cmd + numWords;
+	while (cmd < cmdEnd)
+	{
+		uint32 itHeader = *cmd;
+		cmd++;
+		uint32 itHeaderType = (itHeader >> 30) & 3;
+		if (itHeaderType == 3)
+		{
+			uint32 itCode = (itHeader >> 8) & 0xFF;
+			uint32 nWords = ((itHeader >> 16) & 0x3FFF) + 1;
+			if (cmd + nWords > cmdEnd)
+				break;
+			if (itCode == IT_INDIRECT_BUFFER_PRIV && nWords == 3)
+			{
+				MPTR bufferAddr = cmd[0];
+				uint32 sizeInU32s = cmd[2];
+				if (sizeInU32s > 0 && memory_isAddressRangeAccessible(bufferAddr, sizeInU32s * 4))
+				{
+					_CaptureWriteMemory(bufferAddr, sizeInU32s * 4);
+					if (depth < CAPTURE_MAX_IB_DEPTH)
+						_CaptureScanCommands(MEMPTR<uint32be>(bufferAddr).GetPtr(), sizeInU32s, depth + 1);
+				}
+			}
+			else if (itCode == IT_HLE_REQUEST_SWAP_BUFFERS)
+				s_capture.frameBoundaryPending = true;
+			cmd += nWords;
+		}
+		else if (itHeaderType == 0)
+			cmd += ((itHeader >> 16) & 0x3FFF) + 1;
+		else if (itHeaderType != 2) // type 2 is a single word filler packet
+			break;
+	}
+}
+
+static void _CaptureStart(const fs::path& path)
+{
+	// the register snapshot has to match the state right before the first captured command
+	// so we wait until the GPU has processed everything that was submitted so far
+	TCL::TCLWaitForGPUIdle();
+
+	std::error_code ec;
+	fs::create_directories(path.parent_path(), ec);
+	FileStream* file = FileStream::createFile2(path);
+	if (!file)
+	{
+		cemuLog_log(LogType::Force, "GPU capture: Unable to create file {}", _pathToUtf8(path));
+		s_captureState = CaptureState::Off;
+		return;
+	}
+	s_capture.writer = new CaptureFileWriter(file);
+	s_capture.frameBoundaryPending = false;
+	s_capture.numFrames = 0;
+	s_capture.numRingWords = 0;
+	s_capture.ranges.clear();
+	for (auto& itr : memory_getMMURanges())
+	{
+		if (!_CaptureIsMemoryRangeIncluded(itr))
+			continue;
+		auto& range = s_capture.ranges.emplace_back();
+		range.base = itr->getBase();
+		range.size = itr->getSize();
+		range.pageHashes.resize(range.size / CAPTURE_PAGE_SIZE);
+	}
+	// header
+	uint32 header[2] = { CAPTURE_MAGIC, CAPTURE_VERSION };
+	uint64 titleId = CafeSystem::GetForegroundTitleId();
+	uint32 rangeCount = (uint32)s_capture.ranges.size();
+	s_capture.writer->WriteRaw(header, sizeof(header));
+	s_capture.writer->WriteRaw(&titleId, sizeof(titleId));
+	s_capture.writer->WriteRaw(&rangeCount, sizeof(rangeCount));
+	for (auto& range : s_capture.ranges)
+	{
+		uint32 rangeInfo[2] = { range.base, range.size };
+		s_capture.writer->WriteRaw(rangeInfo, sizeof(rangeInfo));
+	}
+	// initial state. Since all page hashes start out as zero this writes the full memory snapshot
+	_CaptureWriteRegisters();
+	_CaptureWriteMemoryDelta();
+	s_captureState = CaptureState::Recording;
+	cemuLog_log(LogType::Force, "GPU capture: Started recording to {}", _pathToUtf8(path));
+}
+
+static void _CaptureFinish()
+{
+	if (s_capture.writer)
+	{
+		s_capture.writer->Write(CaptureRecordType::End);
+		s_capture.writer->Finish();
+		cemuLog_log(LogType::Force, "GPU capture: Finished recording. {} frames, {} command words, {}MB uncompressed", s_capture.numFrames, s_capture.numRingWords, s_capture.writer->GetUncompressedSize() / 1024 / 1024);
+		delete s_capture.writer;
+		s_capture.writer = nullptr;
+	}
+	s_capture.ranges.clear();
+	s_captureState = CaptureState::Off;
+}
+
+void LatteCapture_RequestStart(const fs::path& path)
+{
+	std::unique_lock _l(s_captureMutex);
+	if (s_captureState != CaptureState::Off)
+		return;
+	s_capturePendingPath = path;
+	s_captureState = CaptureState::StartPending;
+}
+
+void LatteCapture_RequestStop()
+{
+	std::unique_lock _l(s_captureMutex);
+	if (s_captureState == CaptureState::StartPending)
+		s_captureState = CaptureState::Off;
+	else if (s_captureState == CaptureState::Recording)
+		s_captureState = CaptureState::StopPending;
+}
+
+void LatteCapture_Shutdown()
+{
+	std::unique_lock _l(s_captureMutex);
+	_CaptureFinish();
+}
+
+bool LatteCapture_IsRecording()
+{
+	return s_captureState.load() != CaptureState::Off;
+}
+
+bool LatteCapture_IsEnabled()
+{
+	return s_captureState.load(std::memory_order_relaxed) != CaptureState::Off;
+}
+
+void LatteCapture_BeginSubmission(uint32be* cmd, uint32 cmdLen)
+{
+	std::unique_lock _l(s_captureMutex);
+	if (s_captureState == CaptureState::StartPending)
+		_CaptureStart(s_capturePendingPath);
+	else if (s_captureState == CaptureState::StopPending)
+		_CaptureFinish();
+	if (s_captureState != CaptureState::Recording)
+		return;
+	// guest memory is only compared at frame granularity, hashing all of it on every submission would be too slow
+	if (s_capture.frameBoundaryPending)
+	{
+		s_capture.writer->Write(CaptureRecordType::Frame);
+		_CaptureWriteMemoryDelta();
+		s_capture.frameBoundaryPending = false;
+		s_capture.numFrames++;
+	}
+	_CaptureScanCommands(cmd, cmdLen, 0);
+}
+
+void LatteCapture_RecordRingWords(uint32be* cmd, uint32 cmdLen)
+{
+	std::unique_lock _l(s_captureMutex);
+	if (s_captureState != CaptureState::Recording)
+		return;
+	s_capture.writer->Write(CaptureRecordType::RingWords);
+	s_capture.writer->Write<uint32>(cmdLen);
+	s_capture.writer->Write(cmd, cmdLen * sizeof(uint32be));
+	s_capture.numRingWords += cmdLen;
+}
+
+/* Replay */
+
+struct
+{
+	CaptureFileReader* reader{};
+	std::thread feederThread;
+	std::atomic_bool isActive{};
+	std::atomic_bool stopRequested{};
+	CaptureRecordType nextRecordType{};
+	// initial register state, applied by the GPU thread
+	std::vector<uint32> registers;
+	std::vector<MPTR> registerShadowAddr;
+	uint32 contextControl0{};
+	uint32 contextControl1{};
+	uint32 numInstances{};
+}s_replay;
+
+static bool _ReplayReadMemoryRecord()
+{
+	uint32 address, size;
+	if (!s_replay.reader->Read(address) || !s_replay.reader->Read(size))
+		return false;
+	if (!memory_isAddressRangeAccessible(address, size))
+	{
+		cemuLog_log(LogType::Force, "GPU capture replay: Memory record {:08x}-{:08x} is outside of the mapped ranges", address, address + size);
+		return false;
+	}
+	return s_replay.reader->Read(memory_getPointerFromVirtualOffset(address), size);
+}
+
+static bool _ReplayReadRegisters()
+{
+	s_replay.registers.resize(LATTE_MAX_REGISTER);
+	s_replay.registerShadowAddr.resize(LATTE_MAX_REGISTER);
+	return s_replay.reader->Read(s_replay.registers.data(), s_replay.registers.size() * sizeof(uint32)) &&
+		s_replay.reader->Read(s_replay.registerShadowAddr.data(), s_replay.registerShadowAddr.size() * sizeof(MPTR)) &&
+		s_replay.reader->Read(s_replay.contextControl0) &&
+		s_replay.reader->Read(s_replay.contextControl1) &&
+		s_replay.reader->Read(s_replay.numInstances);
+}
+
+static bool _ReplayMapMemoryRanges()
+{
+	uint32 rangeCount;
+	if (!s_replay.reader->ReadRaw(&rangeCount, sizeof(rangeCount)))
+		return false;
+	for (uint32 i = 0; i < rangeCount; i++)
+	{
+		uint32 rangeInfo[2];
+		if (!s_replay.reader->ReadRaw(rangeInfo, sizeof(rangeInfo)))
+			return false;
+		MMURange* range = memory_getMMURangeByAddress(rangeInfo[0]);
+		if (!range || range->getBase() != rangeInfo[0])
+		{
+			cemuLog_log(LogType::Force, "GPU capture replay: Unknown memory range at {:08x}", rangeInfo[0]);
+			return false;
+		}
+		if (!range->isMapped())
+		{
+			range->setEnd(rangeInfo[0] + rangeInfo[1]);
+			range->mapMem();
+		}
+		else if (range->getSize() < rangeInfo[1])
+		{
+			cemuLog_log(LogType::Force, "GPU capture replay: Memory range {} is already mapped with a smaller size", range->getName());
+			return false;
+		}
+	}
+	return true;
+}
+
+static void _ReplayFeederThread()
+{
+	SetThreadName("LatteReplay");
+	HRTick startTick = HighResolutionTimer::now().getTick();
+	uint32 numFrames = 0;
+	std::vector<uint32be> words;
+	CaptureRecordType recordType = s_replay.nextRecordType;
+	bool isComplete = false;
+	while (!s_replay.stopRequested)
+	{
+		if (recordType == CaptureRecordType::RingWords)
+		{
+			uint32 count;
+			if (!s_replay.reader->Read(count))
+				break;
+			words.resize(count);
+			if (!s_replay.reader->Read(words.data(), count * sizeof(uint32be)))
+				break;
+			TCL::TCLReplaySubmit(words.data(), count);
+		}
+		else if (recordType == CaptureRecordType::Memory)
+		{
+			// the GPU has to be done with all prior commands before the memory they referenced can be updated
+			TCL::TCLWaitForGPUDrained();
+			if (!_ReplayReadMemoryRecord())
+				break;
+		}
+		else if (recordType == CaptureRecordType::Frame)
+		{
+			numFrames++;
+		}
+		else if (recordType == CaptureRecordType::End)
+		{
+			isComplete = true;
+			break;
+		}
+		else
+		{
+			cemuLog_log(LogType::Force, "GPU capture replay: Unexpected record type {}", (uint32)recordType);
+			break;
+		}
+		if (!s_replay.reader->Read(recordType))
+			break;
+	}
+	if (s_replay.stopRequested)
+		return;
+	if (!isComplete)
+		cemuLog_log(LogType::Force, "GPU capture replay: File is truncated or corrupted");
+	TCL::TCLWaitForGPUDrained();
+	double elapsedMs = HighResolutionTimer::getTimeDiff(startTick, HighResolutionTimer::now().getTick()) * 1000.0;
+	cemuLog_log(LogType::Force, "GPU capture replay: Finished {} frames in {:.1f}ms ({:.2f}ms per frame)", numFrames, elapsedMs, numFrames > 0 ? elapsedMs / numFrames : 0.0);
+}
+
+bool LatteReplay_Start(const fs::path& path)
+{
+	cemu_assert_debug(!s_replay.isActive);
+	FileStream* file = FileStream::openFile2(path);
+	if (!file)
+	{
+		cemuLog_log(LogType::Force, "GPU capture replay: Unable to open {}", _pathToUtf8(path));
+		return false;
+	}
+	s_replay.reader = new CaptureFileReader(file);
+	uint32 header[2];
+	uint64 titleId;
+	if (!s_replay.reader->ReadRaw(header, sizeof(header)) || header[0] != CAPTURE_MAGIC || header[1] != CAPTURE_VERSION ||
+		!s_replay.reader->ReadRaw(&titleId, sizeof(titleId)) || !_ReplayMapMemoryRanges())
+	{
+		cemuLog_log(LogType::Force, "GPU capture replay: {} is not a valid capture file", _pathToUtf8(path));
+		delete s_replay.reader;
+		s_replay.reader = nullptr;
+		return false;
+	}
+	// initial state
+	CaptureRecordType recordType;
+	bool isValid = s_replay.reader->Read(recordType) && recordType == CaptureRecordType::Registers && _ReplayReadRegisters();
+	while (isValid)
+	{
+		isValid = s_replay.reader->Read(recordType);
+		if (!isValid || recordType != CaptureRecordType::Memory)
+			break;
+		isValid = _ReplayReadMemoryRecord();
+	}
+	if (!isValid)
+	{
+		cemuLog_log(LogType::Force, "GPU capture replay: Failed to read initial state from {}", _pathToUtf8(path));
+		delete s_replay.reader;
+		s_replay.reader = nullptr;
+		return false;
+	}
+	s_replay.nextRecordType = recordType;
+	cemuLog_log(LogType::Force, "GPU capture replay: Replaying {} (title {:016x})", _pathToUtf8(path), titleId);
+	s_replay.isActive = true;
+	s_replay.stopRequested = false;
+	Latte_Start();
+	s_replay.feederThread = std::thread(_ReplayFeederThread);
+	return true;
+}
+
+void LatteReplay_Stop()
+{
+	if (!s_replay.isActive)
+		return;
+	s_replay.stopRequested = true;
+	if (s_replay.feederThread.joinable())
+		s_replay.feederThread.join();
+	Latte_Stop();
+	delete s_replay.reader;
+	s_replay.reader = nullptr;
+	s_replay.isActive = false;
+}
+
+bool LatteReplay_IsActive()
+{
+	return s_replay.isActive;
+}
+
+void LatteReplay_LoadInitialState()
+{
+	std::copy(s_replay.registers.begin(), s_replay.registers.end(), LatteGPUState.contextRegister);
+	std::copy(s_replay.registerShadowAddr.begin(), s_replay.registerShadowAddr.end(), LatteGPUState.contextRegisterShadowAddr);
+	LatteReg_markAllWritten();
+	LatteGPUState.contextControl0 = s_replay.contextControl0;
+	LatteGPUState.contextControl1 = s_replay.contextControl1;
+	LatteGPUState.drawContext.numInstances = s_replay.numInstances;
+	LatteGPUState.isCaptureReplay = true;
+}
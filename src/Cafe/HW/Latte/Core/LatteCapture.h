@@ -0,0 +1,22 @@
+#pragma once
+
+// GPU command stream capture
+// records all command words submitted to the ring buffer together with the guest memory and register state they depend on
+// the resulting file can be replayed without running any PPC code, see LatteReplay_*
+void LatteCapture_RequestStart(const fs::path& path); // capture begins with the next ring buffer submission
+void LatteCapture_RequestStop();
+void LatteCapture_Shutdown(); // finish and close the capture file immediately. Only call when no PPC thread is running
+bool LatteCapture_IsRecording();
+
+// called from TCL
+bool LatteCapture_IsEnabled();
+void LatteCapture_BeginSubmission(uint32be* cmd, uint32 cmdLen);
+void LatteCapture_RecordRingWords(uint32be* cmd, uint32 cmdLen);
+
+// GPU command stream replay
+bool LatteReplay_Start(const fs::path& path);
+void LatteReplay_Stop();
+bool LatteReplay_IsActive();
+
+// called from the GPU thread before it starts processing the ring buffer
+void LatteReplay_LoadInitialState();
@@ -73,6 +73,9 @@ public:
 		}
 		*/
 
+		if (!m_isFirstDraw)
+			revalidateHostEndianVertexBuffers();
+
 		if (!isAutoIndex)
 		{
 			cemu_assert_debug(physIndices != MPTR_NULL);
@@ -99,6 +102,20 @@ public:
 		m_drawPassActive = false;
 	}
 
+	// the vertex shader decides which vertex buffers it reads in host endianness when it is selected at the start of the pass
+	// if any of those buffers no longer qualifies (rebound, overwritten by streamout or modified) start a new pass so the shader is selected again
+	void revalidateHostEndianVertexBuffers()
+	{
+		LatteDecompilerShader* vertexShader = LatteSHRC_GetActiveVertexShader();
+		if (!vertexShader || vertexShader->hostEndianVertexBufferMask == 0)
+			return;
+		uint16 currentMask = LatteBufferCache_getHostEndianVertexBufferMask(LatteSHRC_GetActiveFetchShader(), LatteGPUState.contextRegister);
+		if ((vertexShader->hostEndianVertexBufferMask & ~currentMask) == 0)
+			return;
+		endDrawPass();
+		beginDrawPass();
+	}
+
 	void notifyModifiedVertexBuffer() 
 	{
 		m_vertexBufferChanged = true;
@@ -145,40 +162,52 @@ void LatteCP_signalEnterWait()
 	LatteIndices_invalidateAll();
 }
 
+// called when the ring buffer is empty
+// handles pending tasks and then waits until new commands are submitted. Sleeps at most until the next virtual vsync is due
+void LatteCP_waitForRingbufferData()
+{
+	g_renderer->NotifyLatteCommandProcessorIdle(); // let the renderer know in case it wants to flush any commands
+	performanceMonitor.gpuTime_idleTime.beginMeasuring();
+	LatteThread_HandleOSScreen(); // check if new frame was presented via OSScreen API
+	if (Latte_GetStopSignal())
+		LatteThread_Exit();
+	LatteTiming_HandleTimedVsync();
+	LatteAsyncCommands_checkAndExecute();
+	// OSScreen and async commands are polled, so don't sleep for too long
+	uint32 timeoutUs = 1000;
+	HRTick currentTick = HighResolutionTimer::now().getTick();
+	if (LatteGPUState.timer_nextVSync <= currentTick)
+		timeoutUs = 0;
+	else
+		timeoutUs = (uint32)std::min<uint64>(timeoutUs, HighResolutionTimer::ticksToMicroseconds(LatteGPUState.timer_nextVSync - currentTick));
+	TCL::TCLGPUWaitForRBData(timeoutUs);
+	performanceMonitor.gpuTime_idleTime.endMeasuring();
+}
+
 /*
 * Read a U32 from the command buffer
-* If no data is available then wait in a busy loop
+* If no data is available then wait until new commands are submitted
 */
 uint32 LatteCP_readU32Deprc()
 {
-	// no display list active
+	uint32be cmdWord;
+	while (TCL::TCLGPUReadRBWords(&cmdWord, 1) == 0)
+		LatteCP_waitForRingbufferData();
+	return cmdWord;
+}
+
+// read a span of words from the command buffer. Words are kept in guest byte order
+void LatteCP_readSpan(uint32be* cmdWords, uint32 numWords)
+{
 	while (true)
 	{
-		uint32 cmdWord;
-		if ( TCL::TCLGPUReadRBWord(cmdWord) )
-			return cmdWord;
-
-		g_renderer->NotifyLatteCommandProcessorIdle(); // let the renderer know in case it wants to flush any commands
-		performanceMonitor.gpuTime_idleTime.beginMeasuring();
-		// no command data available, spin in a busy loop for a bit then check again
-		for (sint32 busy = 0; busy < 80; busy++)
-		{
-			_mm_pause();
-		}
-		LatteThread_HandleOSScreen(); // check if new frame was presented via OSScreen API
-
-		if ( TCL::TCLGPUReadRBWord(cmdWord) )
-			return cmdWord;
-		if (Latte_GetStopSignal())
-			LatteThread_Exit();
-
-		// still no command data available, do some other tasks
-		LatteTiming_HandleTimedVsync();
-		LatteAsyncCommands_checkAndExecute();
-		std::this_thread::yield();
-		performanceMonitor.gpuTime_idleTime.endMeasuring();
+		uint32 wordsRead = TCL::TCLGPUReadRBWords(cmdWords, numWords);
+		cmdWords += wordsRead;
+		numWords -= wordsRead;
+		if (numWords == 0)
+			break;
+		LatteCP_waitForRingbufferData();
 	}
-	UNREACHABLE;
 }
 
 template<uint32 readU32()>
@@ -267,6 +296,7 @@ LatteCMDPtr LatteCP_itStreamoutBufferUpdate(LatteCMDPtr cmd, uint32 nWords)
 		MPTR virtualAddress = memory_physicalToVirtual(physicalAddressRead);
 		uint32 bufferOffset = 0;
 		LatteGPUState.contextRegister[mmVGT_STRMOUT_BUFFER_OFFSET_0 + 4 * soIndex] = bufferOffset;
+		LatteReg_markWritten(mmVGT_STRMOUT_BUFFER_OFFSET_0 + 4 * soIndex, mmVGT_STRMOUT_BUFFER_OFFSET_0 + 4 * soIndex + 1);
 	}
 	else if (mode == 3)
 	{
@@ -293,6 +323,7 @@ void LatteCP_itSetRegistersGeneric_handleSpecialRanges(uint32 registerStartIndex
 			{
 				LatteGPUState.contextRegister[mmSQ_VTX_SEMANTIC_0 + i] = 0xFF;
 			}
+			LatteReg_markWritten(mmSQ_VTX_SEMANTIC_0, mmSQ_VTX_SEMANTIC_0 + 32);
 		}
 	}
 }
@@ -335,6 +366,7 @@ LatteCMDPtr LatteCP_itSetRegistersGeneric(LatteCMDPtr cmd, uint32 nWords)
 	}
 	// some register writes trigger special behavior
 	LatteCP_itSetRegistersGeneric_handleSpecialRanges<TRegisterBase>(registerStartIndex, registerEndIndex);
+	LatteReg_markWritten(registerStartIndex, registerEndIndex);
 	return cmd;
 }
 
@@ -378,6 +410,7 @@ LatteCMDPtr LatteCP_itSetRegistersGeneric(LatteCMDPtr cmd, uint32 nWords, TRegRa
 	}
 	// some register writes trigger special behavior
 	LatteCP_itSetRegistersGeneric_handleSpecialRanges<TRegisterBase>(registerStartIndex, registerEndIndex);
+	LatteReg_markWritten(registerStartIndex, registerEndIndex);
 	return cmd;
 }
 
@@ -385,6 +418,7 @@ LatteCMDPtr LatteCP_itIndexType(LatteCMDPtr cmd, uint32 nWords)
 {
 	cemu_assert_debug(nWords == 1);
 	LatteGPUState.contextNew.VGT_DMA_INDEX_TYPE.set_INDEX_TYPE((Latte::LATTE_VGT_DMA_INDEX_TYPE::E_INDEX_TYPE)LatteReadCMD());
+	LatteReg_markWritten(Latte::REGADDR::VGT_DMA_INDEX_TYPE, Latte::REGADDR::VGT_DMA_INDEX_TYPE + 1);
 	return cmd;
 }
 
@@ -422,6 +456,9 @@ LatteCMDPtr LatteCP_itWaitRegMem(LatteCMDPtr cmd, uint32 nWords)
 	const uint32 GPU7_WAIT_MEM_OP_GREATER = 6;
 	const uint32 GPU7_WAIT_MEM_OP_NEVER = 7;
 
+	// the guest may be waiting for texture readbacks from earlier commands, they have to be visible in memory before the fence is polled
+	LatteTextureReadback_WaitForMemoryWrites();
+
 	LatteCP_signalEnterWait();
 
 	bool stalls = false;
@@ -474,6 +511,8 @@ LatteCMDPtr LatteCP_itWaitRegMem(LatteCMDPtr cmd, uint32 nWords)
 			}
 			else
 				assert_dbg();
+			if (LatteGPUState.isCaptureReplay)
+				break; // the fence value would be written by the CPU which doesn't run during replay
 			if (!stalls)
 			{
 				g_renderer->NotifyLatteCommandProcessorIdle();
@@ -545,6 +584,9 @@ LatteCMDPtr LatteCP_itEventWriteEOP(LatteCMDPtr cmd, uint32 nWords)
 
 	cemu_assert_debug(word2 == 0x40000000 || word2 == 0x42000000);
 
+	// readbacks finished before this point are written to guest memory by a separate thread, complete them before the timestamp is retired
+	LatteTextureReadback_WaitForMemoryWrites();
+
 	if (word0 == 0x504 && (word2&0x40000000)) // todo - figure out the flags
 	{
 		stdx::atomic_ref<uint64be> atomicRef(*(uint64be*)memory_getPointerFromPhysicalOffset(word1));
@@ -559,7 +601,8 @@ LatteCMDPtr LatteCP_itEventWriteEOP(LatteCMDPtr cmd, uint32 nWords)
 	{
 		// todo - timestamp interrupt
 	}
-	TCL::TCLGPUNotifyNewRetirementTimestamp();
+	if (!LatteGPUState.isCaptureReplay)
+		TCL::TCLGPUNotifyNewRetirementTimestamp();
 	return cmd;
 }
 
@@ -588,6 +631,8 @@ LatteCMDPtr LatteCP_itMemSemaphore(LatteCMDPtr cmd, uint32 nWords)
 			uint64le oldVal = semaphoreData->load();
 			if (oldVal == 0)
 			{
+				if (LatteGPUState.isCaptureReplay)
+					break; // the CPU side which would signal the semaphore doesn't run during replay
 				loopCount++;
 				if (loopCount > 2000)
 					std::this_thread::yield();
@@ -631,6 +676,7 @@ LatteCMDPtr LatteCP_itLoadReg(LatteCMDPtr cmd, uint32 nWords, uint32 regBase)
 		uint32 regCount = LatteReadCMD();
 		cemu_assert_debug(regCount != 0);
 		uint32 regAddr = regBase + regOffset;
+		LatteReg_markWritten(regAddr, regAddr + regCount);
 		for (uint32 f = 0; f < regCount; f++)
 		{
 			LatteGPUState.contextRegisterShadowAddr[regAddr] = regShadowMemAddr;
@@ -919,6 +965,8 @@ LatteCMDPtr LatteCP_itHLEWaitForFlip(LatteCMDPtr cmd, uint32 nWords)
 	catchOpenGLError();
 	cemu_assert_debug(nWords == 1);
 	MPTR reserved1 = LatteReadCMD(); // reserved
+	if (LatteGPUState.isCaptureReplay)
+		return cmd; // flips are driven by GX2 vsync handling which is inactive during replay
 	// wait for flip
 	uint32 currentFlipCount = LatteGPUState.flipCounter;
 	while (true)
@@ -1384,11 +1432,7 @@ void LatteCP_ProcessRingbuffer()
 			uint32 itCode = (itHeader >> 8) & 0xFF;
 			uint32 nWords = ((itHeader >> 16) & 0x3FFF) + 1;
 			cemu_assert(nWords < 128);
-			for (sint32 i=0; i<nWords; i++)
-			{
-				uint32 word = LatteCP_readU32Deprc();
-				tmpBuffer[i] = word;
-			}
+			LatteCP_readSpan(tmpBuffer, nWords);
 			LatteCMDPtr cmd = (LatteCMDPtr)tmpBuffer;
 			switch (itCode)
 			{
@@ -111,6 +111,8 @@ void LatteOverlay_renderOverlay(ImVec2& position, ImVec2& pivot, sint32 directio
 				// general debug info
 				ImGui::Text("--- Debug info ---");
 				ImGui::Text("IndexUploadPerFrame: %dKB", (performanceMonitor.stats.indexDataUploadPerFrame+1023)/1024);
+				ImGui::Text("UniformUploadPerFrame: %dKB (%dKB reused)", (performanceMonitor.stats.uniformVarUploadPerFrame+1023)/1024, (performanceMonitor.stats.uniformVarCachedPerFrame+1023)/1024);
+				ImGui::Text("SpinLoopYields: %u/s (%lluK cycles skipped)", performanceMonitor.stats.spinLoopYieldsPerSecond, (unsigned long long)(performanceMonitor.stats.spinLoopSkippedCyclesPerSecond / 1000));
 				// backend specific info
 				g_renderer->AppendOverlayDebugInfo();
 			}
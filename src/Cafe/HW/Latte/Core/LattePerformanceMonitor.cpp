@@ -1,5 +1,6 @@
 #include "Cafe/HW/Latte/Core/LattePerformanceMonitor.h"
 #include "Cafe/HW/Latte/Core/LatteOverlay.h"
+#include "Cafe/HW/Espresso/Recompiler/PPCRecompiler.h"
 #include "WindowSystem.h"
 
 performanceMonitor_t performanceMonitor{};
@@ -36,6 +37,8 @@ void LattePerformanceMonitor_frameEnd()
 		uint64 uniformBankUploadedCount = 0;
 		uint64 indexDataUploaded = 0;
 		uint64 indexDataCached = 0;
+		uint64 uniformVarUploadedData = 0;
+		uint64 uniformVarCachedData = 0;
 		uint32 frameCounter = 0;
 		uint32 drawCallCounter = 0;
 		uint32 fastDrawCallCounter = 0;
@@ -52,6 +55,8 @@ void LattePerformanceMonitor_frameEnd()
 			uniformBankUploadedCount += performanceMonitor.cycle[i].uniformBankUploadedCount;
 			indexDataUploaded += performanceMonitor.cycle[i].indexDataUploaded;
 			indexDataCached += performanceMonitor.cycle[i].indexDataCached;
+			uniformVarUploadedData += performanceMonitor.cycle[i].uniformVarUploadedData;
+			uniformVarCachedData += performanceMonitor.cycle[i].uniformVarCachedData;
 			frameCounter += performanceMonitor.cycle[i].frameCounter;
 			drawCallCounter += performanceMonitor.cycle[i].drawCallCounter;
 			fastDrawCallCounter += performanceMonitor.cycle[i].fastDrawCallCounter;
@@ -82,6 +87,17 @@ void LattePerformanceMonitor_frameEnd()
 		uint32 tlps = (uint32)((uint64)threadLeaveCount * 1000ULL / (uint64)totalElapsedTime);
 		// set stats
 		performanceMonitor.stats.indexDataUploadPerFrame = indexDataUploadPerFrame;
+		performanceMonitor.stats.uniformVarUploadPerFrame = (uint32)(uniformVarUploadedData / (uint64)elapsedFrames);
+		performanceMonitor.stats.uniformVarCachedPerFrame = (uint32)(uniformVarCachedData / (uint64)elapsedFrames);
+		// spin loop counters are cumulative, use the difference since the last update
+		static uint64 s_prevSpinLoopYields = 0;
+		static uint64 s_prevSpinLoopSkippedCycles = 0;
+		uint64 spinLoopYields = ppcRecompilerSpinLoopStats.numYields.load(std::memory_order_relaxed);
+		uint64 spinLoopSkippedCycles = ppcRecompilerSpinLoopStats.skippedCycles.load(std::memory_order_relaxed);
+		performanceMonitor.stats.spinLoopYieldsPerSecond = (uint32)((spinLoopYields - s_prevSpinLoopYields) * 1000ULL / (uint64)elapsedTime);
+		performanceMonitor.stats.spinLoopSkippedCyclesPerSecond = (spinLoopSkippedCycles - s_prevSpinLoopSkippedCycles) * 1000ULL / (uint64)elapsedTime;
+		s_prevSpinLoopYields = spinLoopYields;
+		s_prevSpinLoopSkippedCycles = spinLoopSkippedCycles;
 		// next counter cycle
 		sint32 nextCycleIndex = (performanceMonitor.cycleIndex + 1) % PERFORMANCE_MONITOR_TRACK_CYCLES;
 		performanceMonitor.cycle[nextCycleIndex].drawCallCounter = 0;
@@ -96,6 +112,8 @@ void LattePerformanceMonitor_frameEnd()
 		performanceMonitor.cycle[nextCycleIndex].uniformBankUploadedCount = 0;
 		performanceMonitor.cycle[nextCycleIndex].indexDataUploaded = 0;
 		performanceMonitor.cycle[nextCycleIndex].indexDataCached = 0;
+		performanceMonitor.cycle[nextCycleIndex].uniformVarUploadedData = 0;
+		performanceMonitor.cycle[nextCycleIndex].uniformVarCachedData = 0;
 		performanceMonitor.cycle[nextCycleIndex].recompilerLeaveCount = 0;
 		performanceMonitor.cycle[nextCycleIndex].threadLeaveCount = 0;
 		performanceMonitor.cycleIndex = nextCycleIndex;
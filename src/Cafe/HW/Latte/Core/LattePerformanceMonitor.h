@@ -92,6 +92,8 @@ typedef struct
 		uint64 uniformBankUploadedCount; // number of separate uploads for uniformBankDataUploaded
 		uint64 indexDataUploaded;
 		uint64 indexDataCached;
+		uint64 uniformVarUploadedData; // amount of uniform var data (ALU constants, remapped uniforms and per-draw values) written to the uniform ring buffer
+		uint64 uniformVarCachedData; // amount of uniform var data which was unchanged and reused from a previous draw
 	}cycle[PERFORMANCE_MONITOR_TRACK_CYCLES];
 	sint32 cycleIndex;
 	// new stats
@@ -137,6 +139,10 @@ typedef struct
 	struct
 	{
 		uint32 indexDataUploadPerFrame;
+		uint32 uniformVarUploadPerFrame;
+		uint32 uniformVarCachedPerFrame;
+		uint32 spinLoopYieldsPerSecond;
+		uint64 spinLoopSkippedCyclesPerSecond;
 	}stats;
 }performanceMonitor_t;
 
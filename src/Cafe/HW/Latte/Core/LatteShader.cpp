@@ -6,6 +6,7 @@
 #include "Cafe/HW/Latte/LegacyShaderDecompiler/LatteDecompiler.h"
 #include "Cafe/HW/Latte/Core/FetchShader.h"
 #include "Cafe/HW/Latte/Core/LattePerformanceMonitor.h"
+#include "Cafe/HW/Latte/Core/LatteBufferCache.h"
 #include "Cafe/HW/Latte/Renderer/Vulkan/VulkanRenderer.h"
 #include "Cafe/OS/libs/gx2/GX2.h" // todo - remove dependency
 #include "Cafe/GraphicPack/GraphicPack2.h"
@@ -542,7 +543,7 @@ void LatteSHRC_UpdatePSBaseHash(uint8* pixelShaderPtr, uint32 pixelShaderSize, b
 	_shaderBaseHash_ps = psHash;
 }
 
-uint64 LatteSHRC_CalcVSAuxHash(LatteDecompilerShader* vertexShader, uint32* contextRegisters)
+uint64 LatteSHRC_CalcVSAuxHash(LatteDecompilerShader* vertexShader, uint32* contextRegisters, uint16 hostEndianVertexBufferMask)
 {
 	// todo - include texture types in aux hash similar to how it is already done in pixel shader
 	//        or maybe there is a way to figure out the proper texture types?
@@ -572,7 +573,9 @@ uint64 LatteSHRC_CalcVSAuxHash(LatteDecompilerShader* vertexShader, uint32* cont
 			auxHashTex += 0x333;
 		}
 	}
-	return auxHash + auxHashTex;
+	// vertex buffers which are byte swapped on the CPU. Zero for the regular variant so that its hash stays unchanged
+	uint64 auxHashVtx = (uint64)hostEndianVertexBufferMask << 48;
+	return auxHash + auxHashTex + auxHashVtx;
 }
 
 uint64 LatteSHRC_CalcGSAuxHash(LatteDecompilerShader* geometryShader)
@@ -613,7 +616,8 @@ LatteDecompilerShader* LatteShader_CreateShaderFromDecompilerOutput(LatteDecompi
 	LatteDecompilerShader* shader = decompilerOutput.shader;
 	shader->baseHash = baseHash;
 	// copy resource mapping
-	if(g_renderer->GetType() == RendererAPI::Vulkan)
+	// the null renderer has no API specific bindings and uses the Vulkan layout
+	if(g_renderer->GetType() != RendererAPI::OpenGL)
 		shader->resourceMapping = decompilerOutput.resourceMappingVK;
 	else
 		shader->resourceMapping = decompilerOutput.resourceMappingGL;
@@ -624,7 +628,7 @@ LatteDecompilerShader* LatteShader_CreateShaderFromDecompilerOutput(LatteDecompi
 	shader->hasStreamoutBufferWrite = decompilerOutput.streamoutBufferWriteMask.any();
 	// copy uniform offsets
 	// for OpenGL these are retrieved in _prepareSeparableUniforms()
-	if (g_renderer->GetType() == RendererAPI::Vulkan)
+	if (g_renderer->GetType() != RendererAPI::OpenGL)
 	{
 		shader->uniform.loc_remapped = decompilerOutput.uniformOffsetsVK.offset_remapped;
 		shader->uniform.loc_uniformRegister = decompilerOutput.uniformOffsetsVK.offset_uniformRegister;
@@ -657,7 +661,7 @@ LatteDecompilerShader* LatteShader_CreateShaderFromDecompilerOutput(LatteDecompi
 	{
 		if (decompilerOutput.shaderType == LatteConst::ShaderType::Vertex)
 		{
-			uint64 vsAuxHash = LatteSHRC_CalcVSAuxHash(shader, contextRegister);
+			uint64 vsAuxHash = LatteSHRC_CalcVSAuxHash(shader, contextRegister, shader->hostEndianVertexBufferMask);
 			shader->auxHash = vsAuxHash;
 		}
 		else if (decompilerOutput.shaderType == LatteConst::ShaderType::Geometry)
@@ -740,7 +744,7 @@ LatteDecompilerShader* LatteShader_CompileSeparableVertexShader2(uint64 baseHash
 }
 
 // compile new vertex shader (relies partially on current state)
-LatteDecompilerShader* LatteShader_CompileSeparableVertexShader(uint64 baseHash, uint64& vsAuxHash, uint8* vertexShaderPtr, uint32 vertexShaderSize, bool usesGeometryShader, LatteFetchShader* fetchShader)
+LatteDecompilerShader* LatteShader_CompileSeparableVertexShader(uint64 baseHash, uint64& vsAuxHash, uint8* vertexShaderPtr, uint32 vertexShaderSize, bool usesGeometryShader, LatteFetchShader* fetchShader, uint16 hostEndianVertexBufferMask)
 {
 	// new decompiler test
 	//LatteShader_CompileSeparableVertexShader2(baseHash, vsAuxHash, vertexShaderPtr, vertexShaderSize, usesGeometryShader, fetchShader);
@@ -748,6 +752,7 @@ LatteDecompilerShader* LatteShader_CompileSeparableVertexShader(uint64 baseHash,
 	// legacy decompiler
 	LatteDecompilerOptions options;
 	LatteShader_GetDecompilerOptions(options, LatteConst::ShaderType::Vertex, usesGeometryShader);
+	options.hostEndianVertexBufferMask = hostEndianVertexBufferMask;
 
 	LatteDecompilerOutput_t decompilerOutput{};
 	LatteDecompiler_DecompileVertexShader(_shaderBaseHash_vs, LatteGPUState.contextRegister, vertexShaderPtr, vertexShaderSize, fetchShader, options, &decompilerOutput);
@@ -757,7 +762,7 @@ LatteDecompilerShader* LatteShader_CompileSeparableVertexShader(uint64 baseHash,
 	{
 		uint8* fsProgramCode = (uint8*)memory_getPointerFromPhysicalOffset(LatteGPUState.contextRegister[mmSQ_PGM_START_FS + 0] << 8);
 		uint32 fsProgramSize = LatteGPUState.contextRegister[mmSQ_PGM_START_FS + 1] << 3;
-		LatteShaderCache_writeSeparableVertexShader(vertexShader->baseHash, vertexShader->auxHash, fsProgramCode, fsProgramSize, vertexShaderPtr, vertexShaderSize, LatteGPUState.contextRegister, usesGeometryShader);
+		LatteShaderCache_writeSeparableVertexShader(vertexShader->baseHash, vertexShader->auxHash, fsProgramCode, fsProgramSize, vertexShaderPtr, vertexShaderSize, LatteGPUState.contextRegister, usesGeometryShader, hostEndianVertexBufferMask);
 	}
 	LatteShader_DumpShader(vertexShader->baseHash, vertexShader->auxHash, vertexShader);
 	LatteShader_DumpRawShader(vertexShader->baseHash, vertexShader->auxHash, SHADER_DUMP_TYPE_VERTEX, vertexShaderPtr, vertexShaderSize);
@@ -838,15 +843,16 @@ void LatteSHRC_UpdateVertexShader(uint8* vertexShaderPtr, uint32 vertexShaderSiz
 	// todo - should include VTX_SEMANTIC table in state
 	LatteSHRC_UpdateVSBaseHash(vertexShaderPtr, vertexShaderSize, usesGeometryShader);
 	uint64 vsAuxHash = 0;
+	uint16 hostEndianVertexBufferMask = LatteBufferCache_getHostEndianVertexBufferMask(_activeFetchShader, LatteGPUState.contextRegister);
 	auto itBaseShader = sVertexShaders.find(_shaderBaseHash_vs);
 	LatteDecompilerShader* vertexShader = nullptr;
 	if (itBaseShader != sVertexShaders.end())
 	{
-		vsAuxHash = LatteSHRC_CalcVSAuxHash(itBaseShader->second, LatteGPUState.contextRegister);
+		vsAuxHash = LatteSHRC_CalcVSAuxHash(itBaseShader->second, LatteGPUState.contextRegister, hostEndianVertexBufferMask);
 		vertexShader = LatteSHRC_GetFromChain(itBaseShader->second, _shaderBaseHash_vs, vsAuxHash);
 	}
 	if (!vertexShader)
-		vertexShader = LatteShader_CompileSeparableVertexShader(_shaderBaseHash_vs, vsAuxHash, vertexShaderPtr, vertexShaderSize, usesGeometryShader, _activeFetchShader);
+		vertexShader = LatteShader_CompileSeparableVertexShader(_shaderBaseHash_vs, vsAuxHash, vertexShaderPtr, vertexShaderSize, usesGeometryShader, _activeFetchShader, hostEndianVertexBufferMask);
 	if (vertexShader->hasError)
 	{
 		LatteGPUState.activeShaderHasError = true;
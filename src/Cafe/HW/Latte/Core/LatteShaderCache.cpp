@@ -637,16 +637,20 @@ uint64 LatteShaderCache_getShaderNameInTransferableCache(uint64 baseHash, uint32
 	return baseHash;
 }
 
-void LatteShaderCache_writeSeparableVertexShader(uint64 shaderBaseHash, uint64 shaderAuxHash, uint8* fetchShader, uint32 fetchShaderSize, uint8* vertexShader, uint32 vertexShaderSize, uint32* contextRegisters, bool usesGeometryShader)
+void LatteShaderCache_writeSeparableVertexShader(uint64 shaderBaseHash, uint64 shaderAuxHash, uint8* fetchShader, uint32 fetchShaderSize, uint8* vertexShader, uint32 vertexShaderSize, uint32* contextRegisters, bool usesGeometryShader, uint16 hostEndianVertexBufferMask)
 {
 	if (!s_shaderCacheGeneric)
 		return;
 	MemStreamWriter streamWriter(128 * 1024);
 	// header
-	streamWriter.writeBE<uint8>(1 | (SHADER_CACHE_TYPE_VERTEX << 4)); // version and type (shared field)
+	// version 2 adds the mask of host endian vertex buffers. Regular variants are still stored as version 1
+	uint8 version = hostEndianVertexBufferMask != 0 ? 2 : 1;
+	streamWriter.writeBE<uint8>(version | (SHADER_CACHE_TYPE_VERTEX << 4)); // version and type (shared field)
 	streamWriter.writeBE<uint64>(shaderBaseHash);
 	streamWriter.writeBE<uint64>(shaderAuxHash);
 	streamWriter.writeBE<uint8>(usesGeometryShader ? 1 : 0);
+	if (version >= 2)
+		streamWriter.writeBE<uint16>(hostEndianVertexBufferMask);
 	// register state
 	Latte::GPUCompactedRegisterState compactRegState;
 	Latte::StoreGPURegisterState(*(LatteContextRegister*)contextRegisters, compactRegState);
@@ -733,33 +737,36 @@ void LatteShaderCache_loadOrCompileSeparableShader(LatteDecompilerShader* shader
 	LatteShaderCache_addToCompileQueue(shader);
 }
 
-bool LatteShaderCache_readSeparableVertexShader(MemStreamReader& streamReader, uint8 version)
+LatteDecompilerShader* LatteShaderCache_decompileSeparableVertexShader(MemStreamReader& streamReader, uint8 version, LatteDecompilerOutput_t& decompilerOutput, uint64& shaderBaseHash, uint64& shaderAuxHash)
 {
 	auto lcr = std::make_unique<LatteContextRegister>();
-	if (version != 1)
-		return false;
-	uint64 shaderBaseHash = streamReader.readBE<uint64>();
-	uint64 shaderAuxHash = streamReader.readBE<uint64>();
+	if (version != 1 && version != 2)
+		return nullptr;
+	shaderBaseHash = streamReader.readBE<uint64>();
+	shaderAuxHash = streamReader.readBE<uint64>();
 	bool usesGeometryShader = streamReader.readBE<uint8>() != 0;
+	uint16 hostEndianVertexBufferMask = 0;
+	if (version >= 2)
+		hostEndianVertexBufferMask = streamReader.readBE<uint16>();
 	// context registers
 	Latte::GPUCompactedRegisterState regState;
 	if (!Latte::DeserializeRegisterState(regState, streamReader))
-		return false;
+		return nullptr;
 	Latte::LoadGPURegisterState(*lcr, regState);
 	if (streamReader.hasError())
-		return false;
+		return nullptr;
 	// fetch shader
 	std::vector<uint8> fetchShaderData;
 	if (!Latte::DeserializeShaderProgram(fetchShaderData, streamReader))
-		return false;
+		return nullptr;
 	if (streamReader.hasError())
-		return false;
+		return nullptr;
 	// vertex shader
 	std::vector<uint8> vertexShaderData;
 	if (!Latte::DeserializeShaderProgram(vertexShaderData, streamReader))
-		return false;
+		return nullptr;
 	if (streamReader.hasError() || !streamReader.isEndOfStream())
-		return false;
+		return nullptr;
 	// update PS inputs (affects VS shader outputs)
 	LatteShader_UpdatePSInputs(lcr->GetRawView());
 	// get fetch shader
@@ -768,114 +775,116 @@ bool LatteShaderCache_readSeparableVertexShader(MemStreamReader& streamReader, u
 	// determine decompiler options
 	LatteDecompilerOptions options;
 	LatteShader_GetDecompilerOptions(options, LatteConst::ShaderType::Vertex, usesGeometryShader);
+	options.hostEndianVertexBufferMask = hostEndianVertexBufferMask;
 	// decompile vertex shader
-	LatteDecompilerOutput_t decompilerOutput{};
 	LatteDecompiler_DecompileVertexShader(shaderBaseHash, lcr->GetRawView(), vertexShaderData.data(), vertexShaderData.size(), fetchShader, options, &decompilerOutput);
 	LatteDecompilerShader* vertexShader = LatteShader_CreateShaderFromDecompilerOutput(decompilerOutput, shaderBaseHash, false, shaderAuxHash, lcr->GetRawView());
-	// compile
 	LatteShader_DumpShader(shaderBaseHash, shaderAuxHash, vertexShader);
 	LatteShader_DumpRawShader(shaderBaseHash, shaderAuxHash, SHADER_DUMP_TYPE_VERTEX, vertexShaderData.data(), vertexShaderData.size());
-	LatteShaderCache_loadOrCompileSeparableShader(vertexShader, shaderBaseHash, shaderAuxHash);
-	LatteSHRC_RegisterShader(vertexShader, shaderBaseHash, shaderAuxHash);
-	return true;
+	return vertexShader;
 }
 
-bool LatteShaderCache_readSeparableGeometryShader(MemStreamReader& streamReader, uint8 version)
+LatteDecompilerShader* LatteShaderCache_decompileSeparableGeometryShader(MemStreamReader& streamReader, uint8 version, LatteDecompilerOutput_t& decompilerOutput, uint64& shaderBaseHash, uint64& shaderAuxHash)
 {
 	if (version != 1)
-		return false;
+		return nullptr;
 	auto lcr = std::make_unique<LatteContextRegister>();
-	uint64 shaderBaseHash = streamReader.readBE<uint64>();
-	uint64 shaderAuxHash = streamReader.readBE<uint64>();
+	shaderBaseHash = streamReader.readBE<uint64>();
+	shaderAuxHash = streamReader.readBE<uint64>();
 	uint32 vsRingParameterCount = streamReader.readBE<uint16>();
 	// context registers
 	Latte::GPUCompactedRegisterState regState;
 	if (!Latte::DeserializeRegisterState(regState, streamReader))
-		return false;
+		return nullptr;
 	Latte::LoadGPURegisterState(*lcr, regState);
 	if (streamReader.hasError())
-		return false;
+		return nullptr;
 	// geometry copy shader
 	std::vector<uint8> geometryCopyShaderData;
 	if (!Latte::DeserializeShaderProgram(geometryCopyShaderData, streamReader))
-		return false;
+		return nullptr;
 	// geometry shader
 	std::vector<uint8> geometryShaderData;
 	if (!Latte::DeserializeShaderProgram(geometryShaderData, streamReader))
-		return false;
+		return nullptr;
 	if (streamReader.hasError() || !streamReader.isEndOfStream())
-		return false;
+		return nullptr;
 	// update PS inputs
 	LatteShader_UpdatePSInputs(lcr->GetRawView());
 	// determine decompiler options
 	LatteDecompilerOptions options;
 	LatteShader_GetDecompilerOptions(options, LatteConst::ShaderType::Geometry, true);
 	// decompile geometry shader
-	LatteDecompilerOutput_t decompilerOutput{};
 	LatteDecompiler_DecompileGeometryShader(shaderBaseHash, lcr->GetRawView(), geometryShaderData.data(), geometryShaderData.size(), geometryCopyShaderData.data(), geometryCopyShaderData.size(), vsRingParameterCount, options, &decompilerOutput);
 	LatteDecompilerShader* geometryShader = LatteShader_CreateShaderFromDecompilerOutput(decompilerOutput, shaderBaseHash, false, shaderAuxHash, lcr->GetRawView());
-	// compile
 	LatteShader_DumpShader(shaderBaseHash, shaderAuxHash, geometryShader);
 	LatteShader_DumpRawShader(shaderBaseHash, shaderAuxHash, SHADER_DUMP_TYPE_GEOMETRY, geometryShaderData.data(), geometryShaderData.size());
-	LatteShaderCache_loadOrCompileSeparableShader(geometryShader, shaderBaseHash, shaderAuxHash);
-	LatteSHRC_RegisterShader(geometryShader, shaderBaseHash, shaderAuxHash);
-	return true;
+	return geometryShader;
 }
 
-bool LatteShaderCache_readSeparablePixelShader(MemStreamReader& streamReader, uint8 version)
+LatteDecompilerShader* LatteShaderCache_decompileSeparablePixelShader(MemStreamReader& streamReader, uint8 version, LatteDecompilerOutput_t& decompilerOutput, uint64& shaderBaseHash, uint64& shaderAuxHash)
 {
 	if (version != 1)
-		return false;
+		return nullptr;
 	auto lcr = std::make_unique<LatteContextRegister>();
-	uint64 shaderBaseHash = streamReader.readBE<uint64>();
-	uint64 shaderAuxHash = streamReader.readBE<uint64>();
+	shaderBaseHash = streamReader.readBE<uint64>();
+	shaderAuxHash = streamReader.readBE<uint64>();
 	bool usesGeometryShader = streamReader.readBE<uint8>() != 0;
 	// context registers
 	Latte::GPUCompactedRegisterState regState;
 	if (!Latte::DeserializeRegisterState(regState, streamReader))
-		return false;
+		return nullptr;
 	Latte::LoadGPURegisterState(*lcr, regState);
 	if (streamReader.hasError())
-		return false;
+		return nullptr;
 	// pixel shader
 	std::vector<uint8> pixelShaderData;
 	if (!Latte::DeserializeShaderProgram(pixelShaderData, streamReader))
-		return false;
+		return nullptr;
 	if (streamReader.hasError() || !streamReader.isEndOfStream())
-		return false;
+		return nullptr;
 	// update PS inputs
 	LatteShader_UpdatePSInputs(lcr->GetRawView());
 	// determine decompiler options
 	LatteDecompilerOptions options;
 	LatteShader_GetDecompilerOptions(options, LatteConst::ShaderType::Pixel, usesGeometryShader);
 	// decompile pixel shader
-	LatteDecompilerOutput_t decompilerOutput{};
 	LatteDecompiler_DecompilePixelShader(shaderBaseHash, lcr->GetRawView(), pixelShaderData.data(), pixelShaderData.size(), options, &decompilerOutput);
 	LatteDecompilerShader* pixelShader = LatteShader_CreateShaderFromDecompilerOutput(decompilerOutput, shaderBaseHash, false, shaderAuxHash, lcr->GetRawView());
-	// compile
 	LatteShader_DumpShader(shaderBaseHash, shaderAuxHash, pixelShader);
 	LatteShader_DumpRawShader(shaderBaseHash, shaderAuxHash, SHADER_DUMP_TYPE_PIXEL, pixelShaderData.data(), pixelShaderData.size());
-	LatteShaderCache_loadOrCompileSeparableShader(pixelShader, shaderBaseHash, shaderAuxHash);
-	LatteSHRC_RegisterShader(pixelShader, shaderBaseHash, shaderAuxHash);
-	return true;
+	return pixelShader;
 }
 
-// read shader info from shader cache
-bool LatteShaderCache_readSeparableShader(uint8* shaderInfoData, sint32 shaderInfoSize)
+// decompile a shader cache entry without compiling or registering it
+LatteDecompilerShader* LatteShaderCache_decompileSeparableShader(uint8* shaderInfoData, sint32 shaderInfoSize, LatteDecompilerOutput_t& decompilerOutput, uint64& shaderBaseHash, uint64& shaderAuxHash)
 {
 	if (shaderInfoSize < 8)
-		return false;
+		return nullptr;
 	MemStreamReader streamReader(shaderInfoData, shaderInfoSize);
 	uint8 versionAndType = streamReader.readBE<uint8>();
 	uint8 version = versionAndType & 0xF;
 	uint8 type = (versionAndType >> 4) & 0xF;
 	if (type == SHADER_CACHE_TYPE_VERTEX)
-		return LatteShaderCache_readSeparableVertexShader(streamReader, version);
+		return LatteShaderCache_decompileSeparableVertexShader(streamReader, version, decompilerOutput, shaderBaseHash, shaderAuxHash);
 	else if (type == SHADER_CACHE_TYPE_GEOMETRY)
-		return LatteShaderCache_readSeparableGeometryShader(streamReader, version);
+		return LatteShaderCache_decompileSeparableGeometryShader(streamReader, version, decompilerOutput, shaderBaseHash, shaderAuxHash);
 	else if (type == SHADER_CACHE_TYPE_PIXEL)
-		return LatteShaderCache_readSeparablePixelShader(streamReader, version);
-	return false;
+		return LatteShaderCache_decompileSeparablePixelShader(streamReader, version, decompilerOutput, shaderBaseHash, shaderAuxHash);
+	return nullptr;
+}
+
+// read shader info from shader cache
+bool LatteShaderCache_readSeparableShader(uint8* shaderInfoData, sint32 shaderInfoSize)
+{
+	LatteDecompilerOutput_t decompilerOutput{};
+	uint64 shaderBaseHash, shaderAuxHash;
+	LatteDecompilerShader* shader = LatteShaderCache_decompileSeparableShader(shaderInfoData, shaderInfoSize, decompilerOutput, shaderBaseHash, shaderAuxHash);
+	if (!shader)
+		return false;
+	LatteShaderCache_loadOrCompileSeparableShader(shader, shaderBaseHash, shaderAuxHash);
+	LatteSHRC_RegisterShader(shader, shaderBaseHash, shaderAuxHash);
+	return true;
 }
 
 void LatteShaderCache_Close()
@@ -1,4 +1,11 @@
 #pragma once
 
+struct LatteDecompilerShader;
+struct LatteDecompilerOutput_t;
+
 uint32 LatteShaderCache_getShaderCacheExtraVersion(uint64 titleId);
-uint32 LatteShaderCache_getPipelineCacheExtraVersion(uint64 titleId);
\ No newline at end of file
+uint32 LatteShaderCache_getPipelineCacheExtraVersion(uint64 titleId);
+
+// decompiles a single entry of the transferable shader cache. The shader is neither compiled nor registered
+// returns nullptr if the entry is invalid
+LatteDecompilerShader* LatteShaderCache_decompileSeparableShader(uint8* shaderInfoData, sint32 shaderInfoSize, LatteDecompilerOutput_t& decompilerOutput, uint64& shaderBaseHash, uint64& shaderAuxHash);
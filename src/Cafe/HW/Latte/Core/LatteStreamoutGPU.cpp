@@ -162,6 +162,7 @@ void LatteStreamout_FinishDrawcall(bool useDirectMemoryMode)
 			// advance streamout offset
 			uint32 newOffset = LatteGPUState.contextRegister[mmVGT_STRMOUT_BUFFER_OFFSET_0 + i * 4] + activeStreamoutOperation.streamoutBufferWrite[i].rangeSize;
 			LatteGPUState.contextRegister[mmVGT_STRMOUT_BUFFER_OFFSET_0 + i * 4] = newOffset;
+			LatteReg_markWritten(mmVGT_STRMOUT_BUFFER_OFFSET_0 + i * 4, mmVGT_STRMOUT_BUFFER_OFFSET_0 + i * 4 + 1);
 		}
 		g_renderer->streamout_rendererFinishDrawcall();
 	}
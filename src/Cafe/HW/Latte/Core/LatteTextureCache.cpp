@@ -217,6 +217,9 @@ bool LatteTC_HasTextureChanged(LatteTexture* hostTexture, bool force)
 	// todo: Instead of relying on frames, it would be better to recheck only after any GPU wait operation occurred.
 	if( hostTexture->lastDataUpdateFrameCounter == LatteGPUState.frameCounter && force == false)
 		return false;
+	// data of a finished readback is still being written to memory, the texture already holds it
+	if (LatteTextureReadback_IsMemoryWritePending(hostTexture->physAddress) && force == false)
+		return false;
 	hostTexture->lastDataUpdateFrameCounter = LatteGPUState.frameCounter;
 	// we assume that certain texture properties indicate that the texture will never be written by the CPU
 	if (hostTexture->width == 1280 && hostTexture->format != Latte::E_GX2SURFFMT::R8_UNORM && force == false)
@@ -37,6 +37,7 @@ struct LatteTextureLoaderCtx
 };
 
 uint8* LatteTextureLoader_GetInput(LatteTextureLoaderCtx* textureLoader, sint32 x, sint32 y);
+uint8* LatteTextureLoader_GetScratchBuffer(uint32 size);
 
 #include "Cafe/HW/Latte/LatteAddrLib/AddrLibFastDecode.h"
 
@@ -125,6 +126,131 @@ public:
 	virtual void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) = 0;
 };
 
+// table of conversions for packed formats which the host API does not support with the same bit layout
+// each channel is moved from the GPU7 texel to the host texel. If the host channel is wider the value is expanded by bit replication
+// host texel bits not written by any channel are taken from dstConstant
+struct PackedTexelChannel
+{
+	uint8 srcShift;
+	uint8 srcBits; // 0 -> channel unused
+	uint8 dstShift;
+	uint8 dstBits;
+};
+
+struct PackedTexelConvDesc
+{
+	uint8 srcBytes;
+	uint8 dstBytes;
+	PackedTexelChannel channel[4];
+	uint32 dstConstant;
+};
+
+enum class PackedTexelConv
+{
+	R4_G4_TO_RGBA4_SWAPPED,
+	R4_G4_TO_RGBA4,
+	R4_G4_TO_RGBA8,
+	R4_G4_B4_A4_SWAPPED,
+	R4_G4_B4_A4_TO_RGBA8,
+	R5_G6_B5_SWAPPED_RB,
+	R5_G6_B5_TO_RGBA8,
+	R5_G5_B5_A1_SWAPPED_RB,
+	R5_G5_B5_A1_SWAPPED_OPENGL,
+	R5_G5_B5_A1_TO_RGBA8,
+	A1_B5_G5_R5_TO_R5_G5_B5_A1,
+	A1_B5_G5_R5_TO_RGBA8,
+	COUNT
+};
+
+inline constexpr PackedTexelConvDesc g_packedTexelConvTable[] =
+{
+	// R4_G4_TO_RGBA4_SWAPPED (OpenGL has no RG4 format, blue and alpha stay zero)
+	{ 1, 2, { { 4, 4, 8, 4 }, { 0, 4, 12, 4 }, {}, {} }, 0 },
+	// R4_G4_TO_RGBA4
+	{ 1, 2, { { 0, 4, 8, 4 }, { 4, 4, 12, 4 }, {}, {} }, 0 },
+	// R4_G4_TO_RGBA8
+	{ 1, 4, { { 4, 4, 0, 8 }, { 0, 4, 8, 8 }, {}, {} }, 0xFF000000 },
+	// R4_G4_B4_A4_SWAPPED
+	{ 2, 2, { { 12, 4, 0, 4 }, { 8, 4, 4, 4 }, { 4, 4, 8, 4 }, { 0, 4, 12, 4 } }, 0 },
+	// R4_G4_B4_A4_TO_RGBA8
+	{ 2, 4, { { 0, 4, 0, 8 }, { 4, 4, 8, 8 }, { 8, 4, 16, 8 }, { 12, 4, 24, 8 } }, 0 },
+	// R5_G6_B5_SWAPPED_RB
+	{ 2, 2, { { 11, 5, 0, 5 }, { 5, 6, 5, 6 }, { 0, 5, 11, 5 }, {} }, 0 },
+	// R5_G6_B5_TO_RGBA8
+	{ 2, 4, { { 0, 5, 0, 8 }, { 5, 6, 8, 8 }, { 11, 5, 16, 8 }, {} }, 0xFF000000 },
+	// R5_G5_B5_A1_SWAPPED_RB
+	{ 2, 2, { { 10, 5, 0, 5 }, { 5, 5, 5, 5 }, { 0, 5, 10, 5 }, { 15, 1, 15, 1 } }, 0 },
+	// R5_G5_B5_A1_SWAPPED_OPENGL
+	{ 2, 2, { { 0, 5, 11, 5 }, { 5, 5, 6, 5 }, { 10, 5, 1, 5 }, { 15, 1, 0, 1 } }, 0 },
+	// R5_G5_B5_A1_TO_RGBA8
+	{ 2, 4, { { 0, 5, 0, 8 }, { 5, 5, 8, 8 }, { 10, 5, 16, 8 }, { 15, 1, 24, 8 } }, 0 },
+	// A1_B5_G5_R5_TO_R5_G5_B5_A1
+	{ 2, 2, { { 1, 5, 0, 5 }, { 6, 5, 5, 5 }, { 11, 5, 10, 5 }, { 0, 1, 15, 1 } }, 0 },
+	// A1_B5_G5_R5_TO_RGBA8
+	{ 2, 4, { { 11, 5, 0, 8 }, { 6, 5, 8, 8 }, { 1, 5, 16, 8 }, { 0, 1, 24, 8 } }, 0 },
+};
+
+static_assert(std::size(g_packedTexelConvTable) == (size_t)PackedTexelConv::COUNT);
+
+constexpr uint32 _packedTexelExpandBits(uint32 v, uint32 srcBits, uint32 dstBits)
+{
+	if (srcBits >= dstBits)
+		return v >> (srcBits - dstBits);
+	return (v << (dstBits - srcBits)) | _packedTexelExpandBits(v, srcBits, dstBits - srcBits);
+}
+
+template<PackedTexelConv TConv, int TChannel>
+inline uint32 _packedTexelConvertChannel(uint32 v)
+{
+	constexpr PackedTexelChannel ch = g_packedTexelConvTable[(size_t)TConv].channel[TChannel];
+	if constexpr (ch.srcBits == 0)
+		return 0;
+	else
+		return _packedTexelExpandBits((v >> ch.srcShift) & ((1u << ch.srcBits) - 1), ch.srcBits, ch.dstBits) << ch.dstShift;
+}
+
+// decoder for a conversion from g_packedTexelConvTable
+// untiling is done by the regular copy loops, the conversion is a linear pass over all texels which the compiler can unroll and vectorize
+template<PackedTexelConv TConv>
+class TextureDecoder_PackedTexel : public TextureDecoder
+{
+	static constexpr PackedTexelConvDesc desc = g_packedTexelConvTable[(size_t)TConv];
+	using srcType = std::conditional_t<desc.srcBytes == 1, uint8, uint16>;
+	using dstType = std::conditional_t<desc.dstBytes == 2, uint16, uint32>;
+	static_assert(sizeof(srcType) == desc.srcBytes && sizeof(dstType) == desc.dstBytes);
+
+public:
+	static dstType convertTexel(uint32 v)
+	{
+		return (dstType)(desc.dstConstant | _packedTexelConvertChannel<TConv, 0>(v) | _packedTexelConvertChannel<TConv, 1>(v) | _packedTexelConvertChannel<TConv, 2>(v) | _packedTexelConvertChannel<TConv, 3>(v));
+	}
+
+	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
+	{
+		return sizeof(dstType);
+	}
+
+	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
+	{
+		sint32 texelCount = textureLoader->decodedTexelCountX * textureLoader->decodedTexelCountY;
+		dstType* dstTexels = (dstType*)outputData;
+		if constexpr (sizeof(srcType) == sizeof(dstType))
+		{
+			// convert in place
+			optimizedDecodeLoops<srcType, 1, false, false>(textureLoader, outputData);
+			for (sint32 i = 0; i < texelCount; i++)
+				dstTexels[i] = convertTexel(dstTexels[i]);
+		}
+		else
+		{
+			srcType* srcTexels = (srcType*)LatteTextureLoader_GetScratchBuffer(texelCount * sizeof(srcType));
+			optimizedDecodeLoops<srcType, 1, false, false>(textureLoader, (uint8*)srcTexels);
+			for (sint32 i = 0; i < texelCount; i++)
+				dstTexels[i] = convertTexel(srcTexels[i]);
+		}
+	}
+};
+
 class TextureDecoder_R16_G16_B16_A16_FLOAT : public TextureDecoder, public SingletonClass<TextureDecoder_R16_G16_B16_A16_FLOAT>
 {
 public:
@@ -556,30 +682,9 @@ public:
 	}
 };
 
-class TextureDecoder_R4_G4_UNORM_To_RGBA4 : public TextureDecoder, public SingletonClass<TextureDecoder_R4_G4_UNORM_To_RGBA4>
+class TextureDecoder_R4_G4_UNORM_To_RGBA4 : public TextureDecoder_PackedTexel<PackedTexelConv::R4_G4_TO_RGBA4_SWAPPED>, public SingletonClass<TextureDecoder_R4_G4_UNORM_To_RGBA4>
 {
 public:
-	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
-	{
-		return 2;
-	}
-
-	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
-	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-		{
-			sint32 yc = y;
-			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-			{
-				uint8* blockData = LatteTextureLoader_GetInput(textureLoader, x, y);
-				sint32 pixelOffset = (x + yc * textureLoader->width) * 2;
-				uint8 v = (*(uint8*)(blockData + 0));
-				*(uint8*)(outputData + pixelOffset + 0) = 0; // OpenGL has no RG4 format so we use RGBA4 instead and these two values (blue + alpha) are always set to zero
-				*(uint8*)(outputData + pixelOffset + 1) = ((v >> 4) & 0xF) | ((v << 4) & 0xF0); // todo: Is this nibble swap correct?
-			}
-		}
-	}
-
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
 	{
 		uint8 v0 = *(blockData + 0);
@@ -594,30 +699,9 @@ public:
 	}
 };
 
-class TextureDecoder_R4_G4_UNORM_To_RGBA4_vk : public TextureDecoder, public SingletonClass<TextureDecoder_R4_G4_UNORM_To_RGBA4_vk>
+class TextureDecoder_R4_G4_UNORM_To_RGBA4_vk : public TextureDecoder_PackedTexel<PackedTexelConv::R4_G4_TO_RGBA4>, public SingletonClass<TextureDecoder_R4_G4_UNORM_To_RGBA4_vk>
 {
 public:
-	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
-	{
-		return 2;
-	}
-
-	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
-	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-		{
-			sint32 yc = y;
-			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-			{
-				uint8* blockData = LatteTextureLoader_GetInput(textureLoader, x, y);
-				sint32 pixelOffset = (x + yc * textureLoader->width) * 2;
-				uint8 v = (*(uint8*)(blockData + 0));
-				*(uint8*)(outputData + pixelOffset + 0) = 0;
-				*(uint8*)(outputData + pixelOffset + 1) = v;
-			}
-		}
-	}
-
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
 	{
 		uint8 v0 = *(blockData + 0);
@@ -632,39 +716,9 @@ public:
 	}
 };
 
-class TextureDecoder_R4G4_UNORM_To_RGBA8 : public TextureDecoder, public SingletonClass<TextureDecoder_R4G4_UNORM_To_RGBA8>
+class TextureDecoder_R4G4_UNORM_To_RGBA8 : public TextureDecoder_PackedTexel<PackedTexelConv::R4_G4_TO_RGBA8>, public SingletonClass<TextureDecoder_R4G4_UNORM_To_RGBA8>
 {
 public:
-	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
-	{
-		return 4;
-	}
-
-	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
-	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-		{
-			sint32 yc = y;
-			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-			{
-				uint8* blockData = LatteTextureLoader_GetInput(textureLoader, x, y);
-				sint32 pixelOffset = (x + yc * textureLoader->width) * 4;
-				uint8 v0 = (*(uint8*)(blockData + 0));
-
-				uint8 red4 = (v0 >> 4) & 0xF;
-				uint8 green4 = (v0 & 0xF);
-
-				red4 = (red4 << 4) | red4;
-				green4 = (green4 << 4) | green4;
-
-				*(uint8*)(outputData + pixelOffset + 0) = red4;
-				*(uint8*)(outputData + pixelOffset + 1) = green4;
-				*(uint8*)(outputData + pixelOffset + 2) = 0;
-				*(uint8*)(outputData + pixelOffset + 3) = 255;
-			}
-		}
-	}
-
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
 	{
 		uint8 v0 = *(blockData + 0);
@@ -679,31 +733,9 @@ public:
 	}
 };
 
-class TextureDecoder_R4_G4_B4_A4_UNORM : public TextureDecoder, public SingletonClass<TextureDecoder_R4_G4_B4_A4_UNORM>
+class TextureDecoder_R4_G4_B4_A4_UNORM : public TextureDecoder_PackedTexel<PackedTexelConv::R4_G4_B4_A4_SWAPPED>, public SingletonClass<TextureDecoder_R4_G4_B4_A4_UNORM>
 {
 public:
-	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
-	{
-		return 2;
-	}
-
-	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
-	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-		{
-			sint32 yc = y;
-			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-			{
-				uint8* blockData = LatteTextureLoader_GetInput(textureLoader, x, y);
-				sint32 pixelOffset = (x + yc * textureLoader->width) * 2;
-				uint8 v0 = (*(uint8*)(blockData + 0));
-				uint8 v1 = (*(uint8*)(blockData + 1));
-				*(uint8*)(outputData + pixelOffset + 0) = ((v1 >> 4) & 0xF) | ((v1 << 4) & 0xF0); // todo: Verify
-				*(uint8*)(outputData + pixelOffset + 1) = ((v0 >> 4) & 0xF) | ((v0 << 4) & 0xF0); // todo: Verify
-			}
-		}
-	}
-
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
 	{
 		uint8 v0 = *(blockData + 0);
@@ -724,44 +756,9 @@ public:
 };
 
 
-class TextureDecoder_R4G4B4A4_UNORM_To_RGBA8 : public TextureDecoder, public SingletonClass<TextureDecoder_R4G4B4A4_UNORM_To_RGBA8>
+class TextureDecoder_R4G4B4A4_UNORM_To_RGBA8 : public TextureDecoder_PackedTexel<PackedTexelConv::R4_G4_B4_A4_TO_RGBA8>, public SingletonClass<TextureDecoder_R4G4B4A4_UNORM_To_RGBA8>
 {
 public:
-	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
-	{
-		return 4;
-	}
-
-	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
-	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-		{
-			sint32 yc = y;
-			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-			{
-				uint8* blockData = LatteTextureLoader_GetInput(textureLoader, x, y);
-				sint32 pixelOffset = (x + yc * textureLoader->width) * 4;
-				uint8 v0 = (*(uint8*)(blockData + 0));
-				uint8 v1 = (*(uint8*)(blockData + 1));
-
-				uint8 red4 = (v0 & 0xF);
-				uint8 green4 = (v0 >> 4) & 0xF;
-				uint8 blue4 = (v1) & 0xF;
-				uint8 alpha4 = (v1 >> 4) & 0xF;
-
-				red4 = (red4 << 4) | red4;
-				green4 = (green4 << 4) | green4;
-				blue4 = (blue4 << 4) | blue4;
-				alpha4 = (alpha4 << 4) | alpha4;
-
-				*(uint8*)(outputData + pixelOffset + 0) = red4;
-				*(uint8*)(outputData + pixelOffset + 1) = green4;
-				*(uint8*)(outputData + pixelOffset + 2) = blue4;
-				*(uint8*)(outputData + pixelOffset + 3) = alpha4;
-			}
-		}
-	}
-
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
 	{
 		uint8 v0 = *(blockData + 0);
@@ -1029,49 +1026,9 @@ public:
 	}
 };
 
-class TextureDecoder_R5_G6_B5_swappedRB : public TextureDecoder, public SingletonClass<TextureDecoder_R5_G6_B5_swappedRB>
+class TextureDecoder_R5_G6_B5_swappedRB : public TextureDecoder_PackedTexel<PackedTexelConv::R5_G6_B5_SWAPPED_RB>, public SingletonClass<TextureDecoder_R5_G6_B5_swappedRB>
 {
 public:
-	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
-	{
-		return 2;
-	}
-
-	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
-	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-		{
-			sint32 yc = y;
-			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-			{
-				uint8* blockData = LatteTextureLoader_GetInput(textureLoader, x, y);
-				sint32 pixelOffset = (x + yc * textureLoader->width) * 2;
-				uint16 colorData = (*(uint16*)(blockData + 0));
-
-				// colorData >> 0 -> red
-				// colorData >> 5 -> green
-				// colorData >> 11 -> blue
-
-				colorData = ((colorData >> 11) & 0x1F) | (colorData & (0x3F << 5)) | ((colorData << 11) & (0x1F << 11));
-
-				//// swap order of components
-				////uint8 red5 = (colorData>>0)&0x1F;
-				////uint8 green5 = (colorData>>5)&0x1F;
-				////uint8 blue5 = (colorData>>10)&0x1F;
-				////uint8 alpha1 = (colorData>>15)&0x1;
-				////colorData = blue5|(green5<<5)|(red5<<10)|(alpha1<<15);
-				////*(uint16*)(outputData+pixelOffset+0) = colorData;
-				//uint8 red5 = (colorData >> 11) & 0x1F;
-				//uint8 green5 = (colorData >> 6) & 0x1F;
-				//uint8 blue5 = (colorData >> 1) & 0x1F;
-				//uint8 alpha1 = (colorData >> 0) & 0x1;
-				////colorData = blue5|(green5<<5)|(red5<<10)|(alpha1<<15);
-				////colorData = (blue5<<11)|(green5<<6)|(red5<<1)|(alpha1<<0);
-				* (uint16*)(outputData + pixelOffset + 0) = colorData;
-			}
-		}
-	}
-
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
 	{
 		uint16 colorData = (*(uint16*)blockData);
@@ -1085,50 +1042,18 @@ public:
 	}
 };
 
-class TextureDecoder_R5G6B5_UNORM_To_RGBA8 : public TextureDecoder, public SingletonClass<TextureDecoder_R5G6B5_UNORM_To_RGBA8>
+class TextureDecoder_R5G6B5_UNORM_To_RGBA8 : public TextureDecoder_PackedTexel<PackedTexelConv::R5_G6_B5_TO_RGBA8>, public SingletonClass<TextureDecoder_R5G6B5_UNORM_To_RGBA8>
 {
 public:
-	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
-	{
-		return 4;
-	}
-
-	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
-	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-		{
-			sint32 yc = y;
-			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-			{
-				uint8* blockData = LatteTextureLoader_GetInput(textureLoader, x, y);
-				sint32 pixelOffset = (x + yc * textureLoader->width) * 4;
-				uint16 v0 = (*(uint16*)(blockData + 0));
-
-				uint8 c0 = (v0 & 0x1F);
-				uint8 c1 = (v0 >> 5) & 0x3F;
-				uint8 c2 = (v0 >> 11) & 0x1F;
-
-				c0 = (c0 << 3) | c0 >> 3;// blue
-				c1 = (c1 << 2) | c1 >> 4;// green
-				c2 = (c2 << 3) | c2 >> 3;// red
-
-				*(uint8*)(outputData + pixelOffset + 0) = c0;// blue
-				*(uint8*)(outputData + pixelOffset + 1) = c1;// green
-				*(uint8*)(outputData + pixelOffset + 2) = c2;// red
-				*(uint8*)(outputData + pixelOffset + 3) = 255;//alpha
-			}
-		}
-	}
-
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
 	{
 		uint16 v0 = *(uint16*)(blockData + 0);
 		uint8 c0 = (v0 & 0x1F);// red
 		uint8 c1 = (v0 >> 5) & 0x3F;// green
 		uint8 c2 = (v0 >> 11) & 0x1F; // blue
-		c0 = (c0 << 3) | c0 >> 3;
+		c0 = (c0 << 3) | c0 >> 2;
 		c1 = (c1 << 2) | c1 >> 4;
-		c2 = (c2 << 3) | c2 >> 3;
+		c2 = (c2 << 3) | c2 >> 2;
 		*(outputPixel + 0) = c0;// red
 		*(outputPixel + 1) = c1;// green
 		*(outputPixel + 2) = c2;// blue
@@ -1163,32 +1088,9 @@ public:
 	}
 };
 
-class uint16_R5_G5_B5_A1_swapRB
+class TextureDecoder_R5_G5_B5_A1_UNORM_swappedRB : public TextureDecoder_PackedTexel<PackedTexelConv::R5_G5_B5_A1_SWAPPED_RB>, public SingletonClass<TextureDecoder_R5_G5_B5_A1_UNORM_swappedRB>
 {
 public:
-	void operator=(const uint16_R5_G5_B5_A1_swapRB& v)
-	{
-		internalVal = ((v.internalVal >> 10) & (0x1F << 0)) | ((v.internalVal << 10) & (0x1F << 10)) | (v.internalVal & ((0x1F << 5) | 0x8000));
-	}
-
-	uint16 internalVal;
-};
-
-static_assert(sizeof(uint16_R5_G5_B5_A1_swapRB) == 2);
-
-class TextureDecoder_R5_G5_B5_A1_UNORM_swappedRB : public TextureDecoder, public SingletonClass<TextureDecoder_R5_G5_B5_A1_UNORM_swappedRB>
-{
-public:
-	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
-	{
-		return 2;
-	}
-
-	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
-	{
-		optimizedDecodeLoops<uint16_R5_G5_B5_A1_swapRB, 1, false, false>(textureLoader, outputData);
-	}
-
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
 	{
 		uint16 colorData = (*(uint16*)blockData);
@@ -1203,43 +1105,9 @@ public:
 	}
 };
 
-class TextureDecoder_R5_G5_B5_A1_UNORM_swappedRB_To_RGBA8 : public TextureDecoder, public SingletonClass<TextureDecoder_R5_G5_B5_A1_UNORM_swappedRB_To_RGBA8>
+class TextureDecoder_R5_G5_B5_A1_UNORM_swappedRB_To_RGBA8 : public TextureDecoder_PackedTexel<PackedTexelConv::R5_G5_B5_A1_TO_RGBA8>, public SingletonClass<TextureDecoder_R5_G5_B5_A1_UNORM_swappedRB_To_RGBA8>
 {
 public:
-//2656
-    sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
-    {
-        return 4;
-    }
-
-    void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
-    {
-        for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-        {
-            sint32 yc = y;
-            for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-            {
-                uint16* blockData = (uint16*)LatteTextureLoader_GetInput(textureLoader, x, y);
-                sint32 pixelOffset = (x + yc * textureLoader->width) * 4;
-                uint32 colorData = (*(uint16*)(blockData + 0));
-                // swap order of components
-                uint8 red = (colorData >> 0) & 0x1F;
-                uint8 green = (colorData >> 5) & 0x1F;
-                uint8 blue = (colorData >> 10) & 0x1F;
-                uint8 alpha = (colorData >> 15) & 0x1;
-
-                red = red << 3 | red >> 2;
-                green = green << 3 | green >> 2;
-                blue = blue << 3 | blue >> 2;
-                alpha = alpha * 0xff;
-
-                // MSB...LSB : ABGR
-                colorData = (alpha << 24) | (blue << 16) | (green << 8) | red;
-                *(uint32*)(outputData + pixelOffset + 0) = colorData;
-            }
-        }
-    }
-
     void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
     {
         uint16 colorData = (*(uint16*)blockData);
@@ -1255,35 +1123,9 @@ public:
 
 };
 
-class uint16_R5_G5_B5_A1_swapOpenGL
+class TextureDecoder_R5_G5_B5_A1_UNORM_swappedOpenGL : public TextureDecoder_PackedTexel<PackedTexelConv::R5_G5_B5_A1_SWAPPED_OPENGL>, public SingletonClass<TextureDecoder_R5_G5_B5_A1_UNORM_swappedOpenGL>
 {
 public:
-	void operator=(const uint16_R5_G5_B5_A1_swapOpenGL& v)
-	{
-		uint16 red = (v.internalVal >> 0) & 0x1F;
-		uint16 green = (v.internalVal >> 5) & 0x1F;
-		uint16 blue = (v.internalVal >> 10) & 0x1F;
-		uint16 alpha = (v.internalVal >> 15) & 0x1;
-		internalVal = (red << 11) | (green << 6) | (blue << 1) | alpha;
-	}
-	uint16 internalVal;
-};
-
-static_assert(sizeof(uint16_R5_G5_B5_A1_swapOpenGL) == 2);
-
-class TextureDecoder_R5_G5_B5_A1_UNORM_swappedOpenGL : public TextureDecoder, public SingletonClass<TextureDecoder_R5_G5_B5_A1_UNORM_swappedOpenGL>
-{
-public:
-	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
-	{
-		return 2;
-	}
-
-	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
-	{
-		optimizedDecodeLoops<uint16_R5_G5_B5_A1_swapOpenGL, 1, false, false>(textureLoader, outputData);
-	}
-
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
 	{
 		uint16 colorData = (*(uint16*)blockData);
@@ -1325,35 +1167,9 @@ public:
 	}
 };
 
-class TextureDecoder_A1_B5_G5_R5_UNORM_vulkan : public TextureDecoder, public SingletonClass<TextureDecoder_A1_B5_G5_R5_UNORM_vulkan>
+class TextureDecoder_A1_B5_G5_R5_UNORM_vulkan : public TextureDecoder_PackedTexel<PackedTexelConv::A1_B5_G5_R5_TO_R5_G5_B5_A1>, public SingletonClass<TextureDecoder_A1_B5_G5_R5_UNORM_vulkan>
 {
 public:
-	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
-	{
-		return 2;
-	}
-
-	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
-	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-		{
-			sint32 yc = y;
-			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-			{
-				uint8* blockData = LatteTextureLoader_GetInput(textureLoader, x, y);
-				sint32 pixelOffset = (x + yc * textureLoader->width) * 2;
-				uint16 colorData = (*(uint16*)(blockData + 0));
-				// swap order of components
-				uint8 red5 = (colorData >> 11) & 0x1F;
-				uint8 green5 = (colorData >> 6) & 0x1F;
-				uint8 blue5 = (colorData >> 1) & 0x1F;
-				uint8 alpha1 = (colorData >> 0) & 0x1;
-				colorData = blue5 | (green5 << 5) | (red5 << 10) | (alpha1 << 15);
-				*(uint16*)(outputData + pixelOffset + 0) = colorData;
-			}
-		}
-	}
-
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
 	{
 		uint16 colorData = (*(uint16*)blockData);
@@ -1368,42 +1184,9 @@ public:
 	}
 };
 
-class TextureDecoder_A1_B5_G5_R5_UNORM_vulkan_To_RGBA8 : public TextureDecoder, public SingletonClass<TextureDecoder_A1_B5_G5_R5_UNORM_vulkan_To_RGBA8>
+class TextureDecoder_A1_B5_G5_R5_UNORM_vulkan_To_RGBA8 : public TextureDecoder_PackedTexel<PackedTexelConv::A1_B5_G5_R5_TO_RGBA8>, public SingletonClass<TextureDecoder_A1_B5_G5_R5_UNORM_vulkan_To_RGBA8>
 {
 public:
-    sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
-    {
-        return 4;
-    }
-
-    void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
-    {
-        for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-        {
-            sint32 yc = y;
-            for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-            {
-                uint16* blockData = (uint16*)LatteTextureLoader_GetInput(textureLoader, x, y);
-                sint32 pixelOffset = (x + yc * textureLoader->width) * 4;
-                uint32 colorData = (*(uint16*)(blockData + 0));
-                // swap order of components
-                uint8 red = (colorData >> 11) & 0x1F;
-                uint8 green = (colorData >> 6) & 0x1F;
-                uint8 blue = (colorData >> 1) & 0x1F;
-                uint8 alpha = (colorData >> 0) & 0x1;
-
-                red = red << 3 | red >> 2;
-                green = green << 3 | green >> 2;
-                blue = blue << 3 | blue >> 2;
-                alpha = alpha * 0xff;
-
-                // MSB...LSB ABGR
-                colorData = red | (green << 8) | (blue << 16) | (alpha << 24);
-                *(uint32*)(outputData + pixelOffset + 0) = colorData;
-            }
-        }
-    }
-
     void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
     {
         uint16 colorData = (*(uint16*)blockData);
@@ -2121,4 +1904,6 @@ public:
 		*(outputPixel + 2) = 0;
 		*(outputPixel + 3) = 255;
 	}
-};
\ No newline at end of file
+};
+
+TextureDecoder* LatteTextureLoader_GetDefaultDecoder(Latte::E_GX2SURFFMT format, bool isDepth, Latte::E_DIM dim, uint32 width, uint32 height);
@@ -7,6 +7,7 @@
 #include "Cafe/HW/Latte/Renderer/Renderer.h"
 #include "Cafe/HW/Latte/Core/LatteTexture.h"
 #include "Cafe/HW/Latte/Renderer/OpenGL/LatteTextureViewGL.h"
+#include "util/helpers/helpers.h"
 
 #define LOG_READBACK_TIME
 
@@ -19,6 +20,100 @@ struct LatteTextureReadbackQueueEntry
 
 std::vector<LatteTextureReadbackQueueEntry> sTextureScheduledReadbacks; // readbacks that have been queued but the actual transfer has not yet been started
 std::queue<LatteTextureReadbackInfo*> sTextureActiveReadbackQueue; // readbacks in flight
+std::deque<LatteTextureReadbackInfo*> sTextureWritingReadbackQueue; // transfer finished, data is being written to guest memory by the writer thread
+
+// tiling and writing of finished readbacks into guest memory is done on a separate thread so the Latte thread can continue processing commands
+// jobs are processed in order. The Latte thread releases the host data of a readback once the writer has passed it
+struct LatteTextureReadbackWriter
+{
+	std::mutex mutex;
+	std::condition_variable jobAvailable;
+	std::condition_variable jobFinished;
+	std::queue<std::pair<LatteTextureReadbackInfo*, uint8*>> jobs;
+	uint64 numQueuedJobs{};
+	uint64 numFinishedJobs{};
+	bool isThreadRunning{};
+};
+LatteTextureReadbackWriter& sReadbackWriter = *new LatteTextureReadbackWriter(); // never destroyed, the detached writer thread may wait on it until the process exits
+
+void LatteTextureReadback_WriterThread()
+{
+	SetThreadName("TexReadback");
+	std::unique_lock _l(sReadbackWriter.mutex);
+	while (true)
+	{
+		sReadbackWriter.jobAvailable.wait(_l, []() { return !sReadbackWriter.jobs.empty(); });
+		auto [readbackInfo, pixelData] = sReadbackWriter.jobs.front();
+		sReadbackWriter.jobs.pop();
+		_l.unlock();
+		LatteTextureLoader_writeReadbackTextureToMemory(&readbackInfo->hostTextureCopy, 0, 0, pixelData);
+		_l.lock();
+		sReadbackWriter.numFinishedJobs++;
+		sReadbackWriter.jobFinished.notify_all();
+	}
+}
+
+void LatteTextureReadback_QueueMemoryWrite(LatteTextureReadbackInfo* readbackInfo)
+{
+	uint8* pixelData = readbackInfo->GetData();
+	std::unique_lock _l(sReadbackWriter.mutex);
+	if (!sReadbackWriter.isThreadRunning)
+	{
+		std::thread(LatteTextureReadback_WriterThread).detach();
+		sReadbackWriter.isThreadRunning = true;
+	}
+	sReadbackWriter.jobs.emplace(readbackInfo, pixelData);
+	sReadbackWriter.numQueuedJobs++;
+	_l.unlock();
+	sReadbackWriter.jobAvailable.notify_one();
+	sTextureWritingReadbackQueue.emplace_back(readbackInfo);
+}
+
+// releases readbacks whose data has been written to guest memory. If waitForAll is set, blocks until the writer thread is idle
+void LatteTextureReadback_FinishMemoryWrites(bool waitForAll)
+{
+	if (sTextureWritingReadbackQueue.empty())
+		return;
+	std::unique_lock _l(sReadbackWriter.mutex);
+	if (waitForAll)
+		sReadbackWriter.jobFinished.wait(_l, []() { return sReadbackWriter.numFinishedJobs == sReadbackWriter.numQueuedJobs; });
+	size_t numWritten = sTextureWritingReadbackQueue.size() - (size_t)(sReadbackWriter.numQueuedJobs - sReadbackWriter.numFinishedJobs);
+	_l.unlock();
+	for (size_t i = 0; i < numWritten; i++)
+	{
+		LatteTextureReadbackInfo* readbackInfo = sTextureWritingReadbackQueue.front();
+		sTextureWritingReadbackQueue.pop_front();
+		readbackInfo->ReleaseData();
+		// get the original texture if it still exists and invalidate the current data hash
+		LatteTextureView* origTexView = LatteTextureViewLookupCache::lookupSlice(readbackInfo->hostTextureCopy.physAddress, readbackInfo->hostTextureCopy.width, readbackInfo->hostTextureCopy.height, readbackInfo->hostTextureCopy.pitch, 0, 0, readbackInfo->hostTextureCopy.format);
+		if (origTexView)
+			LatteTC_ResetTextureChangeTracker(origTexView->baseTexture, true);
+		delete readbackInfo;
+	}
+}
+
+/*
+ * Returns true if a finished readback is still being written to the given address
+ * Texture data at this address should not be hashed or reloaded until the write is done
+ */
+bool LatteTextureReadback_IsMemoryWritePending(MPTR physAddress)
+{
+	for (auto& readbackInfo : sTextureWritingReadbackQueue)
+	{
+		if (readbackInfo->hostTextureCopy.physAddress == physAddress)
+			return true;
+	}
+	return false;
+}
+
+/*
+ * Blocks until all queued guest memory writes are done
+ * Used before the guest can observe GPU progress (EOP timestamps, wait-reg-mem) and before host-side readback buffers are reused
+ */
+void LatteTextureReadback_WaitForMemoryWrites()
+{
+	LatteTextureReadback_FinishMemoryWrites(true);
+}
 
 void LatteTextureReadback_StartTransfer(LatteTextureView* textureView)
 {
@@ -147,18 +242,13 @@ void LatteTextureReadback_UpdateFinishedTransfers(bool forceFinish)
 			cemuLog_log(LogType::TextureReadback, "[Texture-Readback] {:08x} Res {}/{} TM {} FMT {:04x} ReadbackLatency: {:6.3}ms WaitTime: {:6.3}ms ForcedWait {}", readbackInfo->hostTextureCopy.physAddress, readbackInfo->hostTextureCopy.width, readbackInfo->hostTextureCopy.height, readbackInfo->hostTextureCopy.tileMode, (uint32)readbackInfo->hostTextureCopy.format, elapsedSecondsTransfer * 1000.0, elapsedSecondsWaiting * 1000.0, readbackInfo->forceFinish ? "yes" : "no");
 		}
 #endif
-		uint8* pixelData = readbackInfo->GetData();
-		LatteTextureLoader_writeReadbackTextureToMemory(&readbackInfo->hostTextureCopy, 0, 0, pixelData);
-		readbackInfo->ReleaseData();
-		// get the original texture if it still exists and invalidate the current data hash
-		LatteTextureView* origTexView = LatteTextureViewLookupCache::lookupSlice(readbackInfo->hostTextureCopy.physAddress, readbackInfo->hostTextureCopy.width, readbackInfo->hostTextureCopy.height, readbackInfo->hostTextureCopy.pitch, 0, 0, readbackInfo->hostTextureCopy.format);
-		if (origTexView)
-			LatteTC_ResetTextureChangeTracker(origTexView->baseTexture, true);
-		delete readbackInfo;
 		// remove from queue
 		cemu_assert_debug(!sTextureActiveReadbackQueue.empty());
 		cemu_assert_debug(readbackInfo == sTextureActiveReadbackQueue.front());
 		sTextureActiveReadbackQueue.pop();
+		LatteTextureReadback_QueueMemoryWrite(readbackInfo);
 	}
+	// when forced the guest is about to observe the results, all writes have to be completed
+	LatteTextureReadback_FinishMemoryWrites(forceFinish);
 	performanceMonitor.gpuTime_waitForAsync.endMeasuring();
 }
@@ -4,6 +4,7 @@
 #include "Cafe/HW/Latte/Core/LatteDraw.h"
 #include "Cafe/HW/Latte/Core/LatteShader.h"
 #include "Cafe/HW/Latte/Core/LatteAsyncCommands.h"
+#include "Cafe/HW/Latte/Core/LatteCapture.h"
 #include "Cafe/GameProfile/GameProfile.h"
 #include "Cafe/GraphicPack/GraphicPack2.h"
 #include "WindowSystem.h"
@@ -32,6 +33,7 @@ void Latte_LoadInitialRegisters()
 	LatteGPUState.contextNew.VGT_MULTI_PRIM_IB_RESET_INDX.set_RESTART_INDEX(0xFFFFFFFF);
 	LatteGPUState.contextRegister[Latte::REGADDR::PA_CL_CLIP_CNTL] = 0;
 	*(float*)&LatteGPUState.contextRegister[mmDB_DEPTH_CLEAR] = 1.0f;
+	LatteReg_markAllWritten();
 }
 
 extern bool gx2WriteGatherInited;
@@ -161,7 +163,7 @@ int Latte_ThreadEntry()
 	// wait till a game is started
 	while( true )
 	{
-		if( CafeSystem::IsTitleRunning() )
+		if( CafeSystem::IsTitleRunning() || LatteReplay_IsActive() )
 			break;
 
 		g_renderer->DrawEmptyFrame(true);
@@ -172,6 +174,15 @@ int Latte_ThreadEntry()
 
 	g_renderer->DrawEmptyFrame(true);
 
+	if (LatteReplay_IsActive())
+	{
+		// replaying a GPU capture. There is no title, graphic packs or shader cache and the CPU side is not running
+		LatteReplay_LoadInitialState();
+		g_isGPUInitFinished = true;
+		LatteCP_ProcessRingbuffer();
+		cemu_assert_debug(false); // should never reach
+	}
+
 	// before doing anything with game specific shaders, we need to wait for graphic packs to finish loading
 	GraphicPack2::WaitUntilReady();
 	// if legacy packs are enabled we cannot use the colorbuffer resolution optimization
@@ -1055,20 +1055,30 @@ void _LatteDecompiler_GenerateDataForFastAccess(LatteDecompilerShader* shader)
 
 void _LatteDecompiler_Process(LatteDecompilerShaderContext* shaderContext, uint8* programData, uint32 programSize)
 {
+	auto& stageTimings = shaderContext->output->stageTimings;
+	HRTick t0 = HighResolutionTimer::now().getTick();
 	// parse control flow instructions
 	if (shaderContext->shader->hasError == false)
 		LatteDecompiler_ParseCF(shaderContext, programData, programSize);
+	HRTick t1 = HighResolutionTimer::now().getTick();
 	// parse individual clauses
 	if (shaderContext->shader->hasError == false)
 		LatteDecompiler_ParseClauses(shaderContext, programData, programSize);
+	HRTick t2 = HighResolutionTimer::now().getTick();
 	// analyze
 	if (shaderContext->shader->hasError == false)
 		LatteDecompiler_analyze(shaderContext, shaderContext->shader);
 	if (shaderContext->shader->hasError == false)
 		LatteDecompiler_analyzeDataTypes(shaderContext);
+	HRTick t3 = HighResolutionTimer::now().getTick();
 	// emit code
 	if (shaderContext->shader->hasError == false)
 		LatteDecompiler_emitGLSLShader(shaderContext, shaderContext->shader);
+	HRTick t4 = HighResolutionTimer::now().getTick();
+	stageTimings.parseCF = t1 - t0;
+	stageTimings.parseClauses = t2 - t1;
+	stageTimings.analyze = t3 - t2;
+	stageTimings.emitGLSL = t4 - t3;
 	LatteDecompiler_cleanup(shaderContext);
 	// fast access 
 	_LatteDecompiler_GenerateDataForFastAccess(shaderContext->shader);
@@ -1097,6 +1107,7 @@ void LatteDecompiler_DecompileVertexShader(uint64 shaderBaseHash, uint32* contex
 	// prepare shader (deprecated)
 	LatteDecompilerShader* shader = new LatteDecompilerShader(LatteConst::ShaderType::Vertex);
 	shader->compatibleFetchShader = shaderContext.fetchShader;
+	shader->hostEndianVertexBufferMask = options.hostEndianVertexBufferMask;
 	output->shaderType = LatteConst::ShaderType::Vertex;
 	shaderContext.shader = shader;
 	output->shader = shader;
@@ -157,6 +157,7 @@ struct LatteDecompilerShader
 	uint64 auxHash{0};
 	// vertex shader
 	struct LatteFetchShader* compatibleFetchShader{};
+	uint16 hostEndianVertexBufferMask{};
 	// error tracking
 	bool hasError{false}; // if set, the shader cannot be used
 	// compact resource lists for optimized access
@@ -260,6 +261,8 @@ struct LatteDecompilerOptions
 	bool usesGeometryShader{ false };
 	// floating point math
 	bool strictMul{}; // if true, 0*anything=0 rule is emulated
+	// vertex buffers which are already converted to host endianness, attribute decoding skips the byte swap for these
+	uint16 hostEndianVertexBufferMask{};
 	// Vulkan-specific
 	bool useTFViaSSBO{ false };
 	struct  
@@ -286,6 +289,15 @@ struct LatteDecompilerOutput_t
 	// mapping and binding information
 	LatteDecompilerShaderResourceMapping resourceMappingGL;
 	LatteDecompilerShaderResourceMapping resourceMappingVK;
+
+	// time spent in each decompiler stage (HRTick), used for benchmarking
+	struct
+	{
+		uint64 parseCF{};
+		uint64 parseClauses{};
+		uint64 analyze{};
+		uint64 emitGLSL{};
+	}stageTimings;
 };
 
 struct LatteDecompilerSubroutineInfo;
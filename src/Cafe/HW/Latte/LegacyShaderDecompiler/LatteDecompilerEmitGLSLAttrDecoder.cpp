@@ -40,57 +40,64 @@ void _readLittleEndianAttributeU16x4(LatteDecompilerShader* shaderContext, Strin
 	src->addFmt("attrDecoder = attrDataSem{};" _CRLF, attributeInputIndex);
 }
 
-void _readBigEndianAttributeU32x4(LatteDecompilerShader* shaderContext, StringBuf* src, uint32 attributeInputIndex)
+void _readBigEndianAttributeU32x4(LatteDecompilerShader* shaderContext, StringBuf* src, uint32 attributeInputIndex, bool isHostEndian)
 {
 	src->addFmt("attrDecoder = attrDataSem{};" _CRLF, attributeInputIndex);
-	src->add("attrDecoder = (attrDecoder>>24)|((attrDecoder>>8)&0xFF00)|((attrDecoder<<8)&0xFF0000)|((attrDecoder<<24));" _CRLF);
+	if (!isHostEndian)
+		src->add("attrDecoder = (attrDecoder>>24)|((attrDecoder>>8)&0xFF00)|((attrDecoder<<8)&0xFF0000)|((attrDecoder<<24));" _CRLF);
 }
 
-void _readBigEndianAttributeU32x3(LatteDecompilerShader* shaderContext, StringBuf* src, uint32 attributeInputIndex)
+void _readBigEndianAttributeU32x3(LatteDecompilerShader* shaderContext, StringBuf* src, uint32 attributeInputIndex, bool isHostEndian)
 {
 	src->addFmt("attrDecoder.xyz = attrDataSem{}.xyz;" _CRLF, attributeInputIndex);
-	src->add("attrDecoder.xyz = (attrDecoder.xyz>>24)|((attrDecoder.xyz>>8)&0xFF00)|((attrDecoder.xyz<<8)&0xFF0000)|((attrDecoder.xyz<<24));" _CRLF);
+	if (!isHostEndian)
+		src->add("attrDecoder.xyz = (attrDecoder.xyz>>24)|((attrDecoder.xyz>>8)&0xFF00)|((attrDecoder.xyz<<8)&0xFF0000)|((attrDecoder.xyz<<24));" _CRLF);
 	src->add("attrDecoder.w = 0;" _CRLF);
 }
 
-void _readBigEndianAttributeU32x2(LatteDecompilerShader* shaderContext, StringBuf* src, uint32 attributeInputIndex)
+void _readBigEndianAttributeU32x2(LatteDecompilerShader* shaderContext, StringBuf* src, uint32 attributeInputIndex, bool isHostEndian)
 {
 	src->addFmt("attrDecoder.xy = attrDataSem{}.xy;" _CRLF, attributeInputIndex);
-	src->add("attrDecoder.xy = (attrDecoder.xy>>24)|((attrDecoder.xy>>8)&0xFF00)|((attrDecoder.xy<<8)&0xFF0000)|((attrDecoder.xy<<24));" _CRLF);
+	if (!isHostEndian)
+		src->add("attrDecoder.xy = (attrDecoder.xy>>24)|((attrDecoder.xy>>8)&0xFF00)|((attrDecoder.xy<<8)&0xFF0000)|((attrDecoder.xy<<24));" _CRLF);
 	src->add("attrDecoder.z = 0;" _CRLF);
 	src->add("attrDecoder.w = 0;" _CRLF);
 }
 
-void _readBigEndianAttributeU32x1(LatteDecompilerShader* shaderContext, StringBuf* src, uint32 attributeInputIndex)
+void _readBigEndianAttributeU32x1(LatteDecompilerShader* shaderContext, StringBuf* src, uint32 attributeInputIndex, bool isHostEndian)
 {
 	src->addFmt("attrDecoder.x = attrDataSem{}.x;" _CRLF, attributeInputIndex);
-	src->add("attrDecoder.x = (attrDecoder.x>>24)|((attrDecoder.x>>8)&0xFF00)|((attrDecoder.x<<8)&0xFF0000)|((attrDecoder.x<<24));" _CRLF);
+	if (!isHostEndian)
+		src->add("attrDecoder.x = (attrDecoder.x>>24)|((attrDecoder.x>>8)&0xFF00)|((attrDecoder.x<<8)&0xFF0000)|((attrDecoder.x<<24));" _CRLF);
 	src->add("attrDecoder.y = 0;" _CRLF);
 	src->add("attrDecoder.z = 0;" _CRLF);
 	src->add("attrDecoder.w = 0;" _CRLF);
 }
 
-void _readBigEndianAttributeU16x1(LatteDecompilerShader* shaderContext, StringBuf* src, uint32 attributeInputIndex)
+void _readBigEndianAttributeU16x1(LatteDecompilerShader* shaderContext, StringBuf* src, uint32 attributeInputIndex, bool isHostEndian)
 {
 	src->addFmt("attrDecoder.xy = attrDataSem{}.xy;" _CRLF, attributeInputIndex);
-	src->add("attrDecoder.x = ((attrDecoder.x>>8)&0xFF)|((attrDecoder.x<<8)&0xFF00);" _CRLF);
+	if (!isHostEndian)
+		src->add("attrDecoder.x = ((attrDecoder.x>>8)&0xFF)|((attrDecoder.x<<8)&0xFF00);" _CRLF);
 	src->add("attrDecoder.y = 0;" _CRLF);
 	src->add("attrDecoder.z = 0;" _CRLF);
 	src->add("attrDecoder.w = 0;" _CRLF);
 }
 
-void _readBigEndianAttributeU16x2(LatteDecompilerShader* shaderContext, StringBuf* src, uint32 attributeInputIndex)
+void _readBigEndianAttributeU16x2(LatteDecompilerShader* shaderContext, StringBuf* src, uint32 attributeInputIndex, bool isHostEndian)
 {
 	src->addFmt("attrDecoder.xy = attrDataSem{}.xy;" _CRLF, attributeInputIndex);
-	src->add("attrDecoder.xy = ((attrDecoder.xy>>8)&0xFF)|((attrDecoder.xy<<8)&0xFF00);" _CRLF);
+	if (!isHostEndian)
+		src->add("attrDecoder.xy = ((attrDecoder.xy>>8)&0xFF)|((attrDecoder.xy<<8)&0xFF00);" _CRLF);
 	src->add("attrDecoder.z = 0;" _CRLF);
 	src->add("attrDecoder.w = 0;" _CRLF);
 }
 
-void _readBigEndianAttributeU16x4(LatteDecompilerShader* shaderContext, StringBuf* src, uint32 attributeInputIndex)
+void _readBigEndianAttributeU16x4(LatteDecompilerShader* shaderContext, StringBuf* src, uint32 attributeInputIndex, bool isHostEndian)
 {
 	src->addFmt("attrDecoder.xyzw = attrDataSem{}.xyzw;" _CRLF, attributeInputIndex);
-	src->add("attrDecoder = ((attrDecoder>>8)&0xFF)|((attrDecoder<<8)&0xFF00);" _CRLF);
+	if (!isHostEndian)
+		src->add("attrDecoder = ((attrDecoder>>8)&0xFF)|((attrDecoder<<8)&0xFF00);" _CRLF);
 }
 
 void LatteDecompiler_emitAttributeDecodeGLSL(LatteDecompilerShader* shaderContext, StringBuf* src, LatteParsedFetchShaderAttribute_t* attrib)
@@ -102,27 +109,30 @@ void LatteDecompiler_emitAttributeDecodeGLSL(LatteDecompilerShader* shaderContex
 	}
 
 	uint32 attributeInputIndex = attrib->semanticId;
+	// vertex data of this buffer was already byte swapped on the CPU (see LatteBufferCache_retrieveVertexStreamInCache)
+	bool isHostEndian = ((shaderContext->hostEndianVertexBufferMask >> attrib->attributeBufferIndex) & 1) != 0;
+	const char* swizzleU32 = isHostEndian ? "xyzw" : "wzyx";
 	if( attrib->endianSwap == LatteConst::VertexFetchEndianMode::SWAP_U32 )
 	{
 		if( attrib->format == FMT_32_32_32_32_FLOAT && attrib->nfa == 2 )
 		{
-			_readBigEndianAttributeU32x4(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU32x4(shaderContext, src, attributeInputIndex, isHostEndian);
 		}
 		else if( attrib->format == FMT_32_32_32_FLOAT && attrib->nfa == 2 )
 		{
-			_readBigEndianAttributeU32x3(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU32x3(shaderContext, src, attributeInputIndex, isHostEndian);
 		}
 		else if( attrib->format == FMT_32_32_FLOAT && attrib->nfa == 2 )
 		{
-			_readBigEndianAttributeU32x2(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU32x2(shaderContext, src, attributeInputIndex, isHostEndian);
 		}
 		else if( attrib->format == FMT_32_FLOAT && attrib->nfa == 2 )
 		{
-			_readBigEndianAttributeU32x1(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU32x1(shaderContext, src, attributeInputIndex, isHostEndian);
 		}
 		else if( attrib->format == FMT_2_10_10_10 && attrib->nfa == 0 )
 		{
-			_readBigEndianAttributeU32x1(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU32x1(shaderContext, src, attributeInputIndex, isHostEndian);
 			// Bayonetta 2 uses this format to store normals
 			src->add("attrDecoder.xyzw = uvec4((attrDecoder.x>>0)&0x3FF,(attrDecoder.x>>10)&0x3FF,(attrDecoder.x>>20)&0x3FF,(attrDecoder.x>>30)&0x3);" _CRLF);
 			if (attrib->isSigned != 0)
@@ -145,34 +155,34 @@ void LatteDecompiler_emitAttributeDecodeGLSL(LatteDecompilerShader* shaderContex
 		}
 		else if( attrib->format == FMT_32_32_32_32 && attrib->nfa == 1 && attrib->isSigned == 0 )
 		{
-			_readBigEndianAttributeU32x4(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU32x4(shaderContext, src, attributeInputIndex, isHostEndian);
 		}
 		else if( attrib->format == FMT_32_32_32 && attrib->nfa == 1 && attrib->isSigned == 0 )
 		{
-			_readBigEndianAttributeU32x3(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU32x3(shaderContext, src, attributeInputIndex, isHostEndian);
 		}
 		else if( attrib->format == FMT_32_32 && attrib->nfa == 1 && attrib->isSigned == 0 )
 		{
-			_readBigEndianAttributeU32x2(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU32x2(shaderContext, src, attributeInputIndex, isHostEndian);
 		}
 		else if (attrib->format == FMT_32 && attrib->nfa == 1 && attrib->isSigned == 0)
 		{
-			_readBigEndianAttributeU32x1(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU32x1(shaderContext, src, attributeInputIndex, isHostEndian);
 		}
 		else if (attrib->format == FMT_32 && attrib->nfa == 1 && attrib->isSigned == 1)
 		{
 			// we can just read the signed s32 as a u32 since no sign-extension is necessary
-			_readBigEndianAttributeU32x1(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU32x1(shaderContext, src, attributeInputIndex, isHostEndian);
 		}
 		else if( attrib->format == FMT_8_8_8_8 && attrib->nfa == 0 && attrib->isSigned == 0 )
 		{
 			// seen in Minecraft Wii U Edition
-			src->addFmt("attrDecoder.xyzw = floatBitsToUint(vec4(attrDataSem{}.wzyx)/255.0);" _CRLF, attributeInputIndex);
+			src->addFmt("attrDecoder.xyzw = floatBitsToUint(vec4(attrDataSem{}.{})/255.0);" _CRLF, attributeInputIndex, swizzleU32);
 		}
 		else if( attrib->format == FMT_8_8_8_8 && attrib->nfa == 0 && attrib->isSigned != 0 )
 		{
 			// seen in Minecraft Wii U Edition
-			src->addFmt("attrDecoder.xyzw = attrDataSem{}.wzyx;" _CRLF, attributeInputIndex);
+			src->addFmt("attrDecoder.xyzw = attrDataSem{}.{};" _CRLF, attributeInputIndex, swizzleU32);
 			src->add("if( (attrDecoder.x&0x80) != 0 ) attrDecoder.x |= 0xFFFFFF00;" _CRLF); 
 			src->add("if( (attrDecoder.y&0x80) != 0 ) attrDecoder.y |= 0xFFFFFF00;" _CRLF); 
 			src->add("if( (attrDecoder.z&0x80) != 0 ) attrDecoder.z |= 0xFFFFFF00;" _CRLF); 
@@ -185,12 +195,12 @@ void LatteDecompiler_emitAttributeDecodeGLSL(LatteDecompilerShader* shaderContex
 		else if( attrib->format == FMT_8_8_8_8 && attrib->nfa == 1 && attrib->isSigned == 0 )
 		{
 			// seen in Minecraft Wii U Edition
-			src->addFmt("attrDecoder.xyzw = attrDataSem{}.wzyx;" _CRLF, attributeInputIndex);
+			src->addFmt("attrDecoder.xyzw = attrDataSem{}.{};" _CRLF, attributeInputIndex, swizzleU32);
 		}
 		else if (attrib->format == FMT_8_8_8_8 && attrib->nfa == 2 && attrib->isSigned == 0)
 		{
 			// seen in Ben 10 Omniverse
-			src->addFmt("attrDecoder.xyzw = floatBitsToUint(vec4(attrDataSem{}.wzyx));" _CRLF, attributeInputIndex);
+			src->addFmt("attrDecoder.xyzw = floatBitsToUint(vec4(attrDataSem{}.{}));" _CRLF, attributeInputIndex, swizzleU32);
 		}
 		else
 		{
@@ -390,12 +400,12 @@ void LatteDecompiler_emitAttributeDecodeGLSL(LatteDecompilerShader* shaderContex
 	{
 		if( attrib->format == FMT_16_16_16_16_FLOAT && attrib->nfa == 2 )
 		{
-			_readBigEndianAttributeU16x4(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x4(shaderContext, src, attributeInputIndex, isHostEndian);
 			src->add("attrDecoder.xyzw = floatBitsToInt(vec4(unpackHalf2x16(attrDecoder.x|(attrDecoder.y<<16)),unpackHalf2x16(attrDecoder.z|(attrDecoder.w<<16))));" _CRLF);
 		}
 		else if (attrib->format == FMT_16_16_16_16 && attrib->nfa == 0 && attrib->isSigned != 0)
 		{
-			_readBigEndianAttributeU16x4(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x4(shaderContext, src, attributeInputIndex, isHostEndian);
 			src->add("if( (attrDecoder.x&0x8000) != 0 ) attrDecoder.x |= 0xFFFF0000;" _CRLF);
 			src->add("if( (attrDecoder.y&0x8000) != 0 ) attrDecoder.y |= 0xFFFF0000;" _CRLF);
 			src->add("if( (attrDecoder.z&0x8000) != 0 ) attrDecoder.z |= 0xFFFF0000;" _CRLF);
@@ -408,7 +418,7 @@ void LatteDecompiler_emitAttributeDecodeGLSL(LatteDecompilerShader* shaderContex
 		else if (attrib->format == FMT_16_16_16_16 && attrib->nfa == 0 && attrib->isSigned == 0)
 		{
 			// seen in BotW
-			_readBigEndianAttributeU16x4(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x4(shaderContext, src, attributeInputIndex, isHostEndian);
 			src->add("attrDecoder.x = floatBitsToUint(float(int(attrDecoder.x))/65535.0);" _CRLF);
 			src->add("attrDecoder.y = floatBitsToUint(float(int(attrDecoder.y))/65535.0);" _CRLF);
 			src->add("attrDecoder.z = floatBitsToUint(float(int(attrDecoder.z))/65535.0);" _CRLF);
@@ -417,7 +427,7 @@ void LatteDecompiler_emitAttributeDecodeGLSL(LatteDecompilerShader* shaderContex
 		else if( attrib->format == FMT_16_16_16_16 && attrib->nfa == 2 && attrib->isSigned != 0 )
 		{
 			// seen in Minecraft Wii U Edition
-			_readBigEndianAttributeU16x4(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x4(shaderContext, src, attributeInputIndex, isHostEndian);
 			src->add("if( (attrDecoder.x&0x8000) != 0 ) attrDecoder.x |= 0xFFFF0000;" _CRLF); 
 			src->add("if( (attrDecoder.y&0x8000) != 0 ) attrDecoder.y |= 0xFFFF0000;" _CRLF); 
 			src->add("if( (attrDecoder.z&0x8000) != 0 ) attrDecoder.z |= 0xFFFF0000;" _CRLF); 
@@ -430,7 +440,7 @@ void LatteDecompiler_emitAttributeDecodeGLSL(LatteDecompilerShader* shaderContex
 		else if( attrib->format == FMT_16_16_16_16 && attrib->nfa == 1 && attrib->isSigned != 0 )
 		{
 			// seen in Minecraft Wii U Edition
-			_readBigEndianAttributeU16x4(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x4(shaderContext, src, attributeInputIndex, isHostEndian);
 			src->add("if( (attrDecoder.x&0x8000) != 0 ) attrDecoder.x |= 0xFFFF0000;" _CRLF); 
 			src->add("if( (attrDecoder.y&0x8000) != 0 ) attrDecoder.y |= 0xFFFF0000;" _CRLF); 
 			src->add("if( (attrDecoder.z&0x8000) != 0 ) attrDecoder.z |= 0xFFFF0000;" _CRLF); 
@@ -438,23 +448,23 @@ void LatteDecompiler_emitAttributeDecodeGLSL(LatteDecompilerShader* shaderContex
 		}
 		else if( attrib->format == FMT_16_16_16_16 && attrib->nfa == 1 && attrib->isSigned == 0 )
 		{
-			_readBigEndianAttributeU16x4(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x4(shaderContext, src, attributeInputIndex, isHostEndian);
 		}
 		else if( attrib->format == FMT_16_16_FLOAT && attrib->nfa == 2 )
 		{
-			_readBigEndianAttributeU16x2(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x2(shaderContext, src, attributeInputIndex, isHostEndian);
 			src->add("attrDecoder.xy = floatBitsToUint(unpackHalf2x16(attrDecoder.x|(attrDecoder.y<<16)));" _CRLF);
 			src->add("attrDecoder.zw = uvec2(0);" _CRLF);
 		}
 		else if( attrib->format == FMT_16_16 && attrib->nfa == 0 && attrib->isSigned == 0 )
 		{
-			_readBigEndianAttributeU16x2(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x2(shaderContext, src, attributeInputIndex, isHostEndian);
 			src->add("attrDecoder.xy = floatBitsToUint(vec2(float(attrDecoder.x), float(attrDecoder.y))/65535.0);" _CRLF);
 			src->add("attrDecoder.zw = uvec2(0);" _CRLF);
 		}
 		else if( attrib->format == FMT_16_16 && attrib->nfa == 0 && attrib->isSigned != 0 )
 		{
-			_readBigEndianAttributeU16x2(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x2(shaderContext, src, attributeInputIndex, isHostEndian);
 			src->add("if( (attrDecoder.x&0x8000) != 0 ) attrDecoder.x |= 0xFFFF0000;" _CRLF); 
 			src->add("if( (attrDecoder.y&0x8000) != 0 ) attrDecoder.y |= 0xFFFF0000;" _CRLF); 
 			src->add("attrDecoder.x = floatBitsToUint(max(float(int(attrDecoder.x))/32767.0,-1.0));" _CRLF); 
@@ -463,24 +473,24 @@ void LatteDecompiler_emitAttributeDecodeGLSL(LatteDecompilerShader* shaderContex
 		}
 		else if( attrib->format == FMT_16_16 && attrib->nfa == 1 && attrib->isSigned == 0 )
 		{
-			_readBigEndianAttributeU16x2(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x2(shaderContext, src, attributeInputIndex, isHostEndian);
 		}
 		else if( attrib->format == FMT_16_16 && attrib->nfa == 1 && attrib->isSigned != 0 )
 		{
-			_readBigEndianAttributeU16x2(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x2(shaderContext, src, attributeInputIndex, isHostEndian);
 			src->add("if( (attrDecoder.x&0x8000) != 0 ) attrDecoder.x |= 0xFFFF0000;" _CRLF); 
 			src->add("if( (attrDecoder.y&0x8000) != 0 ) attrDecoder.y |= 0xFFFF0000;" _CRLF); 
 			src->add("attrDecoder.zw = uvec2(0);" _CRLF);
 		}
 		else if( attrib->format == FMT_16_16 && attrib->nfa == 2 && attrib->isSigned == 0 )
 		{
-			_readBigEndianAttributeU16x2(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x2(shaderContext, src, attributeInputIndex, isHostEndian);
 			src->add("attrDecoder.xy = floatBitsToUint(vec2(float(attrDecoder.x), float(attrDecoder.y)));" _CRLF);
 			src->add("attrDecoder.zw = uvec2(0);" _CRLF);
 		}
 		else if( attrib->format == FMT_16_16 && attrib->nfa == 2 && attrib->isSigned != 0 )
 		{
-			_readBigEndianAttributeU16x2(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x2(shaderContext, src, attributeInputIndex, isHostEndian);
 			src->add("if( (attrDecoder.x&0x8000) != 0 ) attrDecoder.x |= 0xFFFF0000;" _CRLF); 
 			src->add("if( (attrDecoder.y&0x8000) != 0 ) attrDecoder.y |= 0xFFFF0000;" _CRLF); 
 			src->add("attrDecoder.xy = floatBitsToUint(vec2(float(int(attrDecoder.x)), float(int(attrDecoder.y))));" _CRLF);
@@ -488,12 +498,12 @@ void LatteDecompiler_emitAttributeDecodeGLSL(LatteDecompilerShader* shaderContex
 		}
 		else if (attrib->format == FMT_16 && attrib->nfa == 1 && attrib->isSigned == 0)
 		{
-			_readBigEndianAttributeU16x1(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x1(shaderContext, src, attributeInputIndex, isHostEndian);
 		}
 		else if (attrib->format == FMT_16 && attrib->nfa == 0 && attrib->isSigned == 0)
 		{
 			// seen in CoD ghosts
-			_readBigEndianAttributeU16x1(shaderContext, src, attributeInputIndex);
+			_readBigEndianAttributeU16x1(shaderContext, src, attributeInputIndex, isHostEndian);
 			src->add("attrDecoder.x = floatBitsToUint(float(int(attrDecoder.x))/65535.0);" _CRLF);
 		}
 		else
@@ -0,0 +1,341 @@
+#include "Cafe/HW/Latte/Renderer/Null/NullRenderer.h"
+#include "Cafe/HW/Latte/Core/LatteShader.h"
+#include "Cafe/HW/Latte/Core/LatteIndices.h"
+#include "Cafe/HW/Latte/Core/LatteTexture.h"
+#include "Cafe/HW/Latte/Core/LatteTextureView.h"
+
+extern bool hasValidFramebufferAttached;
+
+void LatteDraw_handleSpecialState8_clearAsDepth();
+
+class LatteTextureViewNull : public LatteTextureView
+{
+public:
+	LatteTextureViewNull(LatteTexture* texture, Latte::E_DIM dim, Latte::E_GX2SURFFMT format, sint32 firstMip, sint32 mipCount, sint32 firstSlice, sint32 sliceCount)
+		: LatteTextureView(texture, firstMip, mipCount, firstSlice, sliceCount, dim, format) {}
+};
+
+class LatteTextureNull : public LatteTexture
+{
+public:
+	LatteTextureNull(Latte::E_DIM dim, MPTR physAddress, MPTR physMipAddress, Latte::E_GX2SURFFMT format, uint32 width, uint32 height, uint32 depth, uint32 pitch, uint32 mipLevels, uint32 swizzle, Latte::E_HWTILEMODE tileMode, bool isDepth)
+		: LatteTexture(dim, physAddress, physMipAddress, format, width, height, depth, pitch, mipLevels, swizzle, tileMode, isDepth) {}
+
+	~LatteTextureNull()
+	{
+		if (m_allocatedSize > 0)
+			NullRenderer::GetInstance()->NotifyTextureAllocation(-m_allocatedSize);
+	}
+
+	void AllocateOnHost() override
+	{
+		// estimate how much memory a GPU backend would allocate for this texture
+		if (m_allocatedSize > 0)
+			return;
+		uint64 numTexels = (uint64)width * height * depth;
+		if (Latte::IsCompressedFormat(format))
+			numTexels = (uint64)((width + 3) / 4) * ((height + 3) / 4) * depth; // bits are per 4x4 block
+		uint64 mipChainSize = std::max<uint64>(numTexels * Latte::GetFormatBits(format) / 8, 1);
+		if (mipLevels > 1)
+			mipChainSize = mipChainSize * 4 / 3;
+		m_allocatedSize = (sint64)mipChainSize;
+		NullRenderer::GetInstance()->NotifyTextureAllocation(m_allocatedSize);
+	}
+
+protected:
+	LatteTextureView* CreateView(Latte::E_DIM dim, Latte::E_GX2SURFFMT format, sint32 firstMip, sint32 mipCount, sint32 firstSlice, sint32 sliceCount) override
+	{
+		return new LatteTextureViewNull(this, dim, format, firstMip, mipCount, firstSlice, sliceCount);
+	}
+
+private:
+	sint64 m_allocatedSize{};
+};
+
+class LatteCachedFBONull : public LatteCachedFBO
+{
+public:
+	LatteCachedFBONull(uint64 key) : LatteCachedFBO(key) {}
+};
+
+class RendererShaderNull : public RendererShader
+{
+public:
+	RendererShaderNull(ShaderType type, uint64 baseHash, uint64 auxHash, bool isGameShader, bool isGfxPackShader)
+		: RendererShader(type, baseHash, auxHash, isGameShader, isGfxPackShader) {}
+
+	void PreponeCompilation(bool isRenderThread) override {}
+	bool IsCompiled() override { return true; }
+	bool WaitForCompiled() override { return true; }
+
+	sint32 GetUniformLocation(const char* name) override { return -1; }
+
+	void SetUniform2fv(sint32 location, void* data, sint32 count) override {}
+	void SetUniform4iv(sint32 location, void* data, sint32 count) override {}
+};
+
+class LatteQueryObjectNull : public LatteQueryObject
+{
+public:
+	bool getResult(uint64& numSamplesPassed) override
+	{
+		numSamplesPassed = 0;
+		return true;
+	}
+	void begin() override {}
+	void end() override {}
+};
+
+// hands back zero-filled pixel data, the size covers the widest format (128 bits per pixel)
+class LatteTextureReadbackInfoNull : public LatteTextureReadbackInfo
+{
+public:
+	LatteTextureReadbackInfoNull(LatteTextureView* textureView)
+		: LatteTextureReadbackInfo(textureView)
+	{
+		m_image_size = hostTextureCopy.width * hostTextureCopy.height * 16;
+	}
+
+	void StartTransfer() override { m_data.resize(m_image_size); }
+	bool IsFinished() override { return true; }
+	uint8* GetData() override { return m_data.data(); }
+
+private:
+	std::vector<uint8> m_data;
+};
+
+NullRenderer::NullRenderer()
+{
+	cemuLog_log(LogType::Force, "Using null renderer. No graphics output will be produced");
+}
+
+NullRenderer::~NullRenderer()
+{
+}
+
+NullRenderer* NullRenderer::GetInstance()
+{
+	cemu_assert_debug(g_renderer && dynamic_cast<NullRenderer*>(g_renderer.get()));
+	return (NullRenderer*)g_renderer.get();
+}
+
+void NullRenderer::Initialize()
+{
+	Renderer::Initialize();
+	m_stats.lastSwapTick = HighResolutionTimer::now().getTick();
+}
+
+void NullRenderer::Shutdown()
+{
+	if (m_stats.numFrames > 0)
+		ReportFrameStatistics();
+	Renderer::Shutdown();
+}
+
+void NullRenderer::SwapBuffers(bool swapTV, bool swapDRC)
+{
+	if (!swapTV)
+		return;
+	HRTick currentTick = HighResolutionTimer::now().getTick();
+	double frameTime = HighResolutionTimer::getTimeDiff(m_stats.lastSwapTick, currentTick) * 1000.0;
+	m_stats.lastSwapTick = currentTick;
+	if (m_stats.numFrames == 0)
+	{
+		m_stats.frameTimeMin = frameTime;
+		m_stats.frameTimeMax = frameTime;
+	}
+	m_stats.frameTimeSum += frameTime;
+	m_stats.frameTimeMin = std::min(m_stats.frameTimeMin, frameTime);
+	m_stats.frameTimeMax = std::max(m_stats.frameTimeMax, frameTime);
+	m_stats.numFrames++;
+	if (m_stats.numFrames >= FRAME_REPORT_INTERVAL)
+		ReportFrameStatistics();
+}
+
+void NullRenderer::ReportFrameStatistics()
+{
+	double numFrames = (double)m_stats.numFrames;
+	uint32 numDrawCalls = LatteGPUState.drawCallCounter - m_stats.drawCallCounterStart;
+	cemuLog_log(LogType::Force, "NullRenderer: {} frames, frame time avg {:.2f}ms min {:.2f}ms max {:.2f}ms | per frame: {:.1f} drawcalls, {:.1f}KB texture upload, {:.1f}KB buffer upload, {:.1f}KB index data | {} textures ({}MB)",
+		m_stats.numFrames, m_stats.frameTimeSum / numFrames, m_stats.frameTimeMin, m_stats.frameTimeMax,
+		(double)numDrawCalls / numFrames, (double)m_stats.textureUploadBytes / 1024.0 / numFrames, (double)m_stats.bufferUploadBytes / 1024.0 / numFrames, (double)m_stats.indexBytes / 1024.0 / numFrames,
+		m_stats.numTextures, m_stats.textureMemory / 1024 / 1024);
+	m_stats.numFrames = 0;
+	m_stats.frameTimeSum = 0.0;
+	m_stats.drawCallCounterStart = LatteGPUState.drawCallCounter;
+	m_stats.textureUploadBytes = 0;
+	m_stats.bufferUploadBytes = 0;
+	m_stats.indexBytes = 0;
+}
+
+void NullRenderer::NotifyTextureAllocation(sint64 sizeDelta)
+{
+	m_stats.numTextures += sizeDelta >= 0 ? 1 : -1;
+	m_stats.textureMemory += sizeDelta;
+}
+
+LatteCachedFBO* NullRenderer::rendertarget_createCachedFBO(uint64 key)
+{
+	return new LatteCachedFBONull(key);
+}
+
+void NullRenderer::rendertarget_deleteCachedFBO(LatteCachedFBO* fbo)
+{
+	delete fbo;
+}
+
+void* NullRenderer::texture_acquireTextureUploadBuffer(uint32 size)
+{
+	if (m_textureUploadBuffer.size() < size)
+		m_textureUploadBuffer.resize(size);
+	return m_textureUploadBuffer.data();
+}
+
+TextureDecoder* NullRenderer::texture_chooseDecodedFormat(Latte::E_GX2SURFFMT format, bool isDepth, Latte::E_DIM dim, uint32 width, uint32 height)
+{
+	return LatteTextureLoader_GetDefaultDecoder(format, isDepth, dim, width, height);
+}
+
+void NullRenderer::texture_loadSlice(LatteTexture* hostTexture, sint32 width, sint32 height, sint32 depth, void* pixelData, sint32 sliceIndex, sint32 mipIndex, uint32 compressedImageSize)
+{
+	m_stats.textureUploadBytes += compressedImageSize;
+}
+
+LatteTexture* NullRenderer::texture_createTextureEx(Latte::E_DIM dim, MPTR physAddress, MPTR physMipAddress, Latte::E_GX2SURFFMT format, uint32 width, uint32 height, uint32 depth, uint32 pitch, uint32 mipLevels, uint32 swizzle, Latte::E_HWTILEMODE tileMode, bool isDepth)
+{
+	return new LatteTextureNull(dim, physAddress, physMipAddress, format, width, height, depth, pitch, mipLevels, swizzle, tileMode, isDepth);
+}
+
+LatteTextureReadbackInfo* NullRenderer::texture_createReadback(LatteTextureView* textureView)
+{
+	return new LatteTextureReadbackInfoNull(textureView);
+}
+
+void NullRenderer::bufferCache_init(const sint32 bufferSize)
+{
+	m_bufferCache.resize(bufferSize);
+}
+
+void NullRenderer::bufferCache_upload(uint8* buffer, sint32 size, uint32 bufferOffset)
+{
+	cemu_assert_debug((size_t)bufferOffset + size <= m_bufferCache.size());
+	memcpy(m_bufferCache.data() + bufferOffset, buffer, size);
+	m_stats.bufferUploadBytes += size;
+}
+
+void NullRenderer::bufferCache_copy(uint32 srcOffset, uint32 dstOffset, uint32 size)
+{
+	memmove(m_bufferCache.data() + dstOffset, m_bufferCache.data() + srcOffset, size);
+}
+
+RendererShader* NullRenderer::shader_create(RendererShader::ShaderType type, uint64 baseHash, uint64 auxHash, const std::string& source, bool isGameShader, bool isGfxPackShader)
+{
+	return new RendererShaderNull(type, baseHash, auxHash, isGameShader, isGfxPackShader);
+}
+
+void NullRenderer::draw_beginSequence()
+{
+	m_drawSequenceSkip = false;
+
+	bool streamoutEnable = LatteGPUState.contextRegister[mmVGT_STRMOUT_EN] != 0;
+
+	// update shader state
+	LatteSHRC_UpdateActiveShaders();
+	if (LatteGPUState.activeShaderHasError)
+	{
+		m_drawSequenceSkip = true;
+		return;
+	}
+
+	// update render target and texture state
+	LatteGPUState.requiresTextureBarrier = false;
+	while (true)
+	{
+		LatteGPUState.repeatTextureInitialization = false;
+		if (!LatteMRT::UpdateCurrentFBO())
+		{
+			m_drawSequenceSkip = true;
+			return; // no render target
+		}
+		if (!hasValidFramebufferAttached && !streamoutEnable)
+		{
+			m_drawSequenceSkip = true;
+			return; // no render target
+		}
+		LatteTexture_updateTextures();
+		if (!LatteGPUState.repeatTextureInitialization)
+			break;
+	}
+
+	LatteMRT::ApplyCurrentState();
+	LatteRenderTarget_updateViewport();
+	LatteRenderTarget_updateScissorBox();
+}
+
+void NullRenderer::draw_execute(uint32 baseVertex, uint32 baseInstance, uint32 instanceCount, uint32 count, MPTR indexDataMPTR, Latte::LATTE_VGT_DMA_INDEX_TYPE::E_INDEX_TYPE indexType, bool isFirst)
+{
+	if (m_drawSequenceSkip)
+	{
+		LatteGPUState.drawCallCounter++;
+		return;
+	}
+	if (LatteGPUState.contextNew.GetSpecialStateValues()[8] != 0)
+	{
+		LatteDraw_handleSpecialState8_clearAsDepth();
+		LatteGPUState.drawCallCounter++;
+		return;
+	}
+
+	LatteStreamout_PrepareDrawcall(count, instanceCount);
+
+	// decode indices and synchronize vertex and uniform data the same way the GPU backends do
+	const LattePrimitiveMode primitiveMode = static_cast<LattePrimitiveMode>(LatteGPUState.contextRegister[mmVGT_PRIMITIVE_TYPE]);
+	Renderer::INDEX_TYPE hostIndexType;
+	uint32 hostIndexCount;
+	uint32 indexMin = 0;
+	uint32 indexMax = 0;
+	Renderer::IndexAllocation indexAllocation;
+	LatteIndices_decode(memory_getPointerFromVirtualOffset(indexDataMPTR), indexType, count, primitiveMode, indexMin, indexMax, hostIndexType, hostIndexCount, indexAllocation);
+	LatteBufferCache_Sync(indexMin + baseVertex, indexMax + baseVertex, baseInstance, instanceCount);
+
+	LatteStreamout_FinishDrawcall(false);
+
+	LatteGPUState.drawCallCounter++;
+}
+
+void NullRenderer::draw_endSequence()
+{
+	LatteDecompilerShader* pixelShader = LatteSHRC_GetActivePixelShader();
+	if (pixelShader)
+		LatteRenderTarget_trackUpdates();
+	LatteTextureReadback_Update();
+}
+
+Renderer::IndexAllocation NullRenderer::indexData_reserveIndexMemory(uint32 size)
+{
+	IndexAllocation allocation;
+	allocation.mem = malloc(size);
+	allocation.rendererInternal = nullptr;
+	m_stats.indexBytes += size;
+	return allocation;
+}
+
+void NullRenderer::indexData_releaseIndexMemory(IndexAllocation& allocation)
+{
+	free(allocation.mem);
+	allocation.mem = nullptr;
+}
+
+void NullRenderer::indexData_uploadIndexMemory(IndexAllocation& allocation)
+{
+}
+
+LatteQueryObject* NullRenderer::occlusionQuery_create()
+{
+	return new LatteQueryObjectNull();
+}
+
+void NullRenderer::occlusionQuery_destroy(LatteQueryObject* queryObj)
+{
+	delete static_cast<LatteQueryObjectNull*>(queryObj);
+}
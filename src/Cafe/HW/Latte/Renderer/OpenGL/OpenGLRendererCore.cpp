@@ -1194,8 +1194,10 @@ void OpenGLRenderer::draw_genericDrawHandler(uint32 baseVertex, uint32 baseInsta
 		// streamout and rasterizer enabled, repeat drawcall with streamout disabled
 		uint32 strmOutEnOrg = LatteGPUState.contextRegister[mmVGT_STRMOUT_EN];
 		LatteGPUState.contextRegister[mmVGT_STRMOUT_EN] = 0;
+		LatteReg_markWritten(mmVGT_STRMOUT_EN, mmVGT_STRMOUT_EN + 1);
 		draw_genericDrawHandler<false, THasProfiling>(baseVertex, baseInstance, instanceCount, count, indexDataMPTR, indexType);
 		LatteGPUState.contextRegister[mmVGT_STRMOUT_EN] = strmOutEnOrg;
+		LatteReg_markWritten(mmVGT_STRMOUT_EN, mmVGT_STRMOUT_EN + 1);
 		return;
 	}
 	LatteTextureReadback_Update();
@@ -127,5 +127,7 @@ uint8* LatteTextureReadbackInfoGL::GetData()
 
 void LatteTextureReadbackInfoGL::ReleaseData()
 {
+	// other readbacks may have been started while the data was mapped
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, texImageBufferGL);
 	glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
 }
@@ -33,6 +33,7 @@ enum class RendererAPI
 {
 	OpenGL,
 	Vulkan,
+	Null, // no host GPU, used for headless benchmarking
 
 	MAX
 };
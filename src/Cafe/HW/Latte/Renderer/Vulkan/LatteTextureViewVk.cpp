@@ -77,6 +77,7 @@ LatteTextureViewVk::~LatteTextureViewVk()
 {
 	while (!list_descriptorSets.empty())
 		delete list_descriptorSets[0];
+	VulkanRenderer::GetInstance()->texture_notifyViewDestroyed();
 
 	if (m_smallCacheView0)
 		VulkanRenderer::GetInstance()->ReleaseDestructibleObject(m_smallCacheView0);
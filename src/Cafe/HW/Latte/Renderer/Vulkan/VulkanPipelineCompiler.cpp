@@ -8,6 +8,7 @@
 #include "config/ActiveSettings.h"
 #include "util/helpers/Serializer.h"
 #include "Cafe/HW/Latte/Common/RegisterSerializer.h"
+#include "util/helpers/helpers.h"
 
 std::mutex s_nvidiaWorkaround;
 
@@ -1122,3 +1123,105 @@ bool PipelineCompiler::CalcRobustBufferAccessRequirement(LatteDecompilerShader*
 	}
 	return requiresRobustBufferAcces;
 }
+
+PipelineCompileScheduler& PipelineCompileScheduler::GetInstance()
+{
+	// intentionally never destroyed, the detached workers keep waiting on the condition variable until the process exits
+	static PipelineCompileScheduler* s_instance = new PipelineCompileScheduler();
+	return *s_instance;
+}
+
+void PipelineCompileScheduler::QueueOnDemand(PipelineCompiler* pipelineCompiler)
+{
+	std::unique_lock _l(m_mutex);
+	StartWorkers();
+	m_onDemandQueue.emplace_back(pipelineCompiler);
+	_l.unlock();
+	m_jobAvailable.notify_one();
+}
+
+void PipelineCompileScheduler::QueueWarmup(std::function<void()> job)
+{
+	std::unique_lock _l(m_mutex);
+	StartWorkers();
+	m_warmupQueue.emplace_back(std::move(job));
+	_l.unlock();
+	m_jobAvailable.notify_one();
+}
+
+void PipelineCompileScheduler::SetMaxConcurrentWarmupJobs(uint32 maxJobs)
+{
+	std::unique_lock _l(m_mutex);
+	m_maxConcurrentWarmupJobs = std::max(maxJobs, 1u);
+	_l.unlock();
+	m_jobAvailable.notify_all();
+}
+
+void PipelineCompileScheduler::CancelWarmup()
+{
+	std::unique_lock _l(m_mutex);
+	m_warmupQueue.clear();
+	m_warmupJobFinished.wait(_l, [this]() { return m_numActiveWarmupJobs == 0; });
+}
+
+uint32 PipelineCompileScheduler::GetWorkerCount()
+{
+	std::unique_lock _l(m_mutex);
+	StartWorkers();
+	return m_numWorkers;
+}
+
+void PipelineCompileScheduler::StartWorkers()
+{
+	if (m_numWorkers != 0)
+		return;
+	// one core is left to the GPU thread which records drawcalls and feeds the queue during cache loading
+	uint32 cpuCoreCount = GetPhysicalCoreCount();
+	m_numWorkers = cpuCoreCount <= 2 ? 1 : std::min(cpuCoreCount - 1, 32u);
+	for (uint32 i = 0; i < m_numWorkers; i++)
+	{
+		std::thread compileThread(&PipelineCompileScheduler::WorkerThread, this, i);
+		compileThread.detach();
+	}
+}
+
+bool PipelineCompileScheduler::HasRunnableJob() const
+{
+	return !m_onDemandQueue.empty() || (!m_warmupQueue.empty() && m_numActiveWarmupJobs < m_maxConcurrentWarmupJobs);
+}
+
+void PipelineCompileScheduler::WorkerThread(uint32 workerIndex)
+{
+	SetThreadName("compilePl");
+#ifdef _WIN32
+	// one thread runs at normal priority while the others run at lower priority
+	if (workerIndex != 0)
+		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#endif
+	std::unique_lock _l(m_mutex);
+	while (true)
+	{
+		m_jobAvailable.wait(_l, [this]() { return HasRunnableJob(); });
+		if (!m_onDemandQueue.empty())
+		{
+			PipelineCompiler* pipelineCompiler = m_onDemandQueue.front();
+			m_onDemandQueue.pop_front();
+			_l.unlock();
+			pipelineCompiler->Compile(true, false, true);
+			delete pipelineCompiler;
+			_l.lock();
+			continue;
+		}
+		std::function<void()> job = std::move(m_warmupQueue.front());
+		m_warmupQueue.pop_front();
+		m_numActiveWarmupJobs++;
+		_l.unlock();
+		job();
+		_l.lock();
+		m_numActiveWarmupJobs--;
+		m_warmupJobFinished.notify_all();
+		// another worker may be waiting for the warm-up concurrency limit
+		if (!m_warmupQueue.empty())
+			m_jobAvailable.notify_one();
+	}
+}
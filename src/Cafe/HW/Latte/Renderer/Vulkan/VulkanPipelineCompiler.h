@@ -84,4 +84,33 @@ public:
 	// returns true if the shader was compiled (even if errors occurred)
 	bool Compile(bool forceCompile, bool isRenderThread, bool showInOverlay);
 
-};
\ No newline at end of file
+};
+
+// worker threads shared by all pipeline compilation (async pipelines requested by drawcalls and pipeline cache warm-up)
+// on-demand pipelines are always dequeued before warm-up jobs so a drawcall never waits behind the cache loader
+class PipelineCompileScheduler
+{
+public:
+	static PipelineCompileScheduler& GetInstance();
+
+	void QueueOnDemand(PipelineCompiler* pipelineCompiler); // compiles asynchronously, the compiler is deleted afterwards
+	void QueueWarmup(std::function<void()> job);
+	void SetMaxConcurrentWarmupJobs(uint32 maxJobs); // used to serialize warm-up on drivers which do not support multithreaded pipeline creation
+	void CancelWarmup(); // discards all queued warm-up jobs and waits for the running ones to finish
+
+	uint32 GetWorkerCount();
+
+private:
+	void StartWorkers(); // assumes lock is held
+	void WorkerThread(uint32 workerIndex);
+	bool HasRunnableJob() const; // assumes lock is held
+
+	std::mutex m_mutex;
+	std::condition_variable m_jobAvailable;
+	std::condition_variable m_warmupJobFinished;
+	std::deque<PipelineCompiler*> m_onDemandQueue;
+	std::deque<std::function<void()>> m_warmupQueue;
+	uint32 m_numWorkers{};
+	uint32 m_numActiveWarmupJobs{};
+	uint32 m_maxConcurrentWarmupJobs{std::numeric_limits<uint32>::max()};
+};
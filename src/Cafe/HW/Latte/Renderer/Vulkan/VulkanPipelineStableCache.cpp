@@ -41,21 +41,10 @@ uint32 VulkanPipelineStableCache::BeginLoading(uint64 cacheTitleId)
 	g_vkCacheState.pipelinesLoaded = 0;
 	g_vkCacheState.pipelinesQueued = 0;
 	
-	// start async compilation threads
-	m_compilationCount.store(0);	
-	m_compilationQueue.clear();
-
-	// get core count
-	uint32 cpuCoreCount = GetPhysicalCoreCount();
-	m_numCompilationThreads = std::clamp(cpuCoreCount, 1u, 8u);
-	if (VulkanRenderer::GetInstance()->GetDisableMultithreadedCompilation())
-		m_numCompilationThreads = 1;
-
-	for (uint32 i = 0; i < m_numCompilationThreads; i++)
-	{
-		std::thread compileThread(&VulkanPipelineStableCache::CompilerThread, this);
-		compileThread.detach();
-	}
+	// cached pipelines are compiled on the shared pipeline compile workers
+	auto& compileScheduler = PipelineCompileScheduler::GetInstance();
+	compileScheduler.SetMaxConcurrentWarmupJobs(VulkanRenderer::GetInstance()->GetDisableMultithreadedCompilation() ? 1 : compileScheduler.GetWorkerCount());
+	m_maxQueuedPipelines = compileScheduler.GetWorkerCount() * 4;
 
 	// open cache file or create it
 	cemu_assert_debug(s_cache == nullptr);
@@ -77,23 +66,29 @@ bool VulkanPipelineStableCache::UpdateLoading(uint32& pipelinesLoadedTotal, uint
 {
 	pipelinesLoadedTotal = g_vkCacheState.pipelinesLoaded;
 	pipelinesMissingShaders = 0;
+	bool queuedAny = false;
 	while (g_vkCacheState.pipelineLoadIndex <= g_vkCacheState.pipelineMaxFileIndex)
 	{
-		if (m_compilationQueue.size() >= 50)
+		// keep a few entries per worker queued, reading further ahead only increases memory usage
+		if (g_vkCacheState.pipelinesQueued - g_vkCacheState.pipelinesLoaded >= m_maxQueuedPipelines)
 		{
-			std::this_thread::sleep_for(std::chrono::milliseconds(10));
-			return true; // queue up to 50 entries at a time
+			if (!queuedAny)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			return true;
 		}
 
 		uint64 fileNameA, fileNameB;
 		std::vector<uint8> fileData;
 		if (s_cache->GetFileByIndex(g_vkCacheState.pipelineLoadIndex, &fileNameA, &fileNameB, fileData))
 		{
-			// queue for async compilation
+			// the record is deserialized and compiled by a worker
 			g_vkCacheState.pipelinesQueued++;
-			m_compilationQueue.push(std::move(fileData));
-			g_vkCacheState.pipelineLoadIndex++;
-			return true;
+			PipelineCompileScheduler::GetInstance().QueueWarmup([this, fileData = std::move(fileData)]() mutable
+			{
+				LoadPipelineFromCache(fileData);
+				++g_vkCacheState.pipelinesLoaded;
+			});
+			queuedAny = true;
 		}
 		g_vkCacheState.pipelineLoadIndex++;
 	}
@@ -107,13 +102,8 @@ bool VulkanPipelineStableCache::UpdateLoading(uint32& pipelinesLoadedTotal, uint
 
 void VulkanPipelineStableCache::EndLoading()
 {
-	// shut down compilation threads
-	uint32 threadCount = m_numCompilationThreads;
-	m_numCompilationThreads = 0; // signal thread shutdown
-	for (uint32 i = 0; i < threadCount; i++)
-	{
-		m_compilationQueue.push({}); // push empty workload for every thread. Threads then will shutdown after checking for m_numCompilationThreads == 0
-	}
+	// if loading was cancelled some pipelines may still be queued. The compile workers stay alive for on-demand pipelines
+	PipelineCompileScheduler::GetInstance().CancelWarmup();
 	// keep cache file open for writing of new pipelines
 }
 
@@ -210,24 +200,13 @@ VKRObjectRenderPass* __CreateTemporaryRenderPass(const LatteDecompilerShader* pi
 
 void VulkanPipelineStableCache::LoadPipelineFromCache(std::span<uint8> fileData)
 {
-	static FSpinlock s_spinlockSharedInternal;
-
-	// deserialize file
-	LatteContextRegister* lcr = new LatteContextRegister();
-	s_spinlockSharedInternal.lock();
-	CachedPipeline* cachedPipeline = new CachedPipeline();
-	s_spinlockSharedInternal.unlock();
+	// deserialize file. Runs on the compile workers, so decoding of the register state happens in parallel
+	auto lcr = std::make_unique<LatteContextRegister>();
+	auto cachedPipeline = std::make_unique<CachedPipeline>();
 
 	MemStreamReader streamReader(fileData.data(), fileData.size());
 	if (!DeserializePipeline(streamReader, *cachedPipeline))
-	{
-		// failed to deserialize
-		s_spinlockSharedInternal.lock();
-		delete lcr;
-		delete cachedPipeline;
-		s_spinlockSharedInternal.unlock();
-		return;
-	}
+		return; // failed to deserialize
 	// restored register view from compacted state
 	Latte::LoadGPURegisterState(*lcr, cachedPipeline->gpuState);
 
@@ -280,13 +259,7 @@ void VulkanPipelineStableCache::LoadPipelineFromCache(std::span<uint8> fileData)
 		PipelineCompiler pipelineCompiler;
 		bool requiresRobustBufferAccess = PipelineCompiler::CalcRobustBufferAccessRequirement(vertexShader, pixelShader, geometryShader);
 		if (!pipelineCompiler.InitFromCurrentGPUState(pipelineInfo, *lcr, renderPass, requiresRobustBufferAccess))
-		{
-			s_spinlockSharedInternal.lock();
-			delete lcr;
-			delete cachedPipeline;
-			s_spinlockSharedInternal.unlock();
 			return;
-		}
 		pipelineCompiler.Compile(true, true, false);
 	}
 	// on success, calculate pipeline hash and flag as present in cache
@@ -296,12 +269,8 @@ void VulkanPipelineStableCache::LoadPipelineFromCache(std::span<uint8> fileData)
 	m_pipelineIsCached.emplace(pipelineBaseHash, pipelineStateHash);
 	m_pipelineIsCachedLock.unlock();
 	// clean up
-	s_spinlockSharedInternal.lock();
 	delete pipelineInfo;
-	delete lcr;
-	delete cachedPipeline;
 	VulkanRenderer::GetInstance()->ReleaseDestructibleObject(renderPass);
-	s_spinlockSharedInternal.unlock();
 }
 
 bool VulkanPipelineStableCache::HasPipelineCached(uint64 baseHash, uint64 pipelineStateHash)
@@ -406,20 +375,6 @@ bool VulkanPipelineStableCache::DeserializePipeline(MemStreamReader& memReader,
 	return true;
 }
 
-int VulkanPipelineStableCache::CompilerThread()
-{
-	SetThreadName("plCacheCompiler");
-	while (m_numCompilationThreads != 0)
-	{
-		std::vector<uint8> pipelineData = m_compilationQueue.pop();
-		if(pipelineData.empty())
-			continue;
-		LoadPipelineFromCache(pipelineData);
-		++g_vkCacheState.pipelinesLoaded;
-	}
-	return 0;
-}
-
 void VulkanPipelineStableCache::WorkerThread()
 {
 	SetThreadName("plCacheWriter");
@@ -51,7 +51,6 @@ public:
 	bool DeserializePipeline(class MemStreamReader& memReader, struct CachedPipeline& cachedPipeline);
 
 private:
-	int CompilerThread();
 	void WorkerThread();
 
 	std::thread* m_pipelineCacheStoreThread;
@@ -60,7 +59,5 @@ private:
 	FSpinlock m_pipelineIsCachedLock;
 	class FileCache* s_cache;
 
-	std::atomic_uint32_t m_numCompilationThreads{ 0 };
-	ConcurrentQueue<std::vector<uint8>> m_compilationQueue;
-	std::atomic_uint32_t m_compilationCount;
+	uint32 m_maxQueuedPipelines{};
 };
\ No newline at end of file
@@ -3450,7 +3450,11 @@ LatteTexture* VulkanRenderer::texture_createTextureEx(Latte::E_DIM dim, MPTR phy
 
 void VulkanRenderer::texture_setLatteTexture(LatteTextureView* textureView, uint32 textureUnit)
 {
-	m_state.boundTexture[textureUnit] = static_cast<LatteTextureViewVk*>(textureView);
+	LatteTextureViewVk* textureViewVk = static_cast<LatteTextureViewVk*>(textureView);
+	if (m_state.boundTexture[textureUnit] == textureViewVk)
+		return;
+	m_state.boundTexture[textureUnit] = textureViewVk;
+	m_state.boundTextureGeneration++;
 }
 
 void VulkanRenderer::texture_copyImageSubData(LatteTexture* src, sint32 srcMip, sint32 effectiveSrcX, sint32 effectiveSrcY, sint32 srcSlice, LatteTexture* dst, sint32 dstMip, sint32 effectiveDstX, sint32 effectiveDstY, sint32 dstSlice, sint32 effectiveCopyWidth, sint32 effectiveCopyHeight, sint32 srcDepth)
@@ -3553,6 +3557,8 @@ LatteTextureReadbackInfo* VulkanRenderer::texture_createReadback(LatteTextureVie
 
 	if ((m_textureReadbackBufferWriteIndex + uploadSize + 256) > TEXTURE_READBACK_SIZE)
 	{
+		// the start of the ring buffer may still be read by pending guest memory writes
+		LatteTextureReadback_WaitForMemoryWrites();
 		m_textureReadbackBufferWriteIndex = 0;
 	}
 
@@ -270,6 +270,7 @@ public:
 	// pipeline state hash
 	static uint64 draw_calculateMinimalGraphicsPipelineHash(const LatteFetchShader* fetchShader, const LatteContextRegister& lcr);
 	static uint64 draw_calculateGraphicsPipelineHash(const LatteFetchShader* fetchShader, const LatteDecompilerShader* vertexShader, const LatteDecompilerShader* geometryShader, const LatteDecompilerShader* pixelShader, const VKRObjectRenderPass* renderPassObj, const LatteContextRegister& lcr);
+	void draw_getCurrentGraphicsPipelineHash(const LatteFetchShader* fetchShader, const LatteDecompilerShader* vertexShader, const LatteDecompilerShader* geometryShader, const LatteDecompilerShader* pixelShader, const VKRObjectRenderPass* renderPassObj, uint64& minimalStateHashOut, uint64& pipelineHashOut);
 
 	// rendertarget
 	void renderTarget_setViewport(float x, float y, float width, float height, float nearZ, float farZ, bool halfZ = false) override;
@@ -295,6 +296,7 @@ public:
 	LatteTexture* texture_createTextureEx(Latte::E_DIM dim, MPTR physAddress, MPTR physMipAddress, Latte::E_GX2SURFFMT format, uint32 width, uint32 height, uint32 depth, uint32 pitch, uint32 mipLevels, uint32 swizzle, Latte::E_HWTILEMODE tileMode, bool isDepth) override;
 
 	void texture_setLatteTexture(LatteTextureView* textureView, uint32 textureUnit) override;
+	void texture_notifyViewDestroyed() { m_state.boundTextureGeneration++; } // a new view may be allocated at the address of a still bound view
 
 	void texture_copyImageSubData(LatteTexture* src, sint32 srcMip, sint32 effectiveSrcX, sint32 effectiveSrcY, sint32 srcSlice, LatteTexture* dst, sint32 dstMip, sint32 effectiveDstX, sint32 effectiveDstY, sint32 dstSlice, sint32 effectiveCopyWidth, sint32 effectiveCopyHeight, sint32 srcDepth) override;
 	LatteTextureReadbackInfo* texture_createReadback(LatteTextureView* textureView) override;
@@ -350,6 +352,7 @@ private:
 
 		// textures
 		LatteTextureViewVk* boundTexture[128]{};
+		uint64 boundTextureGeneration{}; // incremented whenever an entry of boundTexture changes or a bound view is destroyed
 
 		// rendertarget
 		CachedFBOVk* activeFBO{}; // the FBO active for the emulated GPU
@@ -363,6 +366,31 @@ private:
 		// renderpass
 		CachedFBOVk* activeRenderpassFBO{}; // the FBO of the currently active Vulkan renderpass
 
+		// pipeline and descriptor set state hashes of the previous drawcall. Reused as long as none of the registers they depend on were written
+		struct
+		{
+			bool isValid{};
+			uint64 regWriteStamp;
+			const LatteFetchShader* fetchShader;
+			uint64 fetchShaderKey;
+			uint64 fetchShaderVkHash;
+			const LatteDecompilerShader* shader[3];
+			uint64 shaderHash[3];
+			const VKRObjectRenderPass* renderPassObj;
+			uint64 renderPassHash;
+			uint64 minimalStateHash;
+			uint64 pipelineHash;
+		}cachedPipelineHash;
+
+		struct
+		{
+			const LatteDecompilerShader* shader{};
+			uint64 shaderHash;
+			uint64 boundTextureGeneration;
+			uint64 regWriteStamp;
+			uint64 stateHash;
+		}cachedDescriptorSetHash[VulkanRendererConst::SHADER_STAGE_INDEX_COUNT];
+
 		// drawcall state
 		PipelineInfo* activePipelineInfo{ nullptr };
 		VkDescriptorSetInfo* activeVertexDS{ nullptr };
@@ -512,6 +540,7 @@ private:
 	bool IsAsyncPipelineAllowed(uint32 numIndices);
 
 	uint64 GetDescriptorSetStateHash(LatteDecompilerShader* shader);
+	uint64 GetCurrentDescriptorSetStateHash(LatteDecompilerShader* shader);
 
 	// imgui
 	bool ImguiBegin(bool mainWindow) override;
@@ -602,6 +631,14 @@ private:
 	uint8* m_uniformVarBufferPtr = nullptr;
 	uint32 m_uniformVarBufferWriteIndex = 0;
 	uint32 m_uniformVarBufferReadIndex = 0;
+	// last uniform var block written to the ring buffer for each shader stage
+	struct
+	{
+		uint64 cmdBufferId{~0ull}; // value of m_numSubmittedCmdBuffers while the block was written
+		sint32 size{};
+		uint32 ringOffset{};
+		float data[512 * 4];
+	}m_uniformVarLastUpload[VulkanRendererConst::SHADER_STAGE_INDEX_COUNT];
 
 	// transform feedback ringbuffer
 	VkBuffer m_xfbRingBuffer = VK_NULL_HANDLE;
@@ -64,7 +64,12 @@ uint64 VulkanRenderer::draw_calculateGraphicsPipelineHash(const LatteFetchShader
 	uint32* ctxRegister = lcr.GetRawView();
 
 	if (vertexShader)
+	{
 		stateHash += vertexShader->baseHash;
+		// variants which read some vertex buffers in host endianness share the base hash but use a different shader module
+		// the mask is zero for the regular variant, so its hash and therefore the pipeline cache entries stay unchanged
+		stateHash += (uint64)vertexShader->hostEndianVertexBufferMask << 48;
+	}
 
 	stateHash = std::rotl<uint64>(stateHash, 13);
 
@@ -135,6 +140,80 @@ uint64 VulkanRenderer::draw_calculateGraphicsPipelineHash(const LatteFetchShader
 	return stateHash;
 }
 
+// returns true if any register that is read by draw_calculateGraphicsPipelineHash() was written after the given stamp
+static bool _graphicsPipelineRegistersChangedSince(const LatteFetchShader* fetchShader, uint64 regWriteStamp)
+{
+	static constexpr uint32 s_pipelineRegisters[] =
+	{
+		mmVGT_PRIMITIVE_TYPE,
+		mmVGT_STRMOUT_EN,
+		Latte::REGADDR::PA_CL_CLIP_CNTL,
+		Latte::REGADDR::PA_SU_SC_MODE_CNTL,
+		Latte::REGADDR::CB_COLOR_CONTROL,
+		Latte::REGADDR::CB_TARGET_MASK,
+		Latte::REGADDR::DB_DEPTH_CONTROL,
+		mmDB_STENCILREFMASK,
+		mmDB_STENCILREFMASK_BF,
+	};
+	for (uint32 reg : s_pipelineRegisters)
+	{
+		if (LatteReg_wasWrittenSince(reg, regWriteStamp))
+			return true;
+	}
+	if (LatteReg_wasWrittenSince(Latte::REGADDR::CB_BLEND0_CONTROL, Latte::REGADDR::CB_BLEND0_CONTROL + 8, regWriteStamp))
+		return true;
+	// buffer strides
+	for (auto& group : fetchShader->bufferGroups)
+	{
+		if (LatteReg_wasWrittenSince(mmSQ_VTX_ATTRIBUTE_BLOCK_START + group.attributeBufferIndex * 7 + 2, regWriteStamp))
+			return true;
+	}
+	return false;
+}
+
+static uint64 _getShaderIdentityHash(const LatteDecompilerShader* shader)
+{
+	return shader ? (shader->baseHash + shader->auxHash * 3) : 0;
+}
+
+// same as draw_calculateGraphicsPipelineHash() for the current GPU state, but reuses the hashes of the previous call if the shaders, renderpass and relevant registers did not change
+void VulkanRenderer::draw_getCurrentGraphicsPipelineHash(const LatteFetchShader* fetchShader, const LatteDecompilerShader* vertexShader, const LatteDecompilerShader* geometryShader, const LatteDecompilerShader* pixelShader, const VKRObjectRenderPass* renderPassObj, uint64& minimalStateHashOut, uint64& pipelineHashOut)
+{
+	auto& cache = m_state.cachedPipelineHash;
+	const LatteDecompilerShader* shaders[3] = { vertexShader, geometryShader, pixelShader };
+	bool isValid = cache.isValid &&
+		cache.fetchShader == fetchShader && cache.fetchShaderKey == fetchShader->key && cache.fetchShaderVkHash == fetchShader->vkPipelineHashFragment &&
+		cache.renderPassObj == renderPassObj && cache.renderPassHash == renderPassObj->m_hashForPipeline;
+	for (sint32 i = 0; i < 3 && isValid; i++)
+		isValid = cache.shader[i] == shaders[i] && cache.shaderHash[i] == _getShaderIdentityHash(shaders[i]);
+	if (isValid && !_graphicsPipelineRegistersChangedSince(fetchShader, cache.regWriteStamp))
+	{
+#ifdef CEMU_DEBUG_ASSERT
+		cemu_assert_debug(cache.minimalStateHash == draw_calculateMinimalGraphicsPipelineHash(fetchShader, LatteGPUState.contextNew));
+		cemu_assert_debug(cache.pipelineHash == draw_calculateGraphicsPipelineHash(fetchShader, vertexShader, geometryShader, pixelShader, renderPassObj, LatteGPUState.contextNew));
+#endif
+		minimalStateHashOut = cache.minimalStateHash;
+		pipelineHashOut = cache.pipelineHash;
+		return;
+	}
+	cache.regWriteStamp = LatteReg_getWriteStamp();
+	cache.fetchShader = fetchShader;
+	cache.fetchShaderKey = fetchShader->key;
+	cache.fetchShaderVkHash = fetchShader->vkPipelineHashFragment;
+	for (sint32 i = 0; i < 3; i++)
+	{
+		cache.shader[i] = shaders[i];
+		cache.shaderHash[i] = _getShaderIdentityHash(shaders[i]);
+	}
+	cache.renderPassObj = renderPassObj;
+	cache.renderPassHash = renderPassObj->m_hashForPipeline;
+	cache.minimalStateHash = draw_calculateMinimalGraphicsPipelineHash(fetchShader, LatteGPUState.contextNew);
+	cache.pipelineHash = draw_calculateGraphicsPipelineHash(fetchShader, vertexShader, geometryShader, pixelShader, renderPassObj, LatteGPUState.contextNew);
+	cache.isValid = true;
+	minimalStateHashOut = cache.minimalStateHash;
+	pipelineHashOut = cache.pipelineHash;
+}
+
 void VulkanRenderer::draw_debugPipelineHashState()
 {
 	cemu_assert_debug(false);
@@ -153,7 +232,8 @@ PipelineInfo* VulkanRenderer::draw_getCachedPipeline()
 	const auto pixelShader = LatteSHRC_GetActivePixelShader();
 	auto cachedFboVk = (CachedFBOVk*)m_state.activeFBO;
 
-	const uint64 stateHash = draw_calculateGraphicsPipelineHash(fetchShader, vertexShader, geometryShader, pixelShader, cachedFboVk->GetRenderPassObj(), LatteGPUState.contextNew);
+	uint64 minimalStateHash, stateHash;
+	draw_getCurrentGraphicsPipelineHash(fetchShader, vertexShader, geometryShader, pixelShader, cachedFboVk->GetRenderPassObj(), minimalStateHash, stateHash);
 
 	const auto innerit = it->second.find(stateHash);
 	if (innerit == it->second.cend())
@@ -183,63 +263,6 @@ void VulkanRenderer::unregisterGraphicsPipeline(PipelineInfo* pipelineInfo)
 	}
 }
 
-bool g_compilePipelineThreadInit{false};
-std::mutex g_compilePipelineMutex;
-std::condition_variable g_compilePipelineCondVar;
-std::queue<PipelineCompiler*> g_compilePipelineRequests;
-
-void compilePipeline_thread(sint32 threadIndex)
-{
-	SetThreadName("compilePl");
-#ifdef _WIN32
-	// one thread runs at normal priority while the others run at lower priority
-	if(threadIndex != 0)
-		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
-#endif
-	while (true)
-	{
-		std::unique_lock lock(g_compilePipelineMutex);
-		while (g_compilePipelineRequests.empty())
-			g_compilePipelineCondVar.wait(lock);
-
-		PipelineCompiler* request = g_compilePipelineRequests.front();
-
-		g_compilePipelineRequests.pop();
-
-		lock.unlock();
-
-		request->Compile(true, false, true);
-		delete request;
-	}
-}
-
-void compilePipelineThread_init()
-{
-	uint32 numCompileThreads;
-
-	uint32 cpuCoreCount = GetPhysicalCoreCount();
-	if (cpuCoreCount <= 2)
-		numCompileThreads = 1;
-	else
-		numCompileThreads = 2 + (cpuCoreCount - 3); // 2 plus one additionally for every extra core above 3
-
-	numCompileThreads = std::min(numCompileThreads, 8u); // cap at 8
-
-	for (uint32_t i = 0; i < numCompileThreads; i++)
-	{
-		std::thread compileThread(compilePipeline_thread, i);
-		compileThread.detach();
-	}
-}
-
-void compilePipelineThread_queue(PipelineCompiler* v)
-{
-	std::unique_lock lock(g_compilePipelineMutex);
-	g_compilePipelineRequests.push(std::move(v));
-	lock.unlock();
-	g_compilePipelineCondVar.notify_one();
-}
-
 // make a guess if a pipeline is not essential
 // non-essential means that skipping these drawcalls shouldn't lead to permanently corrupted graphics
 bool VulkanRenderer::IsAsyncPipelineAllowed(uint32 numIndices)
@@ -270,20 +293,14 @@ bool VulkanRenderer::IsAsyncPipelineAllowed(uint32 numIndices)
 // create graphics pipeline for current state
 PipelineInfo* VulkanRenderer::draw_createGraphicsPipeline(uint32 indexCount)
 {
-	if (!g_compilePipelineThreadInit)
-	{
-		compilePipelineThread_init();
-		g_compilePipelineThreadInit = true;
-	}
-
 	const auto fetchShader = LatteSHRC_GetActiveFetchShader();
 	const auto vertexShader = LatteSHRC_GetActiveVertexShader();
 	const auto geometryShader = LatteSHRC_GetActiveGeometryShader();
 	const auto pixelShader = LatteSHRC_GetActivePixelShader();
 	auto cachedFboVk = (CachedFBOVk*)m_state.activeFBO;
 
-	uint64 minimalStateHash = draw_calculateMinimalGraphicsPipelineHash(fetchShader, LatteGPUState.contextNew);
-	uint64 pipelineHash = draw_calculateGraphicsPipelineHash(fetchShader, vertexShader, geometryShader, pixelShader, cachedFboVk->GetRenderPassObj(), LatteGPUState.contextNew);
+	uint64 minimalStateHash, pipelineHash;
+	draw_getCurrentGraphicsPipelineHash(fetchShader, vertexShader, geometryShader, pixelShader, cachedFboVk->GetRenderPassObj(), minimalStateHash, pipelineHash);
 
 	// create PipelineInfo
 	auto vkFBO = (CachedFBOVk*)(VulkanRenderer::GetInstance()->m_state.activeFBO);
@@ -313,7 +330,7 @@ PipelineInfo* VulkanRenderer::draw_createGraphicsPipeline(uint32 indexCount)
 		if (pipelineCompiler->Compile(false, true, true) == false)
 		{
 			// shaders or pipeline not cached -> asynchronous compilation
-			compilePipelineThread_queue(pipelineCompiler);
+			PipelineCompileScheduler::GetInstance().QueueOnDemand(pipelineCompiler);
 		}
 		else
 		{
@@ -374,11 +391,12 @@ void VulkanRenderer::indexData_uploadIndexMemory(IndexAllocation& allocation)
 	memoryManager->GetIndexAllocator().FlushReservation((VKRSynchronizedHeapAllocator::AllocatorReservation*)allocation.rendererInternal);
 }
 
-float s_vkUniformData[512 * 4];
+float s_vkUniformData[VulkanRendererConst::SHADER_STAGE_INDEX_COUNT][512 * 4];
 
 void VulkanRenderer::uniformData_updateUniformVars(uint32 shaderStageIndex, LatteDecompilerShader* shader)
 {
-	auto GET_UNIFORM_DATA_PTR = [](size_t index) { return s_vkUniformData + (index / 4); };
+	float* uniformData = s_vkUniformData[shaderStageIndex];
+	auto GET_UNIFORM_DATA_PTR = [uniformData](size_t index) { return uniformData + (index / 4); };
 
 	sint32 shaderAluConst;
 
@@ -453,6 +471,16 @@ void VulkanRenderer::uniformData_updateUniformVars(uint32 shaderStageIndex, Latt
 				}
 			}
 		}
+		// reuse the previous upload of this stage if the assembled data did not change
+		// only valid within the same command buffer, older ring buffer data can be overwritten once their command buffer finished
+		auto& lastUpload = m_uniformVarLastUpload[shaderStageIndex];
+		if (lastUpload.cmdBufferId == m_numSubmittedCmdBuffers && lastUpload.size == shader->uniform.uniformRangeSize &&
+			memcmp(lastUpload.data, uniformData, shader->uniform.uniformRangeSize) == 0)
+		{
+			dynamicOffsetInfo.uniformVarBufferOffset[shaderStageIndex] = lastUpload.ringOffset;
+			performanceMonitor.cycle[performanceMonitor.cycleIndex].uniformVarCachedData += shader->uniform.uniformRangeSize;
+			return;
+		}
 		// upload
 		const uint32 bufferAlignmentM1 = std::max(m_featureControl.limits.minUniformBufferOffsetAlignment, m_featureControl.limits.nonCoherentAtomSize) - 1;
 		const uint32 uniformSize = (shader->uniform.uniformRangeSize + bufferAlignmentM1) & ~bufferAlignmentM1;
@@ -499,8 +527,14 @@ void VulkanRenderer::uniformData_updateUniformVars(uint32 shaderStageIndex, Latt
 		});
 
 		const uint32 uniformOffset = m_uniformVarBufferWriteIndex;
-		memcpy(m_uniformVarBufferPtr + uniformOffset, s_vkUniformData, shader->uniform.uniformRangeSize);
+		memcpy(m_uniformVarBufferPtr + uniformOffset, uniformData, shader->uniform.uniformRangeSize);
 		m_uniformVarBufferWriteIndex += uniformSize;
+		performanceMonitor.cycle[performanceMonitor.cycleIndex].uniformVarUploadedData += shader->uniform.uniformRangeSize;
+		// waiting for ring buffer space may have submitted the command buffer, so the id is read after the upload
+		lastUpload.cmdBufferId = m_numSubmittedCmdBuffers;
+		lastUpload.size = shader->uniform.uniformRangeSize;
+		lastUpload.ringOffset = uniformOffset;
+		memcpy(lastUpload.data, uniformData, shader->uniform.uniformRangeSize);
 		// update dynamic offset
 		dynamicOffsetInfo.uniformVarBufferOffset[shaderStageIndex] = uniformOffset;
 		// flush if not coherent
@@ -592,9 +626,50 @@ uint64 VulkanRenderer::GetDescriptorSetStateHash(LatteDecompilerShader* shader)
 	return hash;
 }
 
+// same as GetDescriptorSetStateHash() but reuses the previous hash of the stage if the shader, the bound textures and the texture and sampler registers of the stage did not change
+uint64 VulkanRenderer::GetCurrentDescriptorSetStateHash(LatteDecompilerShader* shader)
+{
+	uint32 stageIndex;
+	uint32 texResourceRegBase;
+	switch (shader->shaderType)
+	{
+	case LatteConst::ShaderType::Vertex:
+		stageIndex = VulkanRendererConst::SHADER_STAGE_INDEX_VERTEX;
+		texResourceRegBase = Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_VS;
+		break;
+	case LatteConst::ShaderType::Pixel:
+		stageIndex = VulkanRendererConst::SHADER_STAGE_INDEX_FRAGMENT;
+		texResourceRegBase = Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_PS;
+		break;
+	case LatteConst::ShaderType::Geometry:
+		stageIndex = VulkanRendererConst::SHADER_STAGE_INDEX_GEOMETRY;
+		texResourceRegBase = Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_GS;
+		break;
+	default:
+		UNREACHABLE;
+	}
+	const uint32 samplerRegBase = Latte::REGADDR::SQ_TEX_SAMPLER_WORD0_0 + LatteDecompiler_getTextureSamplerBaseIndex(shader->shaderType) * 3;
+	auto& cache = m_state.cachedDescriptorSetHash[stageIndex];
+	if (cache.shader == shader && cache.shaderHash == _getShaderIdentityHash(shader) && cache.boundTextureGeneration == m_state.boundTextureGeneration &&
+		!LatteReg_wasWrittenSince(texResourceRegBase, texResourceRegBase + LATTE_NUM_MAX_TEX_UNITS * 7, cache.regWriteStamp) &&
+		!LatteReg_wasWrittenSince(samplerRegBase, samplerRegBase + LATTE_NUM_MAX_TEX_UNITS * 3, cache.regWriteStamp))
+	{
+#ifdef CEMU_DEBUG_ASSERT
+		cemu_assert_debug(cache.stateHash == GetDescriptorSetStateHash(shader));
+#endif
+		return cache.stateHash;
+	}
+	cache.shader = shader;
+	cache.shaderHash = _getShaderIdentityHash(shader);
+	cache.boundTextureGeneration = m_state.boundTextureGeneration;
+	cache.regWriteStamp = LatteReg_getWriteStamp();
+	cache.stateHash = GetDescriptorSetStateHash(shader);
+	return cache.stateHash;
+}
+
 VkDescriptorSetInfo* VulkanRenderer::draw_getOrCreateDescriptorSet(PipelineInfo* pipeline_info, LatteDecompilerShader* shader)
 {
-	const uint64 stateHash = GetDescriptorSetStateHash(shader);
+	const uint64 stateHash = GetCurrentDescriptorSetStateHash(shader);
 
 	VkDescriptorSetLayout descriptor_set_layout;
 	switch (shader->shaderType)
@@ -1390,12 +1465,20 @@ void VulkanRenderer::draw_execute(uint32 baseVertex, uint32 baseInstance, uint32
 	LatteDecompilerShader* pixelShader = LatteSHRC_GetActivePixelShader();
 	LatteDecompilerShader* geometryShader = LatteSHRC_GetActiveGeometryShader();
 
-	if (vertexShader)
-		uniformData_updateUniformVars(VulkanRendererConst::SHADER_STAGE_INDEX_VERTEX, vertexShader);
-	if (pixelShader)
-		uniformData_updateUniformVars(VulkanRendererConst::SHADER_STAGE_INDEX_FRAGMENT, pixelShader);
-	if (geometryShader)
-		uniformData_updateUniformVars(VulkanRendererConst::SHADER_STAGE_INDEX_GEOMETRY, geometryShader);
+	auto updateUniformVars = [&]()
+	{
+		if (vertexShader)
+			uniformData_updateUniformVars(VulkanRendererConst::SHADER_STAGE_INDEX_VERTEX, vertexShader);
+		if (pixelShader)
+			uniformData_updateUniformVars(VulkanRendererConst::SHADER_STAGE_INDEX_FRAGMENT, pixelShader);
+		if (geometryShader)
+			uniformData_updateUniformVars(VulkanRendererConst::SHADER_STAGE_INDEX_GEOMETRY, geometryShader);
+	};
+	const uint64 cmdBufferIdBeforeUniformUpdate = m_numSubmittedCmdBuffers;
+	updateUniformVars();
+	// if a stage had to submit the command buffer to free up ring buffer space, blocks reused by the earlier stages belong to the submitted command buffer
+	if (m_numSubmittedCmdBuffers != cmdBufferIdBeforeUniformUpdate)
+		updateUniformVars();
 	// store where the read pointer should go after command buffer execution
 	m_cmdBufferUniformRingbufIndices[m_commandBufferIndex] = m_uniformVarBufferWriteIndex;
 
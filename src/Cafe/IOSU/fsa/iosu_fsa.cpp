@@ -3,6 +3,7 @@
 #include "Cafe/IOSU/kernel/iosu_kernel.h"
 #include "Cafe/Filesystem/fsc.h"
 #include "util/helpers/helpers.h"
+#include "util/helpers/ConcurrentQueue.h"
 
 #include "Cafe/OS/libs/coreinit/coreinit_FS.h"	 // get rid of this dependency, requires reworking some of the IPC stuff. See locations where we use coreinit::FSCmdBlockBody_t
 #include "Cafe/HW/Latte/Core/LatteBufferCache.h" // also remove this dependency
@@ -19,6 +20,17 @@ namespace iosu
 		SysAllocator<iosu::kernel::IOSMessage, 352> _m_sFSAIoMsgQueueMsgBuffer;
 		std::thread sFSAIoThread;
 
+		// IOCTL/IOCTLV requests are forwarded from the IOSU-FSA thread to a small pool of workers
+		// all requests of a client are processed by the same worker, which keeps them in order. Coreinit only allows one request per client in flight
+		constexpr size_t FSA_MAX_WORKERS = 4;
+		struct FSAWorker
+		{
+			std::thread thread;
+			ConcurrentQueue<IPCCommandBody*> cmdQueue;
+		};
+		std::array<FSAWorker, FSA_MAX_WORKERS> sFSAWorkers;
+		size_t sFSAWorkerCount{0};
+
 		struct FSAClient // IOSU's counterpart to the coreinit FSClient struct
 		{
 			std::string workingDirectory;
@@ -37,9 +49,11 @@ namespace iosu
 		};
 
 		std::array<FSAClient, 624> sFSAClientArray;
+		std::mutex sFSAClientMutex;
 
 		IOS_ERROR FSAAllocateClient(sint32& indexOut)
 		{
+			std::unique_lock _l(sFSAClientMutex);
 			for (size_t i = 0; i < sFSAClientArray.size(); i++)
 			{
 				if (sFSAClientArray[i].isAllocated)
@@ -179,6 +193,7 @@ namespace iosu
 		public:
 			FSA_RESULT AllocateHandle(FSResHandle& handleOut, FSCVirtualFile* fscFile)
 			{
+				std::unique_lock _l(m_mutex);
 				for (size_t i = 0; i < m_handleTable.size(); i++)
 				{
 					auto& it = m_handleTable.at(i);
@@ -199,6 +214,7 @@ namespace iosu
 
 			FSA_RESULT ReleaseHandle(FSResHandle handle)
 			{
+				std::unique_lock _l(m_mutex);
 				uint16 index = (uint16)((uint32)handle >> 16);
 				uint16 checkValue = (uint16)(handle & 0xFFFF);
 				if (index >= m_handleTable.size())
@@ -215,6 +231,7 @@ namespace iosu
 
 			FSCVirtualFile* GetByHandle(FSResHandle handle)
 			{
+				std::unique_lock _l(m_mutex);
 				uint16 index = (uint16)((uint32)handle >> 16);
 				uint16 checkValue = (uint16)(handle & 0xFFFF);
 				if (index >= m_handleTable.size())
@@ -228,6 +245,7 @@ namespace iosu
 			}
 
 		private:
+			std::mutex m_mutex; // handles are accessed from all FSA workers
 			uint32 m_currentCounter = 1;
 			std::array<_FSAHandleResource, 0x3C0> m_handleTable;
 		};
@@ -453,6 +471,8 @@ namespace iosu
 			return FSA_RESULT::OK;
 		}
 
+		constexpr uint32 FSA_READ_CHUNK_SIZE = 0x40000;
+
 		FSA_RESULT FSAProcessCmd_read(FSAClient* client, FSAShimBuffer* shimBuffer, MEMPTR<void> destPtr, uint32be transferSize)
 		{
 			uint32 transferElementSize = shimBuffer->request.cmdReadFile.size;
@@ -469,7 +489,17 @@ namespace iosu
 			if ((flags & FSA_CMD_FLAG_SET_POS) != 0)
 				fsc_setFileSeek(fscFile, filePos);
 			// todo: File permissions
-			uint32 bytesSuccessfullyRead = fsc_readFile(fscFile, destPtr, bytesToRead);
+			// read in chunks so that big reads don't hold the FSC lock for their entire duration and requests of other workers can interleave
+			uint8* readPtr = (uint8*)destPtr.GetPtr();
+			uint32 bytesSuccessfullyRead = 0;
+			while (bytesSuccessfullyRead < bytesToRead)
+			{
+				uint32 chunkSize = std::min<uint32>(bytesToRead - bytesSuccessfullyRead, FSA_READ_CHUNK_SIZE);
+				uint32 chunkBytesRead = fsc_readFile(fscFile, readPtr + bytesSuccessfullyRead, chunkSize);
+				bytesSuccessfullyRead += chunkBytesRead;
+				if (chunkBytesRead != chunkSize)
+					break; // end of file or read error
+			}
 			if (transferElementSize == 0)
 				return FSA_RESULT::OK;
 
@@ -830,6 +860,47 @@ namespace iosu
 			IOS_ResourceReply(cmd, (IOS_ERROR)fsaResult);
 		}
 
+		void FSAProcessClientCommand(IPCCommandBody* cmd)
+		{
+			uint32 clientHandle = (uint32)cmd->devHandle;
+			cemu_assert(clientHandle < sFSAClientArray.size());
+			if (cmd->cmdId == IPCCommandId::IOS_CLOSE)
+			{
+				std::unique_lock _l(sFSAClientMutex);
+				sFSAClientArray[clientHandle].ReleaseAndCleanup();
+				_l.unlock();
+				IOS_ResourceReply(cmd, IOS_ERROR_OK);
+			}
+			else if (cmd->cmdId == IPCCommandId::IOS_IOCTL)
+			{
+				cemu_assert(sFSAClientArray[clientHandle].isAllocated);
+				FSAHandleCommandIoctl(sFSAClientArray.data() + clientHandle, cmd, (FSA_CMD_OPERATION_TYPE)cmd->args[0].value(), MEMPTR<void>(cmd->args[1]), MEMPTR<void>(cmd->args[3]));
+			}
+			else if (cmd->cmdId == IPCCommandId::IOS_IOCTLV)
+			{
+				cemu_assert(sFSAClientArray[clientHandle].isAllocated);
+				FSA_CMD_OPERATION_TYPE requestId = (FSA_CMD_OPERATION_TYPE)cmd->args[0].value();
+				uint32 numIn = cmd->args[1];
+				uint32 numOut = cmd->args[2];
+				IPCIoctlVector* vec = MEMPTR<IPCIoctlVector>{cmd->args[3]}.GetPtr();
+				FSAHandleCommandIoctlv(sFSAClientArray.data() + clientHandle, cmd, requestId, numIn, numOut, vec);
+			}
+			else
+				cemu_assert_unimplemented();
+		}
+
+		void FSAWorkerThread(FSAWorker* worker, size_t workerIndex)
+		{
+			SetThreadName(fmt::format("IOSU-FSA-W{}", workerIndex).c_str());
+			while (true)
+			{
+				IPCCommandBody* cmd = worker->cmdQueue.pop();
+				if (!cmd)
+					return; // shutdown signaled
+				FSAProcessClientCommand(cmd);
+			}
+		}
+
 		void FSAIoThread()
 		{
 			SetThreadName("IOSU-FSA");
@@ -854,28 +925,11 @@ namespace iosu
 					IOS_ResourceReply(cmd, (IOS_ERROR)clientIndex);
 					continue;
 				}
-				else if (cmd->cmdId == IPCCommandId::IOS_CLOSE)
-				{
-					cemu_assert(clientHandle < sFSAClientArray.size());
-					sFSAClientArray[clientHandle].ReleaseAndCleanup();
-					IOS_ResourceReply(cmd, IOS_ERROR_OK);
-					continue;
-				}
-				else if (cmd->cmdId == IPCCommandId::IOS_IOCTL)
-				{
-					cemu_assert(clientHandle < sFSAClientArray.size());
-					cemu_assert(sFSAClientArray[clientHandle].isAllocated);
-					FSAHandleCommandIoctl(sFSAClientArray.data() + clientHandle, cmd, (FSA_CMD_OPERATION_TYPE)cmd->args[0].value(), MEMPTR<void>(cmd->args[1]), MEMPTR<void>(cmd->args[3]));
-				}
-				else if (cmd->cmdId == IPCCommandId::IOS_IOCTLV)
+				else if (cmd->cmdId == IPCCommandId::IOS_CLOSE || cmd->cmdId == IPCCommandId::IOS_IOCTL || cmd->cmdId == IPCCommandId::IOS_IOCTLV)
 				{
+					// hand over to the worker owning this client. IOS_CLOSE goes through the same queue so it can't overtake pending requests
 					cemu_assert(clientHandle < sFSAClientArray.size());
-					cemu_assert(sFSAClientArray[clientHandle].isAllocated);
-					FSA_CMD_OPERATION_TYPE requestId = (FSA_CMD_OPERATION_TYPE)cmd->args[0].value();
-					uint32 numIn = cmd->args[1];
-					uint32 numOut = cmd->args[2];
-					IPCIoctlVector* vec = MEMPTR<IPCIoctlVector>{cmd->args[3]}.GetPtr();
-					FSAHandleCommandIoctlv(sFSAClientArray.data() + clientHandle, cmd, requestId, numIn, numOut, vec);
+					sFSAWorkers[clientHandle % sFSAWorkerCount].cmdQueue.push(cmd);
 				}
 				else
 				{
@@ -894,6 +948,9 @@ namespace iosu
 			IOS_ERROR r = IOS_RegisterResourceManager("/dev/fsa", sFSAIoMsgQueue);
 			IOS_DeviceAssociateId("/dev/fsa", 11);
 			cemu_assert(!IOS_ResultIsError(r));
+			sFSAWorkerCount = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, FSA_MAX_WORKERS);
+			for (size_t i = 0; i < sFSAWorkerCount; i++)
+				sFSAWorkers[i].thread = std::thread(FSAWorkerThread, &sFSAWorkers[i], i);
 			sFSAIoThread = std::thread(FSAIoThread);
 		}
 
@@ -901,6 +958,12 @@ namespace iosu
 		{
 			IOS_SendMessage(sFSAIoMsgQueue, 0, 0);
 			sFSAIoThread.join();
+			for (size_t i = 0; i < sFSAWorkerCount; i++)
+			{
+				sFSAWorkers[i].cmdQueue.push(nullptr);
+				sFSAWorkers[i].thread.join();
+			}
+			sFSAWorkerCount = 0;
 		}
 	} // namespace fsa
 } // namespace iosu
@@ -8,6 +8,7 @@
 #include "Cafe/HW/Espresso/Debugger/Debugger.h"
 #include "Cafe/GraphicPack/GraphicPack2.h"
 #include "util/ChunkedHeap/ChunkedHeap.h"
+#include "util/highresolutiontimer/HighResolutionTimer.h"
 
 #include <zlib.h>
 
@@ -337,12 +338,9 @@ rplSectionEntryNew_t* RPLLoader_GetSection(RPLModule* rplLoaderContext, sint32 s
 	return section;
 }
 
-RPLUncompressedSection* RPLLoader_LoadUncompressedSection(RPLModule* rplLoaderContext, sint32 sectionIndex)
+// returns nullptr on error. Does not modify the module state so it can be called from multiple threads at once
+RPLUncompressedSection* RPLLoader_UncompressSection(RPLModule* rplLoaderContext, const rplSectionEntryNew_t* section, sint32 sectionIndex)
 {
-	const rplSectionEntryNew_t* section = RPLLoader_GetSection(rplLoaderContext, sectionIndex);
-	if (section == nullptr)
-		return nullptr;
-
 	RPLUncompressedSection* uSection = new RPLUncompressedSection();
 
 	if ((uint32)section->type == 0x8)
@@ -357,7 +355,6 @@ RPLUncompressedSection* RPLLoader_LoadUncompressedSection(RPLModule* rplLoaderCo
 	{
 		// BSS
 		cemuLog_log(LogType::Force, "RPLLoader: Raw data for section {} exceeds bounds of RPL file", sectionIndex);
-		rplLoaderContext->hasError = true;
 		delete uSection;
 		return nullptr;
 	}
@@ -369,7 +366,6 @@ RPLUncompressedSection* RPLLoader_LoadUncompressedSection(RPLModule* rplLoaderCo
 		if (!RPLLoader_CheckBounds(rplLoaderContext, section->fileOffset, sizeof(uint32be)) )
 		{
 			cemuLog_log(LogType::Force, "RPLLoader: Uncompressed data of section {} is too large", sectionIndex);
-			rplLoaderContext->hasError = true;
 			delete uSection;
 			return nullptr;
 		}
@@ -377,7 +373,6 @@ RPLUncompressedSection* RPLLoader_LoadUncompressedSection(RPLModule* rplLoaderCo
 		if (uncompressedSize >= 1*1024*1024*1024) // sections bigger than 1GB not allowed
 		{
 			cemuLog_log(LogType::Force, "RPLLoader: Uncompressed data of section {} is too large", sectionIndex);
-			rplLoaderContext->hasError = true;
 			delete uSection;
 			return nullptr;
 		}
@@ -399,7 +394,6 @@ RPLUncompressedSection* RPLLoader_LoadUncompressedSection(RPLModule* rplLoaderCo
 			if ((ret != Z_OK && ret != Z_STREAM_END) || strm.avail_in != 0 || strm.avail_out != 0)
 			{
 				cemuLog_log(LogType::Force, "RPLLoader: Error while inflating data for section {}", sectionIndex);
-				rplLoaderContext->hasError = true;
 				delete uSection;
 				return nullptr;
 			}
@@ -415,7 +409,76 @@ RPLUncompressedSection* RPLLoader_LoadUncompressedSection(RPLModule* rplLoaderCo
 	return uSection;
 }
 
-bool RPLLoader_LoadSingleSection(RPLModule* rplLoaderContext, sint32 sectionIndex, RPLMappingRegion* regionMappingInfo, MPTR mappedAddress)
+RPLUncompressedSection* RPLLoader_LoadUncompressedSection(RPLModule* rplLoaderContext, sint32 sectionIndex)
+{
+	const rplSectionEntryNew_t* section = RPLLoader_GetSection(rplLoaderContext, sectionIndex);
+	if (section == nullptr)
+		return nullptr;
+	RPLUncompressedSection* uSection = RPLLoader_UncompressSection(rplLoaderContext, section, sectionIndex);
+	if (uSection == nullptr)
+		rplLoaderContext->hasError = true;
+	return uSection;
+}
+
+// inflates all compressed sections which are going to be mapped into guest memory, using multiple threads
+// sections are independent of each other so the result is identical to decompressing them one by one in RPLLoader_LoadSingleSection
+std::vector<std::unique_ptr<RPLUncompressedSection>> RPLLoader_DecompressSectionsParallel(RPLModule* rplLoaderContext)
+{
+	sint32 sectionCount = rplLoaderContext->rplHeader.sectionTableEntryCount;
+	std::vector<std::unique_ptr<RPLUncompressedSection>> uncompressedSections(sectionCount);
+	std::vector<sint32> compressedSectionIndices;
+	for (sint32 i = 0; i < sectionCount; i++)
+	{
+		rplSectionEntryNew_t* section = rplLoaderContext->sectionTablePtr + i;
+		if (section->sectionSize == 0 || (uint32)section->type == 0x8)
+			continue;
+		if (((uint32)section->flags & 2) == 0)
+			continue; // not mapped
+		if (((uint32)section->flags & SHF_RPL_COMPRESSED) == 0)
+			continue;
+		compressedSectionIndices.emplace_back(i);
+	}
+	if (compressedSectionIndices.empty())
+		return uncompressedSections;
+	std::atomic<size_t> nextIndex = 0;
+	auto decompressWorker = [&]()
+	{
+		while (true)
+		{
+			size_t index = nextIndex.fetch_add(1);
+			if (index >= compressedSectionIndices.size())
+				break;
+			sint32 sectionIndex = compressedSectionIndices[index];
+			uncompressedSections[sectionIndex].reset(RPLLoader_UncompressSection(rplLoaderContext, rplLoaderContext->sectionTablePtr + sectionIndex, sectionIndex));
+#ifdef CEMU_DEBUG_ASSERT
+			// verify against the CRC table of the RPL
+			uint32 expectedCRC = rplLoaderContext->GetSectionCRC(sectionIndex);
+			if (uncompressedSections[sectionIndex] && expectedCRC != 0)
+			{
+				uint32 calculatedCRC = crc32_calc(0, uncompressedSections[sectionIndex]->sectionData.data(), uncompressedSections[sectionIndex]->sectionData.size());
+				if (calculatedCRC != expectedCRC)
+					cemuLog_logDebug(LogType::Force, "RPLLoader: Section {} of {} has CRC mismatch - Calculated: {:08x} Actual: {:08x}", sectionIndex, rplLoaderContext->moduleName2, calculatedCRC, expectedCRC);
+			}
+#endif
+		}
+	};
+	size_t threadCount = std::min<size_t>(std::max<size_t>(std::thread::hardware_concurrency(), 1), compressedSectionIndices.size());
+	std::vector<std::thread> workerThreads;
+	for (size_t i = 1; i < threadCount; i++)
+		workerThreads.emplace_back(decompressWorker);
+	decompressWorker();
+	for (auto& thread : workerThreads)
+		thread.join();
+	// the workers only fill in their own entry, errors are flagged here once all of them are done
+	for (sint32 sectionIndex : compressedSectionIndices)
+	{
+		if (!uncompressedSections[sectionIndex])
+			rplLoaderContext->hasError = true;
+	}
+	return uncompressedSections;
+}
+
+bool RPLLoader_LoadSingleSection(RPLModule* rplLoaderContext, sint32 sectionIndex, RPLMappingRegion* regionMappingInfo, MPTR mappedAddress, std::unique_ptr<RPLUncompressedSection> uncompressedSection)
 {
 	rplSectionEntryNew_t* section = RPLLoader_GetSection(rplLoaderContext, sectionIndex);
 	if (section == nullptr)
@@ -431,8 +494,9 @@ bool RPLLoader_LoadSingleSection(RPLModule* rplLoaderContext, sint32 sectionInde
 	cemu_assert(rplLoaderContext->debugSectionLoadMask[sectionIndex] == false);
 	rplLoaderContext->debugSectionLoadMask[sectionIndex] = true;
 
-	// extract section
-	RPLUncompressedSection* uncompressedSection = RPLLoader_LoadUncompressedSection(rplLoaderContext, sectionIndex);
+	// extract section (unless it was already decompressed ahead of time)
+	if (!uncompressedSection)
+		uncompressedSection.reset(RPLLoader_LoadUncompressedSection(rplLoaderContext, sectionIndex));
 	if (uncompressedSection == nullptr)
 	{
 		rplLoaderContext->hasError = true;
@@ -450,11 +514,25 @@ bool RPLLoader_LoadSingleSection(RPLModule* rplLoaderContext, sint32 sectionInde
 		cemuLog_log(LogType::Force, "RPLLoader: Section {} uncompresses to {} bytes but sectionSize is {}", sectionIndex, uncompressedSection->sectionData.size(), (uint32)section->sectionSize);
 
 	section->sectionSize = uncompressedSection->sectionData.size();
-
-	delete uncompressedSection;
 	return true;
 }
 
+void RPLLoader_BuildExportIndex(RPLModule* rplLoaderContext)
+{
+	auto buildIndex = [](std::unordered_map<std::string_view, uint32>& index, rplExportTableEntry_t* exportTable, uint32 exportCount)
+	{
+		index.clear();
+		if (!exportTable)
+			return;
+		index.reserve(exportCount);
+		char* exportNameData = (char*)((uint8*)exportTable - 8);
+		for (uint32 f = 0; f < exportCount; f++)
+			index.try_emplace(std::string_view(exportNameData + (uint32)exportTable[f].nameOffset), f); // on duplicates the first entry wins, same as a linear scan
+	};
+	buildIndex(rplLoaderContext->exportFunctionIndex, rplLoaderContext->exportFDataPtr, rplLoaderContext->exportFCount);
+	buildIndex(rplLoaderContext->exportDataIndex, rplLoaderContext->exportDDataPtr, rplLoaderContext->exportDCount);
+}
+
 bool RPLLoader_LoadSections(sint32 aProcId, RPLModule* rplLoaderContext)
 {
 	RPLRegionMappingTable regionMappingTable;
@@ -535,6 +613,8 @@ bool RPLLoader_LoadSections(sint32 aProcId, RPLModule* rplLoaderContext)
 	rplLoaderContext->regionSize_loaderInfo = regionLoaderinfoSize;
 	rplLoaderContext->regionSize_text = regionTextSize;
 
+	std::vector<std::unique_ptr<RPLUncompressedSection>> uncompressedSections = RPLLoader_DecompressSectionsParallel(rplLoaderContext);
+
 	// load data sections
 	for (sint32 i = 0; i < (sint32)rplLoaderContext->rplHeader.sectionTableEntryCount; i++)
 	{
@@ -550,7 +630,7 @@ bool RPLLoader_LoadSections(sint32 aProcId, RPLModule* rplLoaderContext)
 		if ((sectionFlags & 1) == 0)
 			continue;
 
-		RPLLoader_LoadSingleSection(rplLoaderContext, i, regionMappingTable.region + RPL_MAPPING_REGION_DATA, rplLoaderContext->regionMappingBase_data);
+		RPLLoader_LoadSingleSection(rplLoaderContext, i, regionMappingTable.region + RPL_MAPPING_REGION_DATA, rplLoaderContext->regionMappingBase_data, std::move(uncompressedSections[i]));
 	}
 	// load loaderinfo sections
 	for (sint32 i = 0; i < (sint32)rplLoaderContext->rplHeader.sectionTableEntryCount; i++)
@@ -568,7 +648,7 @@ bool RPLLoader_LoadSections(sint32 aProcId, RPLModule* rplLoaderContext)
 			continue;
 		bool readRaw = false;
 
-		RPLLoader_LoadSingleSection(rplLoaderContext, i, regionMappingTable.region + RPL_MAPPING_REGION_LOADERINFO, rplLoaderContext->regionMappingBase_loaderInfo);
+		RPLLoader_LoadSingleSection(rplLoaderContext, i, regionMappingTable.region + RPL_MAPPING_REGION_LOADERINFO, rplLoaderContext->regionMappingBase_loaderInfo, std::move(uncompressedSections[i]));
 
 		if (sectionType == SHT_RPL_EXPORTS)
 		{
@@ -585,6 +665,7 @@ bool RPLLoader_LoadSections(sint32 aProcId, RPLModule* rplLoaderContext)
 			}
 		}
 	}
+	RPLLoader_BuildExportIndex(rplLoaderContext);
 	// load text sections
 	uint32 textSectionMappedBase = rplLoaderContext->regionMappingBase_text.GetMPTR() + (uint32)rplLoaderContext->fileInfo.trampolineAdjustment; // leave some space for trampolines before the code section begins
 	for (sint32 i = 0; i < (sint32)rplLoaderContext->rplHeader.sectionTableEntryCount; i++)
@@ -609,7 +690,7 @@ bool RPLLoader_LoadSections(sint32 aProcId, RPLModule* rplLoaderContext)
 			cemu_assert_debug(false);
 		}
 
-		RPLLoader_LoadSingleSection(rplLoaderContext, i, regionMappingTable.region + RPL_MAPPING_REGION_TEXT, textSectionMappedBase);
+		RPLLoader_LoadSingleSection(rplLoaderContext, i, regionMappingTable.region + RPL_MAPPING_REGION_TEXT, textSectionMappedBase, std::move(uncompressedSections[i]));
 	}
 	// load temp region sections
 	uint32 tempRegionSize = regionMappingTable.region[RPL_MAPPING_REGION_TEMP].endAddress - regionMappingTable.region[RPL_MAPPING_REGION_TEMP].baseAddress;
@@ -681,14 +762,23 @@ struct RPLSharedImportTracking
 
 static_assert(sizeof(RPLFileSymtabEntry) == 0x10, "rplSymtabEntry_t has invalid size");
 
-typedef struct
+struct MappedFunctionImportKey
 {
 	uint64 hash1;
 	uint64 hash2;
-	uint32 address;
-}mappedFunctionImport_t;
 
-std::vector<mappedFunctionImport_t> list_mappedFunctionImports = std::vector<mappedFunctionImport_t>();
+	bool operator==(const MappedFunctionImportKey& other) const = default;
+};
+
+struct MappedFunctionImportKeyHasher
+{
+	size_t operator()(const MappedFunctionImportKey& key) const
+	{
+		return (size_t)(key.hash1 ^ std::rotl<uint64>(key.hash2, 32));
+	}
+};
+
+std::unordered_map<MappedFunctionImportKey, MPTR, MappedFunctionImportKeyHasher> s_mappedFunctionImports;
 
 void _calculateMappedImportNameHash(const char* rplName, const char* funcName, uint64* h1Out, uint64* h2Out)
 {
@@ -739,13 +829,9 @@ uint32 rpl_mapHLEImport(RPLModule* rplLoaderContext, const char* rplName, const
 	uint64 mappedImportHash2;
 	_calculateMappedImportNameHash(rplName, funcName, &mappedImportHash1, &mappedImportHash2);
 	// find already mapped name
-	for (auto& importItr : list_mappedFunctionImports)
-	{
-		if (importItr.hash1 == mappedImportHash1 && importItr.hash2 == mappedImportHash2)
-		{
-			return importItr.address;
-		}
-	}
+	MappedFunctionImportKey importKey{ mappedImportHash1, mappedImportHash2 };
+	if (auto it = s_mappedFunctionImports.find(importKey); it != s_mappedFunctionImports.end())
+		return it->second;
 	// copy lib file name and cut off .rpl from libName if present
 	char libName[512];
 	strcpy_s(libName, rplName);
@@ -767,11 +853,7 @@ uint32 rpl_mapHLEImport(RPLModule* rplLoaderContext, const char* rplName, const
 		uint32 opcode = (1 << 26) | functionIndex;
 		memory_write<uint32>(codeAddr, opcode);
 		// register mapped import
-		mappedFunctionImport_t newImport;
-		newImport.hash1 = mappedImportHash1;
-		newImport.hash2 = mappedImportHash2;
-		newImport.address = codeAddr;
-		list_mappedFunctionImports.push_back(newImport);
+		s_mappedFunctionImports.emplace(importKey, codeAddr);
 		// remember in symbol storage for debugger
 		rplSymbolStorage_store(libName, funcName, codeAddr);
 		return codeAddr;
@@ -802,17 +884,25 @@ uint32 rpl_mapHLEImport(RPLModule* rplLoaderContext, const char* rplName, const
 	// align address to 4 byte boundary
 	currentAddress = (currentAddress + 3)&~3;
 	// register mapped import
-	mappedFunctionImport_t newImport;
-	newImport.hash1 = mappedImportHash1;
-	newImport.hash2 = mappedImportHash2;
-	newImport.address = codeStart;
-	list_mappedFunctionImports.push_back(newImport);
+	s_mappedFunctionImports.emplace(importKey, codeStart);
 	// remember in symbol storage for debugger
 	rplSymbolStorage_store(libName, funcName, codeStart);
 	// return address of code start
 	return codeStart;
 }
 
+bool RPLLoader_LookupModuleExport(RPLModule* rplLoaderContext, bool isData, std::string_view exportName, uint32& exportAddressOut)
+{
+	auto& exportIndex = isData ? rplLoaderContext->exportDataIndex : rplLoaderContext->exportFunctionIndex;
+	auto it = exportIndex.find(exportName);
+	if (it == exportIndex.end())
+		return false;
+	// the index is built before relocations are applied, so the address is read from the export table itself
+	rplExportTableEntry_t* exportTable = isData ? rplLoaderContext->exportDDataPtr : rplLoaderContext->exportFDataPtr;
+	exportAddressOut = exportTable[it->second].virtualOffset;
+	return true;
+}
+
 MPTR RPLLoader_FindRPLExport(RPLModule* rplLoaderContext, const char* symbolName, bool isData)
 {
 	if (isData)
@@ -820,18 +910,9 @@ MPTR RPLLoader_FindRPLExport(RPLModule* rplLoaderContext, const char* symbolName
 		cemu_assert_debug(false);
 		// todo - look in DDataPtr
 	}
-	if (rplLoaderContext->exportFDataPtr)
-	{
-		char* exportNameData = (char*)((uint8*)rplLoaderContext->exportFDataPtr - 8);
-		for (uint32 f = 0; f < rplLoaderContext->exportFCount; f++)
-		{
-			char* name = exportNameData + (uint32)rplLoaderContext->exportFDataPtr[f].nameOffset;
-			if (strcmp(name, symbolName) == 0)
-			{
-				return (uint32)rplLoaderContext->exportFDataPtr[f].virtualOffset;
-			}
-		}
-	}
+	uint32 exportAddress;
+	if (RPLLoader_LookupModuleExport(rplLoaderContext, false, symbolName, exportAddress))
+		return exportAddress;
 	return MPTR_NULL;
 }
 
@@ -858,34 +939,9 @@ MPTR _findHLEExport(RPLModule* rplLoaderContext, RPLSharedImportTracking* shared
 
 uint32 RPLLoader_FindModuleExport(RPLModule* rplLoaderContext, bool isData, const char* exportName)
 {
-	if (isData == false)
-	{
-		// find function export
-		char* exportNameData = (char*)((uint8*)rplLoaderContext->exportFDataPtr - 8);
-		for (uint32 f = 0; f < rplLoaderContext->exportFCount; f++)
-		{
-			char* name = exportNameData + (uint32)rplLoaderContext->exportFDataPtr[f].nameOffset;
-			if (strcmp(name, exportName) == 0)
-			{
-				uint32 exportAddress = rplLoaderContext->exportFDataPtr[f].virtualOffset;
-				return exportAddress;
-			}
-		}
-	}
-	else
-	{
-		// find data export
-		char* exportNameData = (char*)((uint8*)rplLoaderContext->exportDDataPtr - 8);
-		for (uint32 f = 0; f < rplLoaderContext->exportDCount; f++)
-		{
-			char* name = exportNameData + (uint32)rplLoaderContext->exportDDataPtr[f].nameOffset;
-			if (strcmp(name, exportName) == 0)
-			{
-				uint32 exportAddress = rplLoaderContext->exportDDataPtr[f].virtualOffset;
-				return exportAddress;
-			}
-		}
-	}
+	uint32 exportAddress;
+	if (RPLLoader_LookupModuleExport(rplLoaderContext, isData, exportName, exportAddress))
+		return exportAddress;
 	return 0;
 }
 
@@ -973,58 +1029,21 @@ bool RPLLoader_FixImportSymbols(RPLModule* rplLoaderContext, sint32 symtabSectio
 				uint32 nameOffset = sym->ukn00;
 				char* symbolName = (char*)strtabData + nameOffset;
 
-				bool foundExport = false;
-				if ((rplLoaderContext->sectionTablePtr[symSectionIndex].flags & 0x4) != 0)
+				bool isFunctionExport = (rplLoaderContext->sectionTablePtr[symSectionIndex].flags & 0x4) != 0;
+				uint32 exportAddress;
+				if (RPLLoader_LookupModuleExport(ctxExportModule, !isFunctionExport, symbolName, exportAddress))
 				{
-					// find function export
-					char* exportNameData = (char*)((uint8*)ctxExportModule->exportFDataPtr - 8);
-					for (uint32 f = 0; f < ctxExportModule->exportFCount; f++)
-					{
-						char* name = exportNameData + (uint32)ctxExportModule->exportFDataPtr[f].nameOffset;
-						if (strcmp(name, symbolName) == 0)
-						{
-							uint32 exportAddress = ctxExportModule->exportFDataPtr[f].virtualOffset;
-							sym->symbolAddress = exportAddress;
-							foundExport = true;
-							break;
-						}
-					}
+					sym->symbolAddress = exportAddress;
 				}
 				else
 				{
-					// find data export
-					char* exportNameData = (char*)((uint8*)ctxExportModule->exportDDataPtr - 8);
-					for (uint32 f = 0; f < ctxExportModule->exportDCount; f++)
-					{
-						char* name = exportNameData + (uint32)ctxExportModule->exportDDataPtr[f].nameOffset;
-						if (strcmp(name, symbolName) == 0)
-						{
-							uint32 exportAddress = ctxExportModule->exportDDataPtr[f].virtualOffset;
-							sym->symbolAddress = exportAddress;
-							foundExport = true;
-							break;
-						}
-					}
-				}
-				if (foundExport == false)
-				{
 #ifdef CEMU_DEBUG_ASSERT
 					if (nameOffset > 0)
 					{
 						cemuLog_logDebug(LogType::Force, "export not found - force lookup in function exports");
 						// workaround - force look up export in function exports
-						char* exportNameData = (char*)((uint8*)ctxExportModule->exportFDataPtr - 8);
-						for (uint32 f = 0; f < ctxExportModule->exportFCount; f++)
-						{
-							char* name = exportNameData + (uint32)ctxExportModule->exportFDataPtr[f].nameOffset;
-							if (strcmp(name, symbolName) == 0)
-							{
-								uint32 exportAddress = ctxExportModule->exportFDataPtr[f].virtualOffset;
-								sym->symbolAddress = exportAddress;
-								foundExport = true;
-								break;
-							}
-						}
+						if (RPLLoader_LookupModuleExport(ctxExportModule, false, symbolName, exportAddress))
+							sym->symbolAddress = exportAddress;
 					}
 #endif
 					continue;
@@ -1855,12 +1874,16 @@ void RPLLoader_FixModuleTLSIndex(RPLModule* rplLoaderContext)
 
 void RPLLoader_Link()
 {
+	BenchmarkTimer linkTimer;
+	linkTimer.Start();
+	sint32 numLinkedModules = 0;
 	// calculate TLS index
 	for (sint32 i = 0; i < rplModuleCount; i++)
 	{
 		if (rplModuleList[i]->isLinked)
 			continue;
 		RPLLoader_FixModuleTLSIndex(rplModuleList[i]);
+		numLinkedModules++;
 	}
 	// resolve relocs
 	for (sint32 i = 0; i < rplModuleCount; i++)
@@ -1880,6 +1903,9 @@ void RPLLoader_Link()
 		GraphicPack2::NotifyModuleLoaded(rplModuleList[i]);
 		g_debuggerDispatcher.NotifyModuleLoaded(rplModuleList[i]);
 	}
+	linkTimer.Stop();
+	if (numLinkedModules > 0)
+		cemuLog_log(LogType::Force, "RPLLoader: Linked {} module(s) in {:.2f}ms", numLinkedModules, linkTimer.GetElapsedMilliseconds());
 }
 
 uint32 RPLLoader_GetModuleEntrypoint(RPLModule* rplLoaderContext)
@@ -2386,7 +2412,7 @@ void RPLLoader_ResetState()
 	rplSymbolStorage_unloadAll();
 	// free all code imports
 	g_heapTrampolineArea.releaseAll();
-	list_mappedFunctionImports.clear();
+	s_mappedFunctionImports.clear();
 	g_map_callableExports.clear();
 	rplLoader_applicationHasMemoryControl = false;
 	rplLoader_maxCodeAddress = 0;
@@ -163,6 +163,9 @@ struct RPLModule
 	rplExportTableEntry_t* exportDDataPtr;
 	uint32 exportFCount;
 	rplExportTableEntry_t* exportFDataPtr;
+	// export name -> index into the export table, names point into the export sections
+	std::unordered_map<std::string_view, uint32> exportFunctionIndex;
+	std::unordered_map<std::string_view, uint32> exportDataIndex;
 
 	std::string moduleName2;
 	
@@ -32,30 +32,35 @@
 #include "Cafe/OS/libs/camera/camera.h"
 #include "../libs/swkbd/swkbd.h"
 
-struct osFunctionEntry_t
+struct osLibExportKey
 {
 	uint32 libHashA;
 	uint32 libHashB;
 	uint32 funcHashA;
 	uint32 funcHashB;
-	std::string name;
-	HLEIDX hleFunc;
 
-	osFunctionEntry_t(uint32 libHashA, uint32 libHashB, uint32 funcHashA, uint32 funcHashB, std::string_view name, HLEIDX hleFunc) :
-		libHashA(libHashA), libHashB(libHashB), funcHashA(funcHashA), funcHashB(funcHashB), name(name), hleFunc(hleFunc) {};
+	bool operator==(const osLibExportKey& other) const = default;
 };
 
-typedef struct
+struct osLibExportKeyHasher
 {
-	uint32 libHashA;
-	uint32 libHashB;
-	uint32 funcHashA;
-	uint32 funcHashB;
-	uint32 vPtr;
-}osPointerEntry_t;
+	size_t operator()(const osLibExportKey& key) const
+	{
+		// the name hashes are already well distributed, combining them is sufficient
+		return (size_t)((((uint64)key.libHashA << 32) | key.funcHashA) ^ (((uint64)key.funcHashB << 32) | key.libHashB));
+	}
+};
+
+struct osFunctionEntry_t
+{
+	std::string name;
+	HLEIDX hleFunc;
+
+	osFunctionEntry_t(std::string_view name, HLEIDX hleFunc) : name(name), hleFunc(hleFunc) {};
+};
 
-std::vector<osFunctionEntry_t>* s_osFunctionTable;
-std::vector<osPointerEntry_t> osDataTable;
+std::unordered_map<osLibExportKey, osFunctionEntry_t, osLibExportKeyHasher>* s_osFunctionTable;
+std::unordered_map<osLibExportKey, uint32, osLibExportKeyHasher> s_osDataTable;
 
 void osLib_generateHashFromName(const char* name, uint32* hashA, uint32* hashB)
 {
@@ -77,29 +82,27 @@ void osLib_generateHashFromName(const char* name, uint32* hashA, uint32* hashB)
 	*hashB = h2;
 }
 
+static osLibExportKey osLib_generateExportKey(const char* libraryName, const char* functionName)
+{
+	osLibExportKey key;
+	osLib_generateHashFromName(libraryName, &key.libHashA, &key.libHashB);
+	osLib_generateHashFromName(functionName, &key.funcHashA, &key.funcHashB);
+	return key;
+}
+
 void osLib_addFunctionInternal(const char* libraryName, const char* functionName, void(*osFunction)(PPCInterpreter_t* hCPU))
 {
 	if (!s_osFunctionTable)
-		s_osFunctionTable = new std::vector<osFunctionEntry_t>(); // replace with static allocation + constinit once we have C++20 available
-	// calculate hash
-	uint32 libHashA, libHashB;
-	uint32 funcHashA, funcHashB;
-	osLib_generateHashFromName(libraryName, &libHashA, &libHashB);
-	osLib_generateHashFromName(functionName, &funcHashA, &funcHashB);
+		s_osFunctionTable = new std::unordered_map<osLibExportKey, osFunctionEntry_t, osLibExportKeyHasher>(); // replace with static allocation + constinit once we have C++20 available
+	osLibExportKey key = osLib_generateExportKey(libraryName, functionName);
 	std::string hleName = fmt::format("{}.{}", libraryName, functionName);
 	// if entry already exists, update it
-	for (auto& it : *s_osFunctionTable)
+	if (auto it = s_osFunctionTable->find(key); it != s_osFunctionTable->end())
 	{
-		if (it.libHashA == libHashA &&
-			it.libHashB == libHashB &&
-			it.funcHashA == funcHashA &&
-			it.funcHashB == funcHashB)
-		{
-			it.hleFunc = PPCInterpreter_registerHLECall(osFunction, hleName);
-			return;
-		}
+		it->second.hleFunc = PPCInterpreter_registerHLECall(osFunction, hleName);
+		return;
 	}
-	s_osFunctionTable->emplace_back(libHashA, libHashB, funcHashA, funcHashB, hleName, PPCInterpreter_registerHLECall(osFunction, hleName));
+	s_osFunctionTable->emplace(key, osFunctionEntry_t(hleName, PPCInterpreter_registerHLECall(osFunction, hleName)));
 }
 
 extern "C" DLLEXPORT void osLib_registerHLEFunction(const char* libraryName, const char* functionName, void(*osFunction)(PPCInterpreter_t * hCPU))
@@ -109,69 +112,24 @@ extern "C" DLLEXPORT void osLib_registerHLEFunction(const char* libraryName, con
 
 sint32 osLib_getFunctionIndex(const char* libraryName, const char* functionName)
 {
-	uint32 libHashA, libHashB;
-	uint32 funcHashA, funcHashB;
-	osLib_generateHashFromName(libraryName, &libHashA, &libHashB);
-	osLib_generateHashFromName(functionName, &funcHashA, &funcHashB);
-	for (auto& it : *s_osFunctionTable)
-	{
-		if (it.libHashA == libHashA &&
-			it.libHashB == libHashB &&
-			it.funcHashA == funcHashA &&
-			it.funcHashB == funcHashB)
-		{
-			return it.hleFunc;
-		}
-	}
-	return -1;
+	auto it = s_osFunctionTable->find(osLib_generateExportKey(libraryName, functionName));
+	if (it == s_osFunctionTable->end())
+		return -1;
+	return it->second.hleFunc;
 }
 
 void osLib_addVirtualPointer(const char* libraryName, const char* functionName, uint32 vPtr)
 {
-	// calculate hash
-	uint32 libHashA, libHashB;
-	uint32 funcHashA, funcHashB;
-	osLib_generateHashFromName(libraryName, &libHashA, &libHashB);
-	osLib_generateHashFromName(functionName, &funcHashA, &funcHashB);
 	// if entry already exists, update it
-	for (auto& it : osDataTable)
-	{
-		if (it.libHashA == libHashA &&
-			it.libHashB == libHashB &&
-			it.funcHashA == funcHashA &&
-			it.funcHashB == funcHashB)
-		{
-			it.vPtr = vPtr;
-			return;
-		}
-	}
-	// add entry
-	auto writeIndex = osDataTable.size();
-	osDataTable.resize(osDataTable.size() + 1);
-	osDataTable[writeIndex].libHashA = libHashA;
-	osDataTable[writeIndex].libHashB = libHashB;
-	osDataTable[writeIndex].funcHashA = funcHashA;
-	osDataTable[writeIndex].funcHashB = funcHashB;
-	osDataTable[writeIndex].vPtr = vPtr;
+	s_osDataTable.insert_or_assign(osLib_generateExportKey(libraryName, functionName), vPtr);
 }
 
 uint32 osLib_getPointer(const char* libraryName, const char* functionName)
 {
-	uint32 libHashA, libHashB;
-	uint32 funcHashA, funcHashB;
-	osLib_generateHashFromName(libraryName, &libHashA, &libHashB);
-	osLib_generateHashFromName(functionName, &funcHashA, &funcHashB);
-	for (auto& it : osDataTable)
-	{
-		if (it.libHashA == libHashA &&
-			it.libHashB == libHashB &&
-			it.funcHashA == funcHashA &&
-			it.funcHashB == funcHashB)
-		{
-			return it.vPtr;
-		}
-	}
-	return 0xFFFFFFFF;
+	auto it = s_osDataTable.find(osLib_generateExportKey(libraryName, functionName));
+	if (it == s_osDataTable.end())
+		return 0xFFFFFFFF;
+	return it->second;
 }
 
 void osLib_returnFromFunction(PPCInterpreter_t* hCPU, uint32 returnValue)
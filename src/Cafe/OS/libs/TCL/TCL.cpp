@@ -2,6 +2,7 @@
 #include "Cafe/OS/libs/TCL/TCL.h"
 
 #include "HW/Latte/Core/LattePM4.h"
+#include "HW/Latte/Core/LatteCapture.h"
 
 namespace TCL
 {
@@ -64,43 +65,116 @@ namespace TCL
 
 	static constexpr uint32 TCL_RING_BUFFER_SIZE = 4096; // in U32s
 
-	std::atomic<uint32> tclRingBufferA[TCL_RING_BUFFER_SIZE];
+	// single producer (PPC side) and single consumer (GPU thread) ring buffer
+	// words are stored in guest byte order so that both sides can copy whole spans
+	uint32be tclRingBufferA[TCL_RING_BUFFER_SIZE];
 	std::atomic<uint32> tclRingBufferA_readIndex{0};
-	uint32 tclRingBufferA_writeIndex{0};
+	std::atomic<uint32> tclRingBufferA_writeIndex{0};
+	std::atomic<uint32> tclRingBufferA_emptyReadCount{0}; // only modified by the GPU thread
 
-	// GPU code calls this to grab the next command word
-	bool TCLGPUReadRBWord(uint32& cmdWord)
+	// when either side runs out of work it spins briefly and then goes to sleep until the other side signals progress
+	std::mutex tclRingBufferA_waitMutex;
+	std::condition_variable tclRingBufferA_gpuWaitCond; // GPU waits for new commands
+	std::condition_variable tclRingBufferA_cpuWaitCond; // CPU waits for free space
+	std::atomic<bool> tclRingBufferA_gpuSleeping{false};
+	std::atomic<bool> tclRingBufferA_cpuSleeping{false};
+	uint32 tclRingBufferA_gpuSpinCount{256}; // adapted based on whether spinning was successful. Only accessed by the GPU thread
+
+	static constexpr uint32 TCL_SPIN_COUNT_MIN = 16;
+	static constexpr uint32 TCL_SPIN_COUNT_MAX = 8192;
+	static constexpr uint32 TCL_CPU_SPIN_COUNT = 256;
+
+	uint32 _TCLGetNumAvailableWords()
+	{
+		return (tclRingBufferA_writeIndex.load(std::memory_order_acquire) - tclRingBufferA_readIndex.load(std::memory_order_relaxed)) & (TCL_RING_BUFFER_SIZE - 1);
+	}
+
+	// GPU code calls this to grab up to maxWords command words. Returns the number of words copied
+	uint32 TCLGPUReadRBWords(uint32be* cmdWords, uint32 maxWords)
 	{
-		if (tclRingBufferA_readIndex == tclRingBufferA_writeIndex)
-			return false;
-		cmdWord = tclRingBufferA[tclRingBufferA_readIndex];
-		tclRingBufferA_readIndex = (tclRingBufferA_readIndex+1) % TCL_RING_BUFFER_SIZE;
-		return true;
+		uint32 readIndex = tclRingBufferA_readIndex.load(std::memory_order_relaxed);
+		uint32 numWords = std::min(_TCLGetNumAvailableWords(), maxWords);
+		if (numWords == 0)
+		{
+			tclRingBufferA_emptyReadCount.store(tclRingBufferA_emptyReadCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+			return 0;
+		}
+		uint32 firstSpan = std::min(numWords, TCL_RING_BUFFER_SIZE - readIndex);
+		memcpy(cmdWords, tclRingBufferA + readIndex, firstSpan * sizeof(uint32be));
+		if (firstSpan < numWords)
+			memcpy(cmdWords + firstSpan, tclRingBufferA, (numWords - firstSpan) * sizeof(uint32be));
+		tclRingBufferA_readIndex.store((readIndex + numWords) & (TCL_RING_BUFFER_SIZE - 1), std::memory_order_seq_cst);
+		if (tclRingBufferA_cpuSleeping.load(std::memory_order_seq_cst))
+		{
+			std::unique_lock _l(tclRingBufferA_waitMutex);
+			tclRingBufferA_cpuWaitCond.notify_one();
+		}
+		return numWords;
+	}
+
+	// GPU code calls this when the ring buffer is empty. Returns once new data is available or after the timeout elapsed
+	void TCLGPUWaitForRBData(uint32 timeoutUs)
+	{
+		// commands usually arrive in bursts, so spin for a bit first
+		for (uint32 i = 0; i < tclRingBufferA_gpuSpinCount; i++)
+		{
+			if (_TCLGetNumAvailableWords() != 0)
+			{
+				tclRingBufferA_gpuSpinCount = std::min(tclRingBufferA_gpuSpinCount * 2, TCL_SPIN_COUNT_MAX);
+				return;
+			}
+			_mm_pause();
+		}
+		tclRingBufferA_gpuSpinCount = std::max(tclRingBufferA_gpuSpinCount / 2, TCL_SPIN_COUNT_MIN);
+		if (timeoutUs == 0)
+			return;
+		std::unique_lock _l(tclRingBufferA_waitMutex);
+		tclRingBufferA_gpuSleeping.store(true, std::memory_order_seq_cst);
+		if (tclRingBufferA_writeIndex.load(std::memory_order_seq_cst) == tclRingBufferA_readIndex.load(std::memory_order_relaxed))
+			tclRingBufferA_gpuWaitCond.wait_for(_l, std::chrono::microseconds(timeoutUs));
+		tclRingBufferA_gpuSleeping.store(false, std::memory_order_relaxed);
 	}
 
 	void TCLWaitForRBSpace(uint32be numU32s)
 	{
-		while ( true )
+		auto hasSpace = [&]() -> bool
 		{
-			uint32 distance = (tclRingBufferA_readIndex + TCL_RING_BUFFER_SIZE - tclRingBufferA_writeIndex) & (TCL_RING_BUFFER_SIZE - 1);
-			if (tclRingBufferA_writeIndex == tclRingBufferA_readIndex) // buffer completely empty
+			uint32 readIndex = tclRingBufferA_readIndex.load(std::memory_order_seq_cst);
+			uint32 writeIndex = tclRingBufferA_writeIndex.load(std::memory_order_relaxed);
+			uint32 distance = (readIndex + TCL_RING_BUFFER_SIZE - writeIndex) & (TCL_RING_BUFFER_SIZE - 1);
+			if (writeIndex == readIndex) // buffer completely empty
 				distance = TCL_RING_BUFFER_SIZE;
-			if (distance >= numU32s+1) // assume distance minus one, because we are never allowed to completely wrap around
-				break;
+			return distance >= numU32s+1; // assume distance minus one, because we are never allowed to completely wrap around
+		};
+		for (uint32 i = 0; i < TCL_CPU_SPIN_COUNT; i++)
+		{
+			if (hasSpace())
+				return;
 			_mm_pause();
 		}
+		std::unique_lock _l(tclRingBufferA_waitMutex);
+		tclRingBufferA_cpuSleeping.store(true, std::memory_order_seq_cst);
+		while (!hasSpace())
+			tclRingBufferA_cpuWaitCond.wait_for(_l, std::chrono::milliseconds(1));
+		tclRingBufferA_cpuSleeping.store(false, std::memory_order_relaxed);
 	}
 
 	// this function assumes that TCLWaitForRBSpace was called and that there is enough space
 	void TCLWriteCmd(uint32be* cmd, uint32 cmdLen)
 	{
-		while (cmdLen > 0)
+		if (LatteCapture_IsEnabled())
+			LatteCapture_RecordRingWords(cmd, cmdLen);
+		uint32 writeIndex = tclRingBufferA_writeIndex.load(std::memory_order_relaxed);
+		uint32 firstSpan = std::min(cmdLen, TCL_RING_BUFFER_SIZE - writeIndex);
+		memcpy(tclRingBufferA + writeIndex, cmd, firstSpan * sizeof(uint32be));
+		if (firstSpan < cmdLen)
+			memcpy(tclRingBufferA, cmd + firstSpan, (cmdLen - firstSpan) * sizeof(uint32be));
+		tclRingBufferA_writeIndex.store((writeIndex + cmdLen) & (TCL_RING_BUFFER_SIZE - 1), std::memory_order_seq_cst);
+		// wake up the GPU thread if it went to sleep
+		if (tclRingBufferA_gpuSleeping.load(std::memory_order_seq_cst))
 		{
-			tclRingBufferA[tclRingBufferA_writeIndex] = *cmd;
-			tclRingBufferA_writeIndex++;
-			tclRingBufferA_writeIndex &= (TCL_RING_BUFFER_SIZE - 1);
-			cmd++;
-			cmdLen--;
+			std::unique_lock _l(tclRingBufferA_waitMutex);
+			tclRingBufferA_gpuWaitCond.notify_one();
 		}
 	}
 
@@ -132,6 +206,9 @@ namespace TCL
 
 		TCLWaitForRBSpace(totalCommandLength);
 
+		if (LatteCapture_IsEnabled())
+			LatteCapture_BeginSubmission(cmd, cmdLen);
+
 		// submit command buffer
 		TCLWriteCmd(cmd, cmdLen);
 
@@ -148,6 +225,40 @@ namespace TCL
 		return 0;
 	}
 
+	void TCLWaitForGPUIdle()
+	{
+		while (true)
+		{
+			stdx::atomic_ref<uint64be> retireTimestamp(s_tclStatePPC->gpuRetireMarker);
+			if (retireTimestamp.load() >= s_currentRetireMarker)
+				break;
+			std::this_thread::yield();
+		}
+	}
+
+	void TCLWaitForGPUDrained()
+	{
+		while (_TCLGetNumAvailableWords() != 0)
+			std::this_thread::yield();
+		// the GPU only reads the next word once it is done with the previous command
+		// the first failed read may have been issued before the last words were written, the second one is guaranteed to come after
+		uint32 emptyReadCount = tclRingBufferA_emptyReadCount.load(std::memory_order_acquire);
+		while ((tclRingBufferA_emptyReadCount.load(std::memory_order_acquire) - emptyReadCount) < 2)
+			std::this_thread::yield();
+	}
+
+	void TCLReplaySubmit(uint32be* cmd, uint32 cmdLen)
+	{
+		while (cmdLen > 0)
+		{
+			uint32 chunkLen = std::min<uint32>(cmdLen, TCL_RING_BUFFER_SIZE / 2);
+			TCLWaitForRBSpace(chunkLen);
+			TCLWriteCmd(cmd, chunkLen);
+			cmd += chunkLen;
+			cmdLen -= chunkLen;
+		}
+	}
+
 	void Initialize()
 	{
 		cafeExportRegister("TCL", TCLSubmitToRing, LogType::Placeholder);
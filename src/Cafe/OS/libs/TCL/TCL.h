@@ -17,9 +17,15 @@ namespace TCL
 	int TCLSubmitToRing(uint32be* cmd, uint32 cmdLen, betype<TCLSubmissionFlag>* controlFlags, uint64be* timestampValueOut);
 
 	// called from Latte code
-	bool TCLGPUReadRBWord(uint32& cmdWord);
+	uint32 TCLGPUReadRBWords(uint32be* cmdWords, uint32 maxWords);
+	void TCLGPUWaitForRBData(uint32 timeoutUs);
 	void TCLGPUNotifyNewRetirementTimestamp();
 
+	// used by GPU command stream capture and replay
+	void TCLWaitForGPUIdle(); // wait until all submitted commands are retired
+	void TCLWaitForGPUDrained(); // wait until the GPU consumed all ring buffer words and finished processing them
+	void TCLReplaySubmit(uint32be* cmd, uint32 cmdLen);
+
 	void Initialize();
 }
 ENABLE_BITMASK_OPERATORS(TCL::TCLSubmissionFlag);
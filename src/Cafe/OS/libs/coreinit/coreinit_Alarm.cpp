@@ -52,6 +52,7 @@ namespace coreinit
 		static void updateEarliestAlarmAtomic()
 		{
 			cemu_assert_debug(__OSHasSchedulerLock());
+			uint64 prevSoonestAlarm = g_soonestAlarm;
 			if (!g_activeAlarmList.empty())
 			{
 				auto firstAlarm = g_activeAlarmList.begin();
@@ -61,6 +62,9 @@ namespace coreinit
 			{
 				g_soonestAlarm = std::numeric_limits<uint64>::max();
 			}
+			// the idle main core may be sleeping until the previous deadline
+			if (g_soonestAlarm < prevSoonestAlarm)
+				__OSWakeIdleCores();
 		}
 
 		static void updateAlarms(uint64 currentTick)
@@ -117,6 +121,11 @@ namespace coreinit
 			return currentTick >= g_soonestAlarm;
 		}
 
+		static uint64 getSoonestFireTick()
+		{
+			return g_soonestAlarm;
+		}
+
         static void Reset()
         {
             g_activeAlarmList.clear();
@@ -163,6 +172,11 @@ namespace coreinit
 		delete hostAlarm;
 	}
 
+	uint64 OSHostAlarmGetSoonestFireTime()
+	{
+		return OSHostAlarm::getSoonestFireTick();
+	}
+
 	void alarm_update()
 	{	
 		cemu_assert_debug(!__OSHasSchedulerLock());
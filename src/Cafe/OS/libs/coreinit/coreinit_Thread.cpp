@@ -52,11 +52,7 @@ void nnNfp_update();
 
 namespace coreinit
 {
-#ifdef __arm64__
-	void __OSFiberThreadEntry(uint32, uint32);
-#else
 	void __OSFiberThreadEntry(void* thread);
-#endif
 	void __OSAddReadyThreadToRunQueue(OSThread_t* thread);
 	void __OSRemoveThreadFromRunQueues(OSThread_t* thread);
 };
@@ -73,6 +69,12 @@ namespace coreinit
 	SysAllocator<OSThreadQueue, 3> g_coreRunQueue;
 	CounterSemaphore g_coreRunQueueThreadCount[3];
 
+	// lets the idle main core sleep until the next system event is due
+	std::mutex s_idleWaitMutex;
+	std::condition_variable s_idleWaitCondition;
+	std::atomic_bool s_idleWaitActive{false};
+	bool s_idleWaitSignaled{false};
+
 	bool g_isMulticoreMode;
 
 	thread_local uint32 t_assignedCoreIndex;
@@ -80,7 +82,7 @@ namespace coreinit
 
 	struct OSHostThread
 	{
-		OSHostThread(OSThread_t* thread) : m_thread(thread), m_fiber((void(*)(void*))__OSFiberThreadEntry, this, this)
+		OSHostThread(OSThread_t* thread) : m_thread(thread), m_fiber(__OSFiberThreadEntry, this, this)
 		{
 		}
 
@@ -765,6 +767,7 @@ namespace coreinit
 			return;
 		if (thread->suspendCounter != 0)
 			return;
+		bool wasQueued = false;
 		for (sint32 i = 0; i < PPC_CORE_COUNT; i++)
 		{
 			if (thread->currentRunQueue[i] != nullptr)
@@ -775,7 +778,22 @@ namespace coreinit
 			g_coreRunQueue.GetPtr()[i].addThread(thread, thread->linkRun + i);
 			thread->currentRunQueue[i] = (g_coreRunQueue.GetPtr() + i);
 			g_coreRunQueueThreadCount[i].increment();
+			wasQueued = true;
 		}
+		if (wasQueued)
+			__OSWakeIdleCores();
+	}
+
+	// interrupts __OSMainCoreIdleWait()
+	void __OSWakeIdleCores()
+	{
+		// pairs with the fence in __OSMainCoreIdleWait(). Either we observe the waiter or it observes our queue/alarm update
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (!s_idleWaitActive.load(std::memory_order_relaxed))
+			return;
+		std::unique_lock _l(s_idleWaitMutex);
+		s_idleWaitSignaled = true;
+		s_idleWaitCondition.notify_one();
 	}
 
 	void __OSRemoveThreadFromRunQueues(OSThread_t* thread)
@@ -1244,6 +1262,44 @@ namespace coreinit
 		nnNfp_update();
 	}
 
+	bool __OSMainCoreHasRunnableThreads()
+	{
+		if (g_isMulticoreMode)
+			return !g_coreRunQueueThreadCount[1].isZero();
+		return !g_coreRunQueueThreadCount[0].isZero() || !g_coreRunQueueThreadCount[1].isZero() || !g_coreRunQueueThreadCount[2].isZero();
+	}
+
+	// blocks the main core until the next alarm or AX frame is due, or until a thread becomes runnable
+	void __OSMainCoreIdleWait()
+	{
+		// other system events (e.g. NFP) are polled, so never sleep longer than this
+		constexpr auto kMaxIdleWait = std::chrono::milliseconds(10);
+		// sleeping has a coarse granularity on some host OSes. For short waits we keep polling to not delay alarms
+		constexpr auto kMinIdleWait = std::chrono::milliseconds(1);
+		constexpr auto kWakeupMargin = std::chrono::microseconds(500);
+
+		const auto now = std::chrono::high_resolution_clock::now();
+		auto deadline = now + kMaxIdleWait;
+		uint64 alarmTick = OSHostAlarmGetSoonestFireTime();
+		uint64 currentTick = coreinit::OSGetTime();
+		if (alarmTick <= currentTick)
+			return;
+		uint64 alarmDelayTicks = alarmTick - currentTick;
+		if (alarmDelayTicks < ESPRESSO_TIMER_CLOCK / 100) // only convert if within kMaxIdleWait to avoid overflow
+			deadline = std::min(deadline, now + std::chrono::nanoseconds(alarmDelayTicks * 1000000000ull / ESPRESSO_TIMER_CLOCK));
+		deadline = std::min(deadline, snd_core::AXOut_getNextUpdateTime());
+		if (deadline - now < kMinIdleWait)
+			return;
+
+		s_idleWaitActive.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::unique_lock _l(s_idleWaitMutex);
+		if (!s_idleWaitSignaled && !__OSMainCoreHasRunnableThreads() && sSchedulerActive.load(std::memory_order::relaxed))
+			s_idleWaitCondition.wait_until(_l, deadline - kWakeupMargin, [] { return s_idleWaitSignaled; });
+		s_idleWaitSignaled = false;
+		s_idleWaitActive.store(false, std::memory_order_relaxed);
+	}
+
 	Fiber* g_idleLoopFiber[3]{};
 
 	// idle fiber per core if no thread is runnable
@@ -1271,6 +1327,9 @@ namespace coreinit
 				__OSCheckSystemEvents();
 				if(g_isMulticoreMode == false)
 					coreIndex = (coreIndex + 1) % 3;
+				// instead of spinning, sleep until the next system event is due
+				if (!__OSMainCoreHasRunnableThreads())
+					__OSMainCoreIdleWait();
 			}
 			else
 			{
@@ -1338,14 +1397,8 @@ namespace coreinit
 		__OSThreadStartTimeslice(hostThread->m_thread, &hostThread->ppcInstance);
 	}
 
-#ifdef __arm64__
-	void __OSFiberThreadEntry(uint32 _high, uint32 _low)
-	{
-		uint64 _thread = (uint64) _high << 32 | _low;
-#else
 	void __OSFiberThreadEntry(void* _thread)
 	{
-#endif
 		OSHostThread* hostThread = (OSHostThread*)_thread;
 
 		enableFlushDenormalsToZero();
@@ -1361,8 +1414,7 @@ namespace coreinit
 				// try to enter recompiler immediately
 				PPCRecompiler_attemptEnterWithoutRecompile(hCPU, hCPU->instructionPointer);
 				// keep executing as long as there are cycles left
-				while ((--hCPU->remainingCycles) >= 0)
-					PPCInterpreterSlim_executeInstruction(hCPU);
+				PPCInterpreterSlim_executeInstructions(hCPU);
 			}
 
 			// reset reservation
@@ -1458,6 +1510,7 @@ namespace coreinit
 		sSchedulerActive.store(false);
 		for (size_t i = 0; i < Espresso::CORE_COUNT; i++)
 			g_coreRunQueueThreadCount[i].increment(); // make sure to wake up cores if they are paused and waiting for runnable threads
+		__OSWakeIdleCores();
 		// wait for threads to stop execution
 		for (auto& threadItr : sSchedulerThreads)
 			threadItr.join();
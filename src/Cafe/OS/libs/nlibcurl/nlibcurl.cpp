@@ -12,13 +12,15 @@
 #include "curl/curl.h"
 #include <unordered_map>
 #include <atomic>
+#include <deque>
+#include <functional>
 
 #include "Cafe/IOSU/legacy/iosu_crypto.h"
 #include "Cafe/OS/libs/nsysnet/nsysnet.h"
 #include "Cafe/OS/libs/coreinit/coreinit_MEM.h"
 
-#include "util/helpers/ConcurrentQueue.h"
 #include "Cafe/OS/common/PPCConcurrentQueue.h"
+#include "util/helpers/helpers.h"
 #include "Common/FileStream.h"
 #include "config/ActiveSettings.h"
 
@@ -31,68 +33,6 @@ namespace nlibcurl
 #define NSSL_VERIFY_HOSTNAME	(1<<1)
 #define NSSL_VERIFY_DATE		(1<<2)
 
-	enum QueueOrder
-	{
-		QueueOrder_None,
-
-		QueueOrder_Result,
-		QueueOrder_CBDone,
-
-		QueueOrder_HeaderCB,
-		QueueOrder_ReadCB,
-		QueueOrder_WriteCB,
-		QueueOrder_ProgressCB,
-
-		QueueOrder_Perform,
-		QueueOrder_Pause,
-	};
-
-	struct QueueMsg_t
-	{
-		QueueOrder order;
-		union
-		{
-			uint32 result;
-
-			struct
-			{
-				char* buffer;
-				uint32 size;
-				uint32 nitems;
-			} header_cb;
-
-			struct
-			{
-				char* buffer;
-				uint32 size;
-				uint32 nitems;
-			} read_cb;
-
-			struct
-			{
-				char* buffer;
-				uint32 size;
-				uint32 nmemb;
-			} write_cb;
-
-			struct
-			{
-				uint32 clientp;
-				double dltotal;
-				double dlnow;
-				double ultotal;
-				double ulnow;
-			} progress_cb;
-
-			struct
-			{
-				sint32 bitmask;
-			} pause;
-
-		};
-
-	};
-
 struct MEMPTRHash_t
 {
 	size_t operator()(const MEMPTR<void>& p) const
@@ -289,102 +229,489 @@ static_assert(sizeof(CURLMsg_t) <= 0xC, "sizeof(CURLMsg_t)");
 
 size_t header_callback(char* buffer, size_t size, size_t nitems, void* userdata);
 
-thread_local PPCConcurrentQueue<QueueMsg_t>* g_callerQueue;
-thread_local ConcurrentQueue<QueueMsg_t>* g_threadQueue;
-void CurlWorkerThread(CURL_t* curl, PPCConcurrentQueue<QueueMsg_t>* callerQueue, ConcurrentQueue<QueueMsg_t>* threadQueue)
+// callback invocation recorded on the transfer loop thread, delivered to the guest thread in batches
+struct CurlPendingCallback
 {
-	g_callerQueue = callerQueue;
-	g_threadQueue = threadQueue;
+	enum class Type : uint8
+	{
+		Header,
+		Write,
+		Read,
+		Progress,
+	};
 
-	const QueueMsg_t msg = threadQueue->pop();
+	Type type;
+	uint32 size;
+	uint32 count;
+	std::vector<uint8> data; // header and write payload
+	double progress[4]; // dltotal, dlnow, ultotal, ulnow
+};
 
-	QueueMsg_t resultMsg = {};
-	resultMsg.order = QueueOrder_Result;
+// state of a curl_easy_perform() call. Lives on the stack of the performing guest thread
+// fields below the queue are protected by the transfer loop mutex
+struct CurlTransfer
+{
+	CURL_t* curl;
+	OSThread_t* guestThread;
+	PPCConcurrentQueue<uint8> wakeQueue; // one entry per wakeup of the guest thread
+
+	std::deque<CurlPendingCallback> pendingCallbacks;
+	size_t pendingBytes{};
+	bool guestNotified{}; // wakeup pushed but not yet consumed by the guest thread
+	bool guestPaused{}; // paused by the guest via CURL_WRITEFUNC_PAUSE or curl_easy_pause
+	bool hostPaused{}; // host transfer paused until the guest catches up
+	bool readRequested{};
+	bool readEOF{};
+	std::vector<uint8> readBuffer;
+	CURLcode abortResult{CURLE_OK}; // set if a guest callback requested to abort the transfer
+	bool isDone{};
+	CURLcode result{CURLE_OK};
+};
 
-	if (msg.order == QueueOrder_Perform)
-		resultMsg.result = ::curl_easy_perform(curl->curl);
-	else if(msg.order == QueueOrder_Pause)
-		resultMsg.result = ::curl_easy_pause(curl->curl, msg.pause.bitmask);
-	else
-		assert_dbg();
+// all transfers started with curl_easy_perform() are driven by a single host thread using a curl multi handle
+// unlike a thread per transfer this lets connections and TLS sessions be reused across guest handles
+// callbacks are recorded on the loop thread and handed to the guest thread in batches instead of one round-trip per invocation
+class CurlTransferLoop
+{
+	// maximum amount of unconsumed header and body data per transfer before the host side is paused
+	static constexpr size_t MAX_PENDING_BYTES = 1024 * 1024;
 
-	callerQueue->push(resultMsg, curl->curlThread);
-}
+	enum class CommandType
+	{
+		Add,
+		Resume,
+		AccessHandle,
+	};
 
-uint32 SendOrderToWorker(CURL_t* curl, QueueOrder order, uint32 arg1 = 0)
-{
-	OSThread_t* currentThread = coreinit::OSGetCurrentThread();
-	curl->curlThread = currentThread;
+	struct Command
+	{
+		CommandType type;
+		CurlTransfer* transfer;
+		const std::function<void()>* accessFunc{}; // for AccessHandle
+		bool* accessDone{};
+	};
 
-	// cemuLog_logDebug(LogType::Force, "CURRENTTHREAD: 0x{} -> {}",currentThread, order)
+public:
+	~CurlTransferLoop()
+	{
+		if (!m_thread.joinable())
+			return;
+		m_threadShouldExit = true;
+		curl_multi_wakeup(m_multi);
+		m_thread.join();
+		curl_multi_cleanup(m_multi);
+	}
 
-	PPCConcurrentQueue<QueueMsg_t> callerQueue;
-	ConcurrentQueue<QueueMsg_t> threadQueue;
-	std::thread worker(CurlWorkerThread, curl, &callerQueue, &threadQueue);
-	worker.detach();
+	static CurlTransferLoop& GetInstance()
+	{
+		static CurlTransferLoop s_instance;
+		return s_instance;
+	}
 
-	QueueMsg_t orderMsg = {};
-	orderMsg.order = order;
+	// returns the transfer if the callback is invoked on the loop thread
+	static CurlTransfer* GetActiveTransfer(CURL_t* curl)
+	{
+		if (!s_isLoopThread)
+			return nullptr;
+		char* privateData = nullptr;
+		::curl_easy_getinfo(curl->curl, CURLINFO_PRIVATE, &privateData);
+		return (CurlTransfer*)privateData;
+	}
 
-	if (order == QueueOrder_Pause)
-		orderMsg.pause.bitmask = arg1;
+	// blocks the current guest thread until the transfer has finished and all callbacks have been delivered
+	CURLcode Perform(CURL_t* curl)
+	{
+		if (!EnsureRunning())
+			return CURLE_FAILED_INIT;
+		CurlTransfer transfer{};
+		transfer.curl = curl;
+		transfer.guestThread = coreinit::OSGetCurrentThread();
+		m_mutex.lock();
+		m_transfersByHandle[curl] = &transfer;
+		m_commands.push_back({ CommandType::Add, &transfer });
+		m_mutex.unlock();
+		curl_multi_wakeup(m_multi);
+		while (true)
+		{
+			transfer.wakeQueue.pop(transfer.guestThread);
+			std::deque<CurlPendingCallback> batch;
+			m_mutex.lock();
+			transfer.guestNotified = false;
+			const bool isDone = transfer.isDone;
+			// once the transfer has finished there is nothing left to resume it, so a guest pause no longer holds back delivery
+			if (isDone || !transfer.guestPaused)
+			{
+				batch.swap(transfer.pendingCallbacks);
+				transfer.pendingBytes = 0;
+			}
+			m_mutex.unlock();
+			DeliverCallbacks(transfer, batch, isDone);
+			if (isDone)
+				break;
+		}
+		m_mutex.lock();
+		m_transfersByHandle.erase(curl);
+		m_mutex.unlock();
+		return transfer.abortResult != CURLE_OK ? transfer.abortResult : transfer.result;
+	}
 
-	threadQueue.push(orderMsg);
+	// a curl handle must not be used by two threads at once. Guest callbacks run while the loop thread is still driving the transfer
+	// so host handle accesses from the guest (setopt, getinfo) are executed on the loop thread while the handle belongs to the loop
+	void AccessHandle(CURL_t* curl, const std::function<void()>& func)
+	{
+		std::unique_lock _l(m_mutex);
+		if (s_isLoopThread || !m_transfersByHandle.contains(curl))
+		{
+			_l.unlock();
+			func();
+			return;
+		}
+		bool accessDone = false;
+		m_commands.push_back({ CommandType::AccessHandle, nullptr, &func, &accessDone });
+		_l.unlock();
+		curl_multi_wakeup(m_multi);
+		_l.lock();
+		m_accessDoneCondVar.wait(_l, [&]() { return accessDone; });
+	}
 
-	uint32 result;
-	while (true)
+	CURLcode Pause(CURL_t* curl, sint32 bitmask)
 	{
-		const QueueMsg_t msg = callerQueue.pop(currentThread);
-		if (msg.order == QueueOrder_ProgressCB)
+		m_mutex.lock();
+		auto it = m_transfersByHandle.find(curl);
+		if (it == m_transfersByHandle.end())
 		{
-			QueueMsg_t sendMsg = {};
-			sendMsg.order = QueueOrder_CBDone;
-			sendMsg.result = PPCCoreCallback(curl->fprogress.GetMPTR(), curl->progress_client.GetMPTR(), msg.progress_cb.dltotal, msg.progress_cb.dlnow, msg.progress_cb.ultotal, msg.progress_cb.ulnow);
-			threadQueue.push(sendMsg);
+			// not driven by the loop (idle or part of a guest multi handle), safe to access directly
+			m_mutex.unlock();
+			return ::curl_easy_pause(curl->curl, bitmask);
 		}
-		else if (msg.order == QueueOrder_HeaderCB)
+		CurlTransfer* transfer = it->second;
+		transfer->guestPaused = bitmask != CURLPAUSE_CONT;
+		const bool needsWake = UpdateGuestNotified(*transfer);
+		const bool needsResume = !transfer->guestPaused && transfer->hostPaused;
+		if (needsResume)
+		{
+			transfer->hostPaused = false;
+			m_commands.push_back({ CommandType::Resume, transfer });
+		}
+		m_mutex.unlock();
+		if (needsWake)
+			transfer->wakeQueue.push(0, transfer->guestThread);
+		if (needsResume)
+			curl_multi_wakeup(m_multi);
+		return CURLE_OK;
+	}
+
+	// callbacks invoked on the loop thread
+	static size_t OnHeader(CurlTransfer* transfer, const char* buffer, size_t size, size_t nitems)
+	{
+		std::unique_lock _l(GetInstance().m_mutex);
+		if (transfer->abortResult != CURLE_OK)
+			return 0;
+		QueueData(*transfer, CurlPendingCallback::Type::Header, buffer, size, nitems);
+		return size * nitems;
+	}
+
+	static size_t OnWrite(CurlTransfer* transfer, const char* buffer, size_t size, size_t nmemb)
+	{
+		std::unique_lock _l(GetInstance().m_mutex);
+		if (transfer->abortResult != CURLE_OK)
+			return 0;
+		if (transfer->guestPaused || transfer->pendingBytes >= MAX_PENDING_BYTES)
 		{
-			StackAllocator<char> tmp(msg.header_cb.size * msg.header_cb.nitems);
-			memcpy(tmp.GetPointer(), msg.header_cb.buffer, msg.header_cb.size * msg.header_cb.nitems);
+			// curl keeps the data and passes it to us again once the transfer is resumed
+			transfer->hostPaused = true;
+			return CURL_WRITEFUNC_PAUSE;
+		}
+		QueueData(*transfer, CurlPendingCallback::Type::Write, buffer, size, nmemb);
+		return size * nmemb;
+	}
 
-			QueueMsg_t sendMsg = {};
-			sendMsg.order = QueueOrder_CBDone;
-			sendMsg.result = PPCCoreCallback(curl->fwrite_header.GetMPTR(), tmp.GetMPTR(), msg.header_cb.size, msg.header_cb.nitems, curl->writeheader.GetMPTR());
-			threadQueue.push(sendMsg);
+	static size_t OnRead(CurlTransfer* transfer, char* buffer, size_t size, size_t nitems)
+	{
+		std::unique_lock _l(GetInstance().m_mutex);
+		if (transfer->abortResult != CURLE_OK)
+			return CURL_READFUNC_ABORT;
+		if (!transfer->readBuffer.empty())
+		{
+			size_t length = std::min(transfer->readBuffer.size(), size * nitems);
+			memcpy(buffer, transfer->readBuffer.data(), length);
+			transfer->readBuffer.erase(transfer->readBuffer.begin(), transfer->readBuffer.begin() + length);
+			return length;
 		}
-		else if (msg.order == QueueOrder_ReadCB)
+		if (transfer->readEOF)
+			return 0;
+		// the data has to come from the guest. Pause until the guest thread has run the read callback
+		if (!transfer->readRequested)
 		{
-			StackAllocator<char> tmp(msg.read_cb.size * msg.read_cb.nitems);
+			transfer->readRequested = true;
+			CurlPendingCallback& cb = transfer->pendingCallbacks.emplace_back();
+			cb.type = CurlPendingCallback::Type::Read;
+			cb.size = (uint32)size;
+			cb.count = (uint32)std::min<size_t>(nitems, 0x4000); // limit this to 16KB which is the limit in nlibcurl.rpl (Super Mario Maker crashes on level upload if the size is too big)
+		}
+		transfer->hostPaused = true;
+		return CURL_READFUNC_PAUSE;
+	}
 
-			QueueMsg_t sendMsg = {};
-			sendMsg.order = QueueOrder_CBDone;
-			cemuLog_logDebug(LogType::Force, "QueueOrder_ReadCB size: {} nitems: {}", msg.read_cb.size, msg.read_cb.nitems);
-			sendMsg.result = PPCCoreCallback(curl->fread_func_set.GetMPTR(), tmp.GetMPTR(), msg.read_cb.size, msg.read_cb.nitems, curl->in_set.GetMPTR());
-			cemuLog_logDebug(LogType::Force, "readcb size: {}", (sint32)sendMsg.result);
-			if (sendMsg.result > 0)
-				memcpy(msg.read_cb.buffer, tmp.GetPointer(), sendMsg.result);
+	static int OnProgress(CurlTransfer* transfer, double dltotal, double dlnow, double ultotal, double ulnow)
+	{
+		std::unique_lock _l(GetInstance().m_mutex);
+		if (transfer->abortResult != CURLE_OK)
+			return 1;
+		// only the most recent progress update is of interest
+		CurlPendingCallback* cb;
+		if (!transfer->pendingCallbacks.empty() && transfer->pendingCallbacks.back().type == CurlPendingCallback::Type::Progress)
+			cb = &transfer->pendingCallbacks.back();
+		else
+		{
+			cb = &transfer->pendingCallbacks.emplace_back();
+			cb->type = CurlPendingCallback::Type::Progress;
+		}
+		cb->progress[0] = dltotal;
+		cb->progress[1] = dlnow;
+		cb->progress[2] = ultotal;
+		cb->progress[3] = ulnow;
+		return 0;
+	}
 
-			threadQueue.push(sendMsg);
+private:
+	bool EnsureRunning()
+	{
+		std::unique_lock _l(m_mutex);
+		if (m_thread.joinable())
+			return true;
+		if (m_initFailed)
+			return false;
+		m_multi = curl_multi_init();
+		if (!m_multi)
+		{
+			cemuLog_log(LogType::Force, "nlibcurl: Failed to create transfer loop multi handle");
+			m_initFailed = true;
+			return false;
 		}
-		else if (msg.order == QueueOrder_WriteCB)
+		m_thread = std::thread(&CurlTransferLoop::ThreadFunc, this);
+		return true;
+	}
+
+	// assumes lock is held
+	static void QueueData(CurlTransfer& transfer, CurlPendingCallback::Type type, const char* buffer, size_t size, size_t count)
+	{
+		CurlPendingCallback& cb = transfer.pendingCallbacks.emplace_back();
+		cb.type = type;
+		cb.size = (uint32)size;
+		cb.count = (uint32)count;
+		cb.data.assign((const uint8*)buffer, (const uint8*)buffer + size * count);
+		transfer.pendingBytes += size * count;
+	}
+
+	// assumes lock is held. Returns true if the guest thread needs to be woken up
+	static bool UpdateGuestNotified(CurlTransfer& transfer)
+	{
+		if (transfer.guestNotified)
+			return false;
+		if (!transfer.isDone && (transfer.pendingCallbacks.empty() || transfer.guestPaused))
+			return false;
+		transfer.guestNotified = true;
+		return true;
+	}
+
+	void SetAbort(CurlTransfer& transfer, CURLcode result)
+	{
+		std::unique_lock _l(m_mutex);
+		transfer.abortResult = result;
+	}
+
+	// runs on the guest thread
+	void DeliverCallbacks(CurlTransfer& transfer, std::deque<CurlPendingCallback>& batch, bool isDone)
+	{
+		CURL_t* curl = transfer.curl;
+		bool needsResume = false;
+		while (!batch.empty() && transfer.abortResult == CURLE_OK)
+		{
+			CurlPendingCallback& cb = batch.front();
+			bool guestPaused = false;
+			if (cb.type == CurlPendingCallback::Type::Header || cb.type == CurlPendingCallback::Type::Write)
+			{
+				const uint32 length = cb.size * cb.count;
+				StackAllocator<char> tmp(length);
+				memcpy(tmp.GetPointer(), cb.data.data(), length);
+				uint32 r;
+				if (cb.type == CurlPendingCallback::Type::Header)
+					r = PPCCoreCallback(curl->fwrite_header.GetMPTR(), tmp.GetMPTR(), cb.size, cb.count, curl->writeheader.GetMPTR());
+				else
+					r = PPCCoreCallback(curl->fwrite_func.GetMPTR(), tmp.GetMPTR(), cb.size, cb.count, curl->out.GetMPTR());
+				if (r == CURL_WRITEFUNC_PAUSE)
+					guestPaused = true;
+				else if (r != length)
+					SetAbort(transfer, CURLE_WRITE_ERROR);
+			}
+			else if (cb.type == CurlPendingCallback::Type::Read)
+			{
+				StackAllocator<char> tmp(cb.size * cb.count);
+				const uint32 r = PPCCoreCallback(curl->fread_func_set.GetMPTR(), tmp.GetMPTR(), cb.size, cb.count, curl->in_set.GetMPTR());
+				cemuLog_logDebug(LogType::Force, "read_callback size: {} nitems: {} -> {}", cb.size, cb.count, (sint32)r);
+				if (r == CURL_READFUNC_PAUSE)
+					guestPaused = true;
+				else
+				{
+					std::unique_lock _l(m_mutex);
+					transfer.readRequested = false;
+					if (r == CURL_READFUNC_ABORT)
+						transfer.abortResult = CURLE_ABORTED_BY_CALLBACK;
+					else if (r == 0)
+						transfer.readEOF = true;
+					else
+						transfer.readBuffer.insert(transfer.readBuffer.end(), (uint8*)tmp.GetPointer(), (uint8*)tmp.GetPointer() + std::min<uint32>(r, cb.size * cb.count));
+					needsResume = true;
+				}
+			}
+			else if (cb.type == CurlPendingCallback::Type::Progress)
+			{
+				const sint32 r = PPCCoreCallback(curl->fprogress.GetMPTR(), curl->progress_client.GetMPTR(), cb.progress[0], cb.progress[1], cb.progress[2], cb.progress[3]);
+				cemuLog_logDebug(LogType::Force, "progress_callback({:.02}, {:.02}, {:.02}, {:.02}) -> {}", cb.progress[0], cb.progress[1], cb.progress[2], cb.progress[3], r);
+				if (r != 0)
+					SetAbort(transfer, CURLE_ABORTED_BY_CALLBACK);
+			}
+			if (guestPaused)
+			{
+				// the callback did not consume the data, it is passed again once the guest resumes the transfer
+				std::unique_lock _l(m_mutex);
+				transfer.guestPaused = true;
+				break;
+			}
+			batch.pop_front();
+			// the callback may also have paused the transfer via curl_easy_pause()
+			std::unique_lock _l(m_mutex);
+			if (transfer.guestPaused && !isDone)
+				break;
+		}
+		if (isDone)
+			return;
+		m_mutex.lock();
+		if (transfer.abortResult != CURLE_OK)
+			batch.clear();
+		for (auto it = batch.rbegin(); it != batch.rend(); ++it)
 		{
-			StackAllocator<char> tmp(msg.write_cb.size * msg.write_cb.nmemb);
-			memcpy(tmp.GetPointer(), msg.write_cb.buffer, msg.write_cb.size * msg.write_cb.nmemb);
+			transfer.pendingBytes += it->data.size();
+			transfer.pendingCallbacks.emplace_front(std::move(*it));
+		}
+		if (transfer.abortResult != CURLE_OK || (transfer.hostPaused && !transfer.guestPaused))
+			needsResume = true;
+		if (needsResume)
+		{
+			transfer.hostPaused = false;
+			m_commands.push_back({ CommandType::Resume, &transfer });
+		}
+		m_mutex.unlock();
+		if (needsResume)
+			curl_multi_wakeup(m_multi);
+	}
 
-			QueueMsg_t sendMsg = {};
-			sendMsg.order = QueueOrder_CBDone;
-			sendMsg.result = PPCCoreCallback(curl->fwrite_func.GetMPTR(), tmp.GetMPTR(), msg.write_cb.size, msg.write_cb.nmemb, curl->out.GetMPTR());
-			threadQueue.push(sendMsg);
+	// runs on the loop thread
+	void FinishTransfer(CurlTransfer* transfer, CURLcode result)
+	{
+		curl_multi_remove_handle(m_multi, transfer->curl->curl);
+		::curl_easy_setopt(transfer->curl->curl, CURLOPT_PRIVATE, nullptr);
+		m_activeTransfers.erase(std::find(m_activeTransfers.begin(), m_activeTransfers.end(), transfer));
+		m_mutex.lock();
+		transfer->isDone = true;
+		transfer->result = result;
+		const bool needsWake = UpdateGuestNotified(*transfer);
+		m_mutex.unlock();
+		// after this the guest thread may return and the transfer object is gone
+		if (needsWake)
+			transfer->wakeQueue.push(0, transfer->guestThread);
+	}
+
+	void ProcessCommands()
+	{
+		std::vector<Command> commands;
+		m_mutex.lock();
+		commands.swap(m_commands);
+		m_mutex.unlock();
+		for (auto& cmd : commands)
+		{
+			CurlTransfer* transfer = cmd.transfer;
+			if (cmd.type == CommandType::AccessHandle)
+			{
+				(*cmd.accessFunc)();
+				m_mutex.lock();
+				*cmd.accessDone = true;
+				m_mutex.unlock();
+				m_accessDoneCondVar.notify_all();
+			}
+			else if (cmd.type == CommandType::Add)
+			{
+				m_activeTransfers.emplace_back(transfer);
+				::curl_easy_setopt(transfer->curl->curl, CURLOPT_PRIVATE, transfer);
+				CURLMcode r = curl_multi_add_handle(m_multi, transfer->curl->curl);
+				if (r != CURLM_OK)
+				{
+					cemuLog_log(LogType::Force, "nlibcurl: Failed to add transfer to multi handle (error {})", (sint32)r);
+					FinishTransfer(transfer, CURLE_FAILED_INIT);
+				}
+			}
+			else if (cmd.type == CommandType::Resume)
+			{
+				// a transfer which already finished may have been resumed by the guest in the meantime
+				if (std::find(m_activeTransfers.begin(), m_activeTransfers.end(), transfer) == m_activeTransfers.end())
+					continue;
+				m_mutex.lock();
+				const CURLcode abortResult = transfer->abortResult;
+				m_mutex.unlock();
+				if (abortResult != CURLE_OK)
+					FinishTransfer(transfer, abortResult);
+				else
+					::curl_easy_pause(transfer->curl->curl, CURLPAUSE_CONT);
+			}
 		}
-		else if (msg.order == QueueOrder_Result)
+	}
+
+	void ThreadFunc()
+	{
+		SetThreadName("nlibcurl loop");
+		s_isLoopThread = true;
+		while (!m_threadShouldExit)
 		{
-			result = msg.result;
-			break;
+			ProcessCommands();
+			int runningHandles = 0;
+			curl_multi_perform(m_multi, &runningHandles);
+			int msgsInQueue;
+			while (CURLMsg* msg = curl_multi_info_read(m_multi, &msgsInQueue))
+			{
+				if (msg->msg != CURLMSG_DONE)
+					continue;
+				char* privateData = nullptr;
+				::curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &privateData);
+				if (privateData)
+					FinishTransfer((CurlTransfer*)privateData, msg->data.result);
+			}
+			// hand everything recorded during this iteration to the guest threads
+			std::vector<CurlTransfer*> wakeList;
+			m_mutex.lock();
+			for (CurlTransfer* transfer : m_activeTransfers)
+			{
+				if (UpdateGuestNotified(*transfer))
+					wakeList.emplace_back(transfer);
+			}
+			m_mutex.unlock();
+			for (CurlTransfer* transfer : wakeList)
+				transfer->wakeQueue.push(0, transfer->guestThread);
+			curl_multi_poll(m_multi, nullptr, 0, 1000, nullptr);
 		}
 	}
 
-	return result;
-}
+	std::mutex m_mutex;
+	std::condition_variable m_accessDoneCondVar;
+	std::vector<Command> m_commands;
+	std::unordered_map<CURL_t*, CurlTransfer*> m_transfersByHandle;
+	std::vector<CurlTransfer*> m_activeTransfers; // only accessed by the loop thread
+	CURLM* m_multi{};
+	std::thread m_thread;
+	std::atomic_bool m_threadShouldExit{false};
+	bool m_initFailed{false};
+	static inline thread_local bool s_isLoopThread{false};
+};
 
 static int curl_closesocket(void *clientp, curl_socket_t item)
 {
@@ -893,8 +1220,7 @@ void export_curl_easy_pause(PPCInterpreter_t* hCPU)
 	ppcDefineParamS32(bitmask, 1);
 	cemuLog_logDebug(LogType::Force, "curl_easy_pause(0x{:08x}, 0x{:x})", curl.GetMPTR(), bitmask);
 
-	//const CURLcode result = ::curl_easy_pause(curl->curl, bitmask);
-	const uint32 result = SendOrderToWorker(curl.GetPtr(), QueueOrder_Pause, bitmask);
+	const uint32 result = CurlTransferLoop::GetInstance().Pause(curl.GetPtr(), bitmask);
 	cemuLog_logDebug(LogType::Force, "curl_easy_pause(0x{:08x}, 0x{:x}) DONE", curl.GetMPTR(), bitmask);
 	osLib_returnFromFunction(hCPU, result);
 }
@@ -993,24 +1319,6 @@ size_t header_callback(char* buffer, size_t size, size_t nitems, void* userdata)
 		return size * nitems;
 	}
 
-	if (g_callerQueue == nullptr || g_threadQueue == nullptr)
-	{
-		StackAllocator<char> tmp((uint32)(size * nitems));
-		memcpy(tmp.GetPointer(), buffer, size * nitems);
-		return PPCCoreCallback(curl->fwrite_header.GetMPTR(), tmp.GetMPTR(), (uint32)size, (uint32)nitems, curl->writeheader.GetMPTR());
-	}
-
-	QueueMsg_t msg = {};
-	msg.order = QueueOrder_HeaderCB;
-	msg.header_cb.buffer = buffer;
-	msg.header_cb.size = (uint32)size;
-	msg.header_cb.nitems = (uint32)nitems;
-	g_callerQueue->push(msg, curl->curlThread);
-
-	msg = g_threadQueue->pop();
-	if (msg.order != QueueOrder_CBDone)
-		cemu_assert_suspicious();
-
 #ifdef CEMU_DEBUG_ASSERT
 	char debug[500];
 	cemu_assert_debug((size*nitems) < 500);
@@ -1018,7 +1326,14 @@ size_t header_callback(char* buffer, size_t size, size_t nitems, void* userdata)
 	debug[size*nitems] = 0;
 	cemuLog_logDebug(LogType::Force, "header_callback(0x{}, 0x{:x}, 0x{:x}, 0x{:08x}) [{}]", (void*)buffer, size, nitems, curl->writeheader.GetMPTR(), debug);
 #endif
-	return msg.result;
+
+	if (CurlTransfer* transfer = CurlTransferLoop::GetActiveTransfer(curl))
+		return CurlTransferLoop::OnHeader(transfer, buffer, size, nitems);
+
+	// invoked on the guest thread (guest curl_multi handle)
+	StackAllocator<char> tmp((uint32)(size * nitems));
+	memcpy(tmp.GetPointer(), buffer, size * nitems);
+	return PPCCoreCallback(curl->fwrite_header.GetMPTR(), tmp.GetMPTR(), (uint32)size, (uint32)nitems, curl->writeheader.GetMPTR());
 }
 
 size_t write_callback(char* ptr, size_t size, size_t nmemb, void* userdata)
@@ -1026,31 +1341,16 @@ size_t write_callback(char* ptr, size_t size, size_t nmemb, void* userdata)
 	CURL_t* curl = (CURL_t*)userdata;
 
 	curlDebug_resultWrite(curl, ptr, size, nmemb);
-	//StackAllocator<char> tmp(size * nmemb);
-	//memcpy(tmp.GetPointer(), ptr, size * nmemb);
 
 	cemuLog_logDebug(LogType::Force, "write_callback(0x{} 0x{:x}, 0x{:x}, 0x{:08x})", (void*)ptr, size, nmemb, curl->out.GetMPTR());
 
-	if (g_callerQueue == nullptr || g_threadQueue == nullptr)
-	{
-		StackAllocator<char> tmp((uint32)(size * nmemb));
-		memcpy(tmp.GetPointer(), ptr, size * nmemb);
-		int r = PPCCoreCallback(curl->fwrite_func.GetMPTR(), tmp.GetMPTR(), (uint32)size, (uint32)nmemb, curl->out.GetMPTR());
-		return r;
-	}
-
-	QueueMsg_t msg = {};
-	msg.order = QueueOrder_WriteCB;
-	msg.write_cb.buffer = ptr;
-	msg.write_cb.size = (uint32)size;
-	msg.write_cb.nmemb = (uint32)nmemb;
-	g_callerQueue->push(msg, curl->curlThread);
-
-	msg = g_threadQueue->pop();
-	if (msg.order != QueueOrder_CBDone)
-		cemu_assert_suspicious();
+	if (CurlTransfer* transfer = CurlTransferLoop::GetActiveTransfer(curl))
+		return CurlTransferLoop::OnWrite(transfer, ptr, size, nmemb);
 
-	return msg.result;
+	StackAllocator<char> tmp((uint32)(size * nmemb));
+	memcpy(tmp.GetPointer(), ptr, size * nmemb);
+	int r = PPCCoreCallback(curl->fwrite_func.GetMPTR(), tmp.GetMPTR(), (uint32)size, (uint32)nmemb, curl->out.GetMPTR());
+	return r;
 }
 
 int sockopt_callback(void* clientp, curl_socket_t curlfd, curlsocktype purpose)
@@ -1066,35 +1366,18 @@ int sockopt_callback(void* clientp, curl_socket_t curlfd, curlsocktype purpose)
 
 size_t read_callback(char* buffer, size_t size, size_t nitems, void* instream)
 {	
-	nitems = std::min<uint32>(nitems, 0x4000);
 	CURL_t* curl = (CURL_t*)instream;
 
 	cemuLog_logDebug(LogType::Force, "read_callback(0x{}, 0x{:x}, 0x{:x}, 0x{:08x}) [func: 0x{:x}]", (void*)buffer, size, nitems, curl->in_set.GetMPTR(), curl->fread_func_set.GetMPTR());
 
-	if (g_callerQueue == nullptr || g_threadQueue == nullptr)
-	{
-		StackAllocator<char> tmp((uint32)(size * nitems));
-		const sint32 result = PPCCoreCallback(curl->fread_func_set.GetMPTR(), tmp.GetMPTR(), (uint32)size, (uint32)nitems, curl->in_set.GetMPTR());
-		memcpy(buffer, tmp.GetPointer(), result);
-		return result;
-	}
-
-	QueueMsg_t msg = {};
-	msg.order = QueueOrder_ReadCB;
-	msg.read_cb.buffer = buffer;
-	msg.read_cb.size = (uint32)size;
-	msg.read_cb.nitems = (uint32)std::min<uint32>(nitems, 0x4000); // limit this to 16KB which is the limit in nlibcurl.rpl (Super Mario Maker crashes on level upload if the size is too big)
+	if (CurlTransfer* transfer = CurlTransferLoop::GetActiveTransfer(curl))
+		return CurlTransferLoop::OnRead(transfer, buffer, size, nitems);
 
-	cemuLog_logDebug(LogType::Force, "read_callback(0x{}, 0x{:x}, 0x{:x}, 0x{:08x}) [func: 0x{:x}] PUSH", (void*)buffer, size, nitems, curl->in_set.GetMPTR(), curl->fread_func_set.GetMPTR());
-	g_callerQueue->push(msg, curl->curlThread);
-
-	msg = g_threadQueue->pop();
-	if (msg.order != QueueOrder_CBDone)
-		cemu_assert_suspicious();
-
-	cemuLog_logDebug(LogType::Force, "read_callback(0x{}, 0x{:x}, 0x{:x}, 0x{:08x}) DONE Result: {}", (void*)buffer, size, nitems, curl->in_set.GetMPTR(), msg.result);
-
-	return msg.result;
+	nitems = std::min<uint32>(nitems, 0x4000);
+	StackAllocator<char> tmp((uint32)(size * nitems));
+	const sint32 result = PPCCoreCallback(curl->fread_func_set.GetMPTR(), tmp.GetMPTR(), (uint32)size, (uint32)nitems, curl->in_set.GetMPTR());
+	memcpy(buffer, tmp.GetPointer(), result);
+	return result;
 }
 
 
@@ -1102,24 +1385,18 @@ int progress_callback(void* clientp, double dltotal, double dlnow, double ultota
 {
 	//peterBreak();
 	CURL_t* curl = (CURL_t*)clientp;
-	//int result = PPCCoreCallback(curl->fprogress.GetMPTR(), curl->progress_client.GetMPTR(), dltotal, dlnow, ultotal, ulnow);
-	if(g_callerQueue == nullptr || g_threadQueue == nullptr)
-		return PPCCoreCallback(curl->fprogress.GetMPTR(), curl->progress_client.GetMPTR(), dltotal, dlnow, ultotal, ulnow);
-
-	QueueMsg_t msg = {};
-	msg.order = QueueOrder_ProgressCB;
-	msg.progress_cb.dltotal = dltotal;
-	msg.progress_cb.dlnow = dlnow;
-	msg.progress_cb.ultotal = ultotal;
-	msg.progress_cb.ulnow = ulnow;
-	g_callerQueue->push(msg, curl->curlThread);
-
-	msg = g_threadQueue->pop();
-	if (msg.order != QueueOrder_CBDone)
-		cemu_assert_suspicious();
-	
-	cemuLog_logDebug(LogType::Force, "progress_callback({:.02}, {:.02}, {:.02}, {:.02}) -> {}", dltotal, dlnow, ultotal, ulnow, msg.result);
-	return msg.result;
+	if (CurlTransfer* transfer = CurlTransferLoop::GetActiveTransfer(curl))
+		return CurlTransferLoop::OnProgress(transfer, dltotal, dlnow, ultotal, ulnow);
+	return PPCCoreCallback(curl->fprogress.GetMPTR(), curl->progress_client.GetMPTR(), dltotal, dlnow, ultotal, ulnow);
+}
+
+// see CurlTransferLoop::AccessHandle
+template<typename T>
+static CURLcode _curl_easy_setopt_host(CURL_t* curl, CURLoption option, T parameter)
+{
+	CURLcode result;
+	CurlTransferLoop::GetInstance().AccessHandle(curl, [&]() { result = ::curl_easy_setopt(curl->curl, option, parameter); });
+	return result;
 }
 
 void export_curl_easy_setopt(PPCInterpreter_t* hCPU)
@@ -1129,7 +1406,6 @@ void export_curl_easy_setopt(PPCInterpreter_t* hCPU)
 	ppcDefineParamMEMPTR(parameter, void, 2);
 	ppcDefineParamU64(parameterU64, 2);
 
-	CURL* curlObj = curl->curl;
 	curl->isDirty = true;
 
 	CURLcode result = CURLE_OK;
@@ -1176,14 +1452,14 @@ void export_curl_easy_setopt(PPCInterpreter_t* hCPU)
 		case CURLOPT_LOW_SPEED_TIME:
 		case CURLOPT_CONNECTTIMEOUT:
 		{
-			result = ::curl_easy_setopt(curlObj, (CURLoption)option, parameter.GetMPTR());
+			result = _curl_easy_setopt_host(curl.GetPtr(), (CURLoption)option, parameter.GetMPTR());
 			break;
 		}
 		case CURLOPT_URL:
 		{
 			curlDebug_logEasySetOptStr(curl.GetPtr(), "CURLOPT_URL", (const char*)parameter.GetPtr());
 			cemuLog_logDebug(LogType::Force, "curl_easy_setopt({}) [{}]", option, parameter.GetPtr());
-			result = ::curl_easy_setopt(curlObj, (CURLoption)option, parameter.GetPtr());
+			result = _curl_easy_setopt_host(curl.GetPtr(), (CURLoption)option, parameter.GetPtr());
 			break;
 		}
 
@@ -1191,7 +1467,7 @@ void export_curl_easy_setopt(PPCInterpreter_t* hCPU)
 		case CURLOPT_USERAGENT:
 		{
 			cemuLog_logDebug(LogType::Force, "curl_easy_setopt({}) [{}]", option, parameter.GetPtr());
-			result = ::curl_easy_setopt(curlObj, (CURLoption)option, parameter.GetPtr());
+			result = _curl_easy_setopt_host(curl.GetPtr(), (CURLoption)option, parameter.GetPtr());
 			break;
 		}
 
@@ -1199,7 +1475,7 @@ void export_curl_easy_setopt(PPCInterpreter_t* hCPU)
 		{
 			curlDebug_logEasySetOptStr(curl.GetPtr(), "CURLOPT_POSTFIELDS", (const char*)parameter.GetPtr());
 			cemuLog_logDebug(LogType::Force, "curl_easy_setopt({}) [{}]", option, parameter.GetPtr());
-			result = ::curl_easy_setopt(curlObj, (CURLoption)option, parameter.GetPtr());
+			result = _curl_easy_setopt_host(curl.GetPtr(), (CURLoption)option, parameter.GetPtr());
 			break;
 		}
 
@@ -1207,7 +1483,7 @@ void export_curl_easy_setopt(PPCInterpreter_t* hCPU)
 		case CURLOPT_MAX_RECV_SPEED_LARGE:
 		case CURLOPT_POSTFIELDSIZE_LARGE:
 		{
-			result = ::curl_easy_setopt(curlObj, (CURLoption)option, parameterU64);
+			result = _curl_easy_setopt_host(curl.GetPtr(), (CURLoption)option, parameterU64);
 			break;
 		}
 		case 211: // verifyOpt
@@ -1216,14 +1492,14 @@ void export_curl_easy_setopt(PPCInterpreter_t* hCPU)
 			curl->nsslVerifyOptions = flags;
 
 			if (HAS_FLAG(flags, NSSL_VERIFY_PEER))
-				::curl_easy_setopt(curlObj, CURLOPT_SSL_VERIFYPEER, 1);
+				_curl_easy_setopt_host(curl.GetPtr(), CURLOPT_SSL_VERIFYPEER, 1);
 			else
-				::curl_easy_setopt(curlObj, CURLOPT_SSL_VERIFYPEER, 0);
+				_curl_easy_setopt_host(curl.GetPtr(), CURLOPT_SSL_VERIFYPEER, 0);
 
 			if (HAS_FLAG(flags, NSSL_VERIFY_HOSTNAME))
-				::curl_easy_setopt(curlObj, CURLOPT_SSL_VERIFYHOST, 2);
+				_curl_easy_setopt_host(curl.GetPtr(), CURLOPT_SSL_VERIFYHOST, 2);
 			else
-				::curl_easy_setopt(curlObj, CURLOPT_SSL_VERIFYHOST, 0);
+				_curl_easy_setopt_host(curl.GetPtr(), CURLOPT_SSL_VERIFYHOST, 0);
 
 			break;
 		}
@@ -1235,13 +1511,13 @@ void export_curl_easy_setopt(PPCInterpreter_t* hCPU)
 			if (nssl)
 			{
 				curl->hNSSL = nsslIndex;
-				result = ::curl_easy_setopt(curlObj, CURLOPT_SSL_CTX_FUNCTION, ssl_ctx_callback);
-				::curl_easy_setopt(curlObj, CURLOPT_SSL_CTX_DATA, curl.GetPtr());
+				result = _curl_easy_setopt_host(curl.GetPtr(), CURLOPT_SSL_CTX_FUNCTION, ssl_ctx_callback);
+				_curl_easy_setopt_host(curl.GetPtr(), CURLOPT_SSL_CTX_DATA, curl.GetPtr());
 
 				if (nssl->sslVersion == 2)
-					::curl_easy_setopt(curlObj, CURLOPT_SSLVERSION, CURL_SSLVERSION_SSLv3);
+					_curl_easy_setopt_host(curl.GetPtr(), CURLOPT_SSLVERSION, CURL_SSLVERSION_SSLv3);
 				else // auto = highest = 0 || 2 for v3
-					::curl_easy_setopt(curlObj, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1_2);
+					_curl_easy_setopt_host(curl.GetPtr(), CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1_2);
 			}
 			else
 				cemu_assert_suspicious();
@@ -1256,7 +1532,7 @@ void export_curl_easy_setopt(PPCInterpreter_t* hCPU)
 				curlSh->curl = curl;
 				shObj = curlSh->curlsh;
 			}
-			result = ::curl_easy_setopt(curlObj, CURLOPT_SHARE, shObj);
+			result = _curl_easy_setopt_host(curl.GetPtr(), CURLOPT_SHARE, shObj);
 			break;
 		}
 		case CURLOPT_HEADERFUNCTION:
@@ -1275,8 +1551,8 @@ void export_curl_easy_setopt(PPCInterpreter_t* hCPU)
 		{
 			curlDebug_logEasySetOptPtr(curl.GetPtr(), "CURLOPT_WRITEFUNCTION", parameter.GetMPTR());
 			curl->fwrite_func = parameter;
-			result = ::curl_easy_setopt(curlObj, CURLOPT_WRITEFUNCTION, write_callback);
-			::curl_easy_setopt(curlObj, CURLOPT_WRITEDATA, curl.GetPtr());
+			result = _curl_easy_setopt_host(curl.GetPtr(), CURLOPT_WRITEFUNCTION, write_callback);
+			_curl_easy_setopt_host(curl.GetPtr(), CURLOPT_WRITEDATA, curl.GetPtr());
 			break;
 		}
 		case CURLOPT_WRITEDATA: // aka CURLOPT_FILE
@@ -1294,8 +1570,8 @@ void export_curl_easy_setopt(PPCInterpreter_t* hCPU)
 		case CURLOPT_SOCKOPTFUNCTION:
 		{
 			curl->fsockopt = parameter;
-			result = ::curl_easy_setopt(curlObj, CURLOPT_SOCKOPTFUNCTION, sockopt_callback);
-			::curl_easy_setopt(curlObj, CURLOPT_SOCKOPTDATA, curl.GetPtr());
+			result = _curl_easy_setopt_host(curl.GetPtr(), CURLOPT_SOCKOPTFUNCTION, sockopt_callback);
+			_curl_easy_setopt_host(curl.GetPtr(), CURLOPT_SOCKOPTDATA, curl.GetPtr());
 			break;
 		}
 		case CURLOPT_SOCKOPTDATA:
@@ -1307,8 +1583,8 @@ void export_curl_easy_setopt(PPCInterpreter_t* hCPU)
 		{
 			curlDebug_logEasySetOptPtr(curl.GetPtr(), "CURLOPT_READFUNCTION", parameter.GetMPTR());
 			curl->fread_func_set = parameter;
-			result = ::curl_easy_setopt(curlObj, CURLOPT_READFUNCTION, read_callback);
-			::curl_easy_setopt(curlObj, CURLOPT_READDATA, curl.GetPtr());
+			result = _curl_easy_setopt_host(curl.GetPtr(), CURLOPT_READFUNCTION, read_callback);
+			_curl_easy_setopt_host(curl.GetPtr(), CURLOPT_READDATA, curl.GetPtr());
 			break;
 		}
 		case CURLOPT_READDATA:
@@ -1321,8 +1597,8 @@ void export_curl_easy_setopt(PPCInterpreter_t* hCPU)
 		{
 			curlDebug_logEasySetOptPtr(curl.GetPtr(), "CURLOPT_PROGRESSFUNCTION", parameter.GetMPTR());
 			curl->fprogress = parameter;
-			result = ::curl_easy_setopt(curlObj, CURLOPT_PROGRESSFUNCTION, progress_callback);
-			::curl_easy_setopt(curlObj, CURLOPT_PROGRESSDATA, curl.GetPtr());
+			result = _curl_easy_setopt_host(curl.GetPtr(), CURLOPT_PROGRESSFUNCTION, progress_callback);
+			_curl_easy_setopt_host(curl.GetPtr(), CURLOPT_PROGRESSDATA, curl.GetPtr());
 			break;
 		}
 		case CURLOPT_PROGRESSDATA:
@@ -1350,7 +1626,7 @@ WU_CURLcode curl_easy_perform(CURL_t* curl)
 		curl->isDirty = false;
 		_curl_sync_parameters(curl);
 	}
-	const uint32 result = SendOrderToWorker(curl, QueueOrder_Perform);
+	const uint32 result = CurlTransferLoop::GetInstance().Perform(curl);
 	return static_cast<WU_CURLcode>(result);
 }
 
@@ -1376,6 +1652,7 @@ void export_curl_easy_getinfo(PPCInterpreter_t* hCPU)
 	ppcDefineParamMEMPTR(parameter, void, 2);
 
 	CURL* curlObj = curl->curl;
+	CurlTransferLoop& transferLoop = CurlTransferLoop::GetInstance();
 
 	CURLcode result = CURLE_OK;
 	switch (info)
@@ -1387,7 +1664,7 @@ void export_curl_easy_getinfo(PPCInterpreter_t* hCPU)
 		case CURLINFO_CONTENT_LENGTH_DOWNLOAD:
 		{
 			double tempDouble = 0.0;
-			result = curl_easy_getinfo(curlObj, (CURLINFO)info, &tempDouble);
+			transferLoop.AccessHandle(curl, [&]() { result = curl_easy_getinfo(curlObj, (CURLINFO)info, &tempDouble); });
 			*(uint64*)parameter.GetPtr() = _swapEndianU64(*(uint64*)&tempDouble);
 			break;
 		}
@@ -1395,29 +1672,40 @@ void export_curl_easy_getinfo(PPCInterpreter_t* hCPU)
 		case CURLINFO_SSL_VERIFYRESULT:
 		{
 			long tempLong = 0;
-			result = curl_easy_getinfo(curlObj, (CURLINFO)info, &tempLong);
+			transferLoop.AccessHandle(curl, [&]() { result = curl_easy_getinfo(curlObj, (CURLINFO)info, &tempLong); });
 			*(uint32*)parameter.GetPtr() = _swapEndianU32((uint32)tempLong);
 			break;
 		}
 		case CURLINFO_CONTENT_TYPE:
 		{
-			char* contentType = nullptr;
-			result = curl_easy_getinfo(curlObj, CURLINFO_REDIRECT_URL, &contentType);
-			_updateGuestString(curl.GetPtr(), curl->info_contentType, contentType);
+			// the string is owned by the handle, copy it before it can change
+			std::optional<std::string> contentType;
+			transferLoop.AccessHandle(curl, [&]() {
+				char* str = nullptr;
+				result = curl_easy_getinfo(curlObj, CURLINFO_REDIRECT_URL, &str);
+				if (str)
+					contentType = str;
+			});
+			_updateGuestString(curl.GetPtr(), curl->info_contentType, contentType ? contentType->data() : nullptr);
 			*(MEMPTR<char>*)parameter.GetPtr() = curl->info_contentType;
 			break;
 		}
 		case CURLINFO_REDIRECT_URL:
 		{
-			char* redirectUrl = nullptr;
-			result = curl_easy_getinfo(curlObj, CURLINFO_REDIRECT_URL, &redirectUrl);
-			_updateGuestString(curl.GetPtr(), curl->info_redirectUrl, redirectUrl);
+			std::optional<std::string> redirectUrl;
+			transferLoop.AccessHandle(curl, [&]() {
+				char* str = nullptr;
+				result = curl_easy_getinfo(curlObj, CURLINFO_REDIRECT_URL, &str);
+				if (str)
+					redirectUrl = str;
+			});
+			_updateGuestString(curl.GetPtr(), curl->info_redirectUrl, redirectUrl ? redirectUrl->data() : nullptr);
 			*(MEMPTR<char>*)parameter.GetPtr() = curl->info_redirectUrl;
 			break;
 		}
 		default:
 			cemu_assert_unimplemented();
-			result = curl_easy_getinfo(curlObj, (CURLINFO)info, (double*)parameter.GetPtr());
+			transferLoop.AccessHandle(curl, [&]() { result = curl_easy_getinfo(curlObj, (CURLINFO)info, (double*)parameter.GetPtr()); });
 	}
 
 	cemuLog_logDebug(LogType::Force, "curl_easy_getinfo(0x{:08x}, 0x{:x}, 0x{:08x}) -> 0x{:x}", curl.GetMPTR(), info, parameter.GetMPTR(), result);
@@ -1,5 +1,6 @@
 #include "Cafe/OS/common/OSCommon.h"
 #include "nsysnet.h"
+#include "nsysnet_SocketReactor.h"
 #include "Cafe/OS/libs/coreinit/coreinit_Thread.h"
 #include "Cafe/IOSU/legacy/iosu_crypto.h"
 #include "Cafe/OS/libs/coreinit/coreinit_Time.h"
@@ -1024,6 +1025,10 @@ void nsysnetExport_send(PPCInterpreter_t* hCPU)
 	osLib_returnFromFunction(hCPU, r);
 }
 
+// blocking calls wait on the socket reactor with this timeout and then re-check the socket state
+// it only matters if a socket is closed by another thread while a wait is in progress
+#define SOCKET_WAIT_RECHECK_MS	(100)
+
 void nsysnetExport_recv(PPCInterpreter_t* hCPU)
 {
 	cemuLog_log(LogType::Socket, "recv({},0x{:08x},{},0x{:x})", hCPU->gpr[3], hCPU->gpr[4], hCPU->gpr[5], hCPU->gpr[6]);
@@ -1069,9 +1074,8 @@ void nsysnetExport_recv(PPCInterpreter_t* hCPU)
 				break; // connection closed
 			if (tr < 0 && GETLASTERR != WSAEWOULDBLOCK)
 				break;
-			// yield thread
-			coreinit::OSSleepTicks(coreinit::EspressoTime::GetTimerClock() / 5000); // let thread wait 0.2ms to give other threads CPU time
-			// todo - eventually we should find a way to asynchronously signal recv instead of busy-looping here
+			// suspend thread until data arrives
+			nsysnet::WaitForSocket(vs->s, nsysnet::SOCKET_WAIT_READ, SOCKET_WAIT_RECHECK_MS);
 		}
 		_setSocketSendRecvNonBlockingMode(vs->s, requestIsNonBlocking);
 	}
@@ -1154,6 +1158,22 @@ void _translateFDSetRev(struct wu_fd_set* fdset, fd_set* hostSet, sint32 nfds)
 
 }
 
+void _collectSocketWaitEntries(std::vector<nsysnet::SocketWaitEntry>& entries, struct wu_fd_set* fdset, sint32 nfds, uint8 events)
+{
+	if (fdset == NULL)
+		return;
+	uint32 mask = fdset->mask;
+	for (sint32 i = 0; i < nfds; i++)
+	{
+		if (((mask >> i) & 1) == 0)
+			continue;
+		virtualSocket_t* vs = nsysnet_getVirtualSocketObject(i);
+		if (vs == NULL)
+			continue;
+		entries.push_back({ vs->s, events, 0 });
+	}
+}
+
 void nsysnetExport_select(PPCInterpreter_t* hCPU)
 {
 	cemuLog_log(LogType::Socket, "select({},0x{:08x},0x{:08x},0x{:08x},0x{:08x})", hCPU->gpr[3], hCPU->gpr[4], hCPU->gpr[5], hCPU->gpr[6], hCPU->gpr[7]);
@@ -1190,10 +1210,9 @@ void nsysnetExport_select(PPCInterpreter_t* hCPU)
 			// when fd sets are empty but timeout is set, then just wait and do nothing?
 			// Lost Reavers seems to expect this case to return 0 (it hardcodes empty fd sets and timeout comes from curl_multi_timeout)
 
-			timeval tv;
-			tv.tv_sec = timeOut->tv_sec;
-			tv.tv_usec = timeOut->tv_usec;
-			select(0, nullptr, nullptr, nullptr, &tv);
+			// sleep on the guest side so the host thread of this core can keep running other threads
+			uint64 usTimeout = (uint64)_swapEndianU32(timeOut->tv_sec) * 1000000ULL + (uint64)_swapEndianU32(timeOut->tv_usec);
+			coreinit::OSSleepTicks(coreinit::EspressoTime::ConvertNsToTimerTicks(usTimeout * 1000ULL));
 			cemuLog_log(LogType::Socket, "select returned 0 because of empty fdsets with timeout");
 			osLib_returnFromFunction(hCPU, 0);
 			
@@ -1240,7 +1259,8 @@ void nsysnetExport_select(PPCInterpreter_t* hCPU)
 		else if (r == 0)
 		{
 			// check for timeout
-			if ((GetTickCount() - startTime) >= msTimeout )
+			uint64 elapsedMs = GetTickCount() - startTime;
+			if (elapsedMs >= msTimeout )
 			{
 				// timeout
 				_setSockError(WU_SO_SUCCESS);
@@ -1254,8 +1274,16 @@ void nsysnetExport_select(PPCInterpreter_t* hCPU)
 					exceptfds->mask = 0;
 				break;
 			}
-			// yield thread
-			PPCCore_switchToScheduler();
+			// suspend thread until any of the sockets becomes ready or the timeout expires
+			std::vector<nsysnet::SocketWaitEntry> waitEntries;
+			_collectSocketWaitEntries(waitEntries, readfds, nfds, nsysnet::SOCKET_WAIT_READ);
+			_collectSocketWaitEntries(waitEntries, writefds, nfds, nsysnet::SOCKET_WAIT_WRITE);
+			_collectSocketWaitEntries(waitEntries, exceptfds, nfds, nsysnet::SOCKET_WAIT_EXCEPT);
+			uint64 remainingMs = msTimeout - elapsedMs;
+			if (waitEntries.empty())
+				coreinit::OSSleepTicks(coreinit::EspressoTime::ConvertMsToTimerTicks(remainingMs));
+			else
+				nsysnet::WaitForSockets(waitEntries, std::min<uint64>(remainingMs, SOCKET_WAIT_RECHECK_MS));
 		}
 		else
 		{
@@ -1676,9 +1704,8 @@ void nsysnetExport_recvfrom(PPCInterpreter_t* hCPU)
 		}
 		else
 		{
-			// pause for a while and check again later
-			coreinit::OSSleepTicks(ESPRESSO_CORE_CLOCK / 1000); // pause for 1ms
-			PPCCore_switchToScheduler();
+			// suspend thread until data arrives
+			nsysnet::WaitForSocket(vs->s, nsysnet::SOCKET_WAIT_READ | nsysnet::SOCKET_WAIT_EXCEPT, SOCKET_WAIT_RECHECK_MS);
 		}
 	}
 	assert_dbg(); // should no longer be reached
@@ -1828,9 +1855,8 @@ void nsysnetExport_recvfrom_ex(PPCInterpreter_t* hCPU)
 		}
 		else
 		{
-			// pause for a while and check again later
-			coreinit::OSSleepTicks(ESPRESSO_CORE_CLOCK / 100); // pause for 10ms
-			PPCCore_switchToScheduler();
+			// suspend thread until data arrives
+			nsysnet::WaitForSocket(vs->s, nsysnet::SOCKET_WAIT_READ | nsysnet::SOCKET_WAIT_EXCEPT, SOCKET_WAIT_RECHECK_MS);
 		}
 	}
 	cemu_assert_debug(false); // should no longer be reached
@@ -1891,8 +1917,8 @@ void nsysnetExport_sendto(PPCInterpreter_t* hCPU)
 			{
 				if (wsaError != WSAEWOULDBLOCK)
 					break;
-				coreinit::OSSleepTicks(ESPRESSO_CORE_CLOCK / 100); // pause for 10ms
-				PPCCore_switchToScheduler();
+				// suspend thread until the send buffer has space
+				nsysnet::WaitForSocket(vs->s, nsysnet::SOCKET_WAIT_WRITE, SOCKET_WAIT_RECHECK_MS);
 				continue;
 			}
 			break;
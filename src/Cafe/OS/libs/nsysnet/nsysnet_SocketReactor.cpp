@@ -0,0 +1,232 @@
+#include "Cafe/OS/common/OSCommon.h"
+#include "Cafe/OS/libs/nsysnet/nsysnet_SocketReactor.h"
+#include "Cafe/OS/libs/coreinit/coreinit_Thread.h"
+#include "Cafe/OS/libs/coreinit/coreinit_Time.h"
+#include "util/helpers/helpers.h"
+
+#if BOOST_OS_UNIX
+#include <poll.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#define _reactorPoll poll
+#else
+#define _reactorPoll WSAPoll
+#endif
+
+namespace nsysnet
+{
+	// a single host thread polls all sockets that guest threads are currently blocked on
+	// guest threads wait on an OSEvent which is signaled once any of their sockets becomes ready
+	class SocketReactor
+	{
+		struct PendingWait
+		{
+			uint64 id;
+			std::span<SocketWaitEntry> entries;
+			coreinit::OSEvent* event;
+			bool isReady;
+		};
+
+	public:
+		~SocketReactor()
+		{
+			if (!m_thread.joinable())
+				return;
+			m_threadShouldExit = true;
+			Wakeup();
+			m_thread.join();
+			closesocket(m_wakeupSocket);
+		}
+
+		static SocketReactor& GetInstance()
+		{
+			static SocketReactor s_instance;
+			return s_instance;
+		}
+
+		bool Wait(std::span<SocketWaitEntry> entries, uint64 timeoutMs)
+		{
+			if (!EnsureRunning())
+			{
+				// fall back to sleeping for a short while, the caller re-checks the socket state
+				coreinit::OSSleepTicks(coreinit::EspressoTime::ConvertMsToTimerTicks(std::min<uint64>(timeoutMs, 1)));
+				return false;
+			}
+			for (auto& entry : entries)
+				entry.readyEvents = 0;
+			StackAllocator<coreinit::OSEvent> readyEvent;
+			coreinit::OSInitEvent(readyEvent.GetPointer(), coreinit::OSEvent::EVENT_STATE::STATE_NOT_SIGNALED, coreinit::OSEvent::EVENT_MODE::MODE_MANUAL);
+			PendingWait pendingWait{};
+			pendingWait.entries = entries;
+			pendingWait.event = readyEvent.GetPointer();
+			m_mutex.lock();
+			pendingWait.id = m_nextWaitId++;
+			m_pendingWaits.emplace_back(&pendingWait);
+			m_mutex.unlock();
+			Wakeup();
+			if (timeoutMs == SOCKET_WAIT_INFINITE)
+				coreinit::OSWaitEvent(readyEvent.GetPointer());
+			else
+				coreinit::OSWaitEventWithTimeout(readyEvent.GetPointer(), timeoutMs * 1000000ULL);
+			// once removed from the list the reactor thread no longer touches the event or the entries
+			std::unique_lock _l(m_mutex);
+			RemovePendingWait(pendingWait.id);
+			return pendingWait.isReady;
+		}
+
+	private:
+		bool EnsureRunning()
+		{
+			std::unique_lock _l(m_mutex);
+			if (m_thread.joinable())
+				return true;
+			if (m_initFailed)
+				return false;
+			// loopback UDP socket connected to itself, sending a datagram interrupts poll()
+			m_wakeupSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+			sockaddr_in addr{};
+			addr.sin_family = AF_INET;
+			addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			addr.sin_port = 0;
+			socklen_t addrLen = sizeof(addr);
+			if (m_wakeupSocket == INVALID_SOCKET ||
+				bind(m_wakeupSocket, (sockaddr*)&addr, sizeof(addr)) != 0 ||
+				getsockname(m_wakeupSocket, (sockaddr*)&addr, &addrLen) != 0 ||
+				connect(m_wakeupSocket, (sockaddr*)&addr, sizeof(addr)) != 0)
+			{
+				cemuLog_log(LogType::Force, "nsysnet: Failed to create socket reactor wakeup socket");
+				if (m_wakeupSocket != INVALID_SOCKET)
+					closesocket(m_wakeupSocket);
+				m_initFailed = true;
+				return false;
+			}
+#if BOOST_OS_WINDOWS
+			u_long nonBlocking = 1;
+			ioctlsocket(m_wakeupSocket, FIONBIO, &nonBlocking);
+#else
+			fcntl(m_wakeupSocket, F_SETFL, fcntl(m_wakeupSocket, F_GETFL) | O_NONBLOCK);
+#endif
+			m_thread = std::thread(&SocketReactor::ThreadFunc, this);
+			return true;
+		}
+
+		void Wakeup()
+		{
+			char b = 0;
+			send(m_wakeupSocket, &b, 1, 0);
+		}
+
+		// assumes lock is held
+		void RemovePendingWait(uint64 id)
+		{
+			auto it = std::find_if(m_pendingWaits.begin(), m_pendingWaits.end(), [id](PendingWait* w) { return w->id == id; });
+			if (it != m_pendingWaits.end())
+				m_pendingWaits.erase(it);
+		}
+
+		static short ToPollEvents(uint8 events)
+		{
+			short pollEvents = 0;
+			if (events & SOCKET_WAIT_READ)
+				pollEvents |= POLLIN;
+			if (events & SOCKET_WAIT_WRITE)
+				pollEvents |= POLLOUT;
+#if BOOST_OS_UNIX
+			// WSAPoll rejects POLLPRI. Errors are always reported via POLLERR/POLLHUP
+			if (events & SOCKET_WAIT_EXCEPT)
+				pollEvents |= POLLPRI;
+#endif
+			return pollEvents;
+		}
+
+		static uint8 FromPollEvents(short revents, uint8 requestedEvents)
+		{
+			uint8 events = 0;
+			if (revents & (POLLIN | POLLHUP))
+				events |= SOCKET_WAIT_READ;
+			if (revents & POLLOUT)
+				events |= SOCKET_WAIT_WRITE;
+			if (revents & (POLLPRI | POLLERR | POLLNVAL))
+				events |= SOCKET_WAIT_EXCEPT;
+			// errors and closed sockets wake up any kind of wait, the caller will see the error on its next socket call
+			if (revents & (POLLERR | POLLNVAL))
+				events |= requestedEvents;
+			return events & requestedEvents;
+		}
+
+		void ThreadFunc()
+		{
+			SetThreadName("nsysnet reactor");
+			std::vector<pollfd> pollFds;
+			std::vector<std::pair<uint64, size_t>> waitRanges; // wait id and index of its first entry in pollFds
+			while (!m_threadShouldExit)
+			{
+				pollFds.clear();
+				waitRanges.clear();
+				pollFds.push_back({ m_wakeupSocket, POLLIN, 0 });
+				m_mutex.lock();
+				for (PendingWait* wait : m_pendingWaits)
+				{
+					waitRanges.emplace_back(wait->id, pollFds.size());
+					for (auto& entry : wait->entries)
+						pollFds.push_back({ entry.s, ToPollEvents(entry.events), 0 });
+				}
+				m_mutex.unlock();
+				// closing a socket does not reliably interrupt poll(), callers use a finite timeout and re-check their socket
+				int r = _reactorPoll(pollFds.data(), (uint32)pollFds.size(), -1);
+				if (r < 0)
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+					continue;
+				}
+				if (pollFds[0].revents)
+				{
+					char buf[64];
+					while (recv(m_wakeupSocket, buf, sizeof(buf), 0) > 0) {}
+				}
+				std::unique_lock _l(m_mutex);
+				for (auto& [waitId, firstIndex] : waitRanges)
+				{
+					auto it = std::find_if(m_pendingWaits.begin(), m_pendingWaits.end(), [waitId](PendingWait* w) { return w->id == waitId; });
+					if (it == m_pendingWaits.end())
+						continue; // wait timed out in the meantime
+					PendingWait* wait = *it;
+					bool isReady = false;
+					for (size_t i = 0; i < wait->entries.size(); i++)
+					{
+						auto& entry = wait->entries[i];
+						entry.readyEvents = FromPollEvents(pollFds[firstIndex + i].revents, entry.events);
+						isReady |= entry.readyEvents != 0;
+					}
+					if (!isReady)
+						continue;
+					wait->isReady = true;
+					m_pendingWaits.erase(it);
+					coreinit::OSSignalEvent(wait->event);
+				}
+			}
+		}
+
+		std::mutex m_mutex;
+		std::vector<PendingWait*> m_pendingWaits;
+		uint64 m_nextWaitId{1};
+		SOCKET m_wakeupSocket{INVALID_SOCKET};
+		std::thread m_thread;
+		std::atomic_bool m_threadShouldExit{false};
+		bool m_initFailed{false};
+	};
+
+	bool WaitForSockets(std::span<SocketWaitEntry> entries, uint64 timeoutMs)
+	{
+		if (entries.empty() || timeoutMs == 0)
+			return false;
+		return SocketReactor::GetInstance().Wait(entries, timeoutMs);
+	}
+
+	bool WaitForSocket(SOCKET s, uint8 events, uint64 timeoutMs)
+	{
+		SocketWaitEntry entry{ s, events, 0 };
+		return WaitForSockets({ &entry, 1 }, timeoutMs);
+	}
+}
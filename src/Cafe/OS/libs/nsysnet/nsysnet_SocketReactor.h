@@ -0,0 +1,27 @@
+#pragma once
+#include "Common/socket.h"
+
+namespace nsysnet
+{
+	enum SOCKET_WAIT_EVENT : uint8
+	{
+		SOCKET_WAIT_READ = 1,
+		SOCKET_WAIT_WRITE = 2,
+		SOCKET_WAIT_EXCEPT = 4,
+	};
+
+	constexpr uint64 SOCKET_WAIT_INFINITE = ~0ULL;
+
+	struct SocketWaitEntry
+	{
+		SOCKET s;
+		uint8 events; // SOCKET_WAIT_*
+		uint8 readyEvents; // set on return
+	};
+
+	// suspends the current guest thread until at least one of the sockets is ready or the timeout (in milliseconds) expires
+	// readiness is detected by a host thread, so the emulated core keeps running other guest threads in the meantime
+	// returns false on timeout
+	bool WaitForSockets(std::span<SocketWaitEntry> entries, uint64 timeoutMs);
+	bool WaitForSocket(SOCKET s, uint8 events, uint64 timeoutMs);
+}
@@ -388,6 +388,7 @@ namespace snd_core
 	void AXOut_init();
 	void AXOut_reset();
 	void AXOut_update();
+	std::chrono::high_resolution_clock::time_point AXOut_getNextUpdateTime();
 
 	void Initialize();
 }
\ No newline at end of file
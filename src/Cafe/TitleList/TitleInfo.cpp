@@ -383,6 +383,7 @@ void _ZArchivePool_ReleaseInstance(const fs::path& path, ZArchiveReader* zar)
 	it->second.first--; // decrement ref count
 	if (it->second.first == 0)
 	{
+		FSCDeviceWUA_PurgeCache(it->second.second);
 		delete it->second.second;
 		sZArchivePool.erase(it);
 	}
@@ -43,4 +43,18 @@ void ExpressionParser_test()
 	cemu_assert_debug(_testEvaluateToType<float>("5 > 4 > 3 > 2") == 0.0f); // this should evaluate the operations from left to right, (5 > 4) -> 0.0, (0.0 > 4) -> 0.0, (0.0 > 3) -> 0.0, (0.0 > 2) -> 0.0
 	cemu_assert_debug(_testEvaluateToType<float>("5 > 4 > 3 > -2") == 1.0f); // this should evaluate the operations from left to right, (5 > 4) -> 0.0, (0.0 > 4) -> 0.0, (0.0 > 3) -> 0.0, (0.0 > -2) -> 1.0
 	cemu_assert_debug(_testEvaluateToType<float>("(5 == 5) > (5 == 6)") == 1.0f);
-}
\ No newline at end of file
+
+	// compiled expressions with symbol bindings
+	ExpressionParser::CompiledExpression compiled = ep.Compile("$width * 2 + ($height - 0x10) / 2");
+	cemu_assert_debug(compiled.GetSymbols().size() == 2);
+	ep.AddConstant("$width", 1280.0);
+	ep.AddConstant("$height", 736.0);
+	cemu_assert_debug(ep.Evaluate(compiled) == 2920.0);
+	ep.AddConstant("$width", 1920.0);
+	ep.AddConstant("$height", 1096.0);
+	cemu_assert_debug(ep.Evaluate(compiled) == 4380.0);
+	std::vector<double> boundValues;
+	ep.BindSymbols(compiled, boundValues);
+	boundValues[0] = 640.0;
+	cemu_assert_debug(ep.Evaluate(compiled, boundValues) == 1820.0);
+}
@@ -2,8 +2,8 @@
 #include "Common/precompiled.h"
 
 #include <string>
-#include <queue>
-#include <stack>
+#include <span>
+#include <optional>
 #include <unordered_map>
 #include <memory>
 #include <charconv>
@@ -34,6 +34,38 @@ public:
 	using ConstantCallback_t = TType(*)(std::string_view var_name);
 	using FunctionCallback_t = TType(*)(std::string_view var_name, TType parameter);
 
+	// an expression translated to postfix bytecode. Can be evaluated any number of times without parsing the string again
+	// constants are not resolved at compile time, instead each referenced name is assigned a symbol slot which is bound during evaluation
+	class CompiledExpression
+	{
+		friend class TExpressionParser<TType>;
+	public:
+		[[nodiscard]] bool IsEmpty() const { return m_instructions.empty(); }
+		[[nodiscard]] const std::vector<std::string>& GetSymbols() const { return m_symbols; }
+		[[nodiscard]] const std::string& GetSource() const { return m_source; }
+
+	private:
+		enum class OpType : uint8
+		{
+			kPushNumber,
+			kPushSymbol, // index = symbol slot
+			kFunction, // index = symbol slot of the function name
+			kOperator, // index = TokenOperator::Operator
+		};
+
+		struct Instruction
+		{
+			OpType type;
+			uint32 index;
+			TType number;
+		};
+
+		std::vector<Instruction> m_instructions;
+		std::vector<std::string> m_symbols;
+		uint32 m_maxStackDepth{};
+		std::string m_source; // for error messages
+	};
+
 	template<typename T>
 	T Evaluate(std::string_view expression) const
 	{
@@ -43,17 +75,110 @@ public:
 
 	[[nodiscard]] TType Evaluate(std::string_view expression) const
 	{
-		std::queue<std::shared_ptr<TokenBase>> output;
-		std::stack<std::shared_ptr<TokenBase>> operators;
+		return Evaluate(Compile(expression));
+	}
+
+	// evaluate a compiled expression, symbols are resolved via the constants and callbacks of this parser
+	[[nodiscard]] TType Evaluate(const CompiledExpression& expression) const
+	{
+		return _evaluate(expression, [&](uint32 slot) -> TType
+		{
+			const std::string& name = expression.m_symbols[slot];
+			const auto it = m_constants.find(name);
+			if (it != m_constants.cend())
+				return it->second;
+			if (m_constant_callback == nullptr)
+				throw std::runtime_error(fmt::format("unknown constant found \"{}\" in expression: {}", name, expression.m_source));
+			return m_constant_callback(name);
+		});
+	}
+
+	// evaluate a compiled expression with symbol values that were bound in advance (see BindSymbols)
+	[[nodiscard]] TType Evaluate(const CompiledExpression& expression, std::span<const TType> symbolValues) const
+	{
+		if (symbolValues.size() < expression.m_symbols.size())
+			throw std::runtime_error(fmt::format("not all symbols are bound for expression: {}", expression.m_source));
+		return _evaluate(expression, [&](uint32 slot) -> TType { return symbolValues[slot]; });
+	}
+
+	// resolve the value of every symbol slot. Slots which refer to function names are left at zero
+	void BindSymbols(const CompiledExpression& expression, std::vector<TType>& symbolValuesOut) const
+	{
+		symbolValuesOut.assign(expression.m_symbols.size(), (TType)0);
+		for (auto& ins : expression.m_instructions)
+		{
+			if (ins.type != CompiledExpression::OpType::kPushSymbol)
+				continue;
+			const std::string& name = expression.m_symbols[ins.index];
+			const auto it = m_constants.find(name);
+			if (it != m_constants.cend())
+				symbolValuesOut[ins.index] = it->second;
+			else if (m_constant_callback)
+				symbolValuesOut[ins.index] = m_constant_callback(name);
+			else
+				throw std::runtime_error(fmt::format("unknown constant found \"{}\" in expression: {}", name, expression.m_source));
+		}
+	}
+
+	// tokenize and apply shunting-yard once. Whether an identifier followed by '(' is a function call depends on the function callback being set at this point
+	[[nodiscard]] CompiledExpression Compile(std::string_view expression) const
+	{
+		CompiledExpression compiled;
+		compiled.m_source.assign(expression);
+		std::vector<PendingOperator> operators;
+		uint32 stackDepth = 0;
 
 		if (expression.empty())
 		{
 			throw std::runtime_error(fmt::format("empty expression is not allowed"));
 		}
 
+		auto getSymbolSlot = [&compiled](std::string_view name) -> uint32
+		{
+			for (size_t k = 0; k < compiled.m_symbols.size(); k++)
+			{
+				if (compiled.m_symbols[k] == name)
+					return (uint32)k;
+			}
+			compiled.m_symbols.emplace_back(name);
+			return (uint32)(compiled.m_symbols.size() - 1);
+		};
+
+		auto emitOperand = [&](typename CompiledExpression::OpType type, uint32 index, TType number)
+		{
+			compiled.m_instructions.push_back({ type, index, number });
+			stackDepth++;
+			compiled.m_maxStackDepth = std::max(compiled.m_maxStackDepth, stackDepth);
+		};
+
+		auto emitPending = [&](const PendingOperator& op)
+		{
+			auto& instructions = compiled.m_instructions;
+			if (op.kind == PendingOperator::kFunction)
+			{
+				if (stackDepth < 1)
+					throw std::runtime_error("not enough parameters for equation");
+				instructions.push_back({ CompiledExpression::OpType::kFunction, op.index, (TType)0 });
+				return;
+			}
+			cemu_assert_debug(op.kind == PendingOperator::kOperator);
+			if (stackDepth < 2)
+				throw std::runtime_error("not enough parameters for equation");
+			stackDepth--;
+			// fold operations on two literal numbers
+			const size_t count = instructions.size();
+			if (count >= 2 && instructions[count - 1].type == CompiledExpression::OpType::kPushNumber && instructions[count - 2].type == CompiledExpression::OpType::kPushNumber)
+			{
+				const TType folded = _applyOperator((typename TokenOperator::Operator)op.index, instructions[count - 2].number, instructions[count - 1].number);
+				instructions.pop_back();
+				instructions.back().number = folded;
+				return;
+			}
+			instructions.push_back({ CompiledExpression::OpType::kOperator, op.index, (TType)0 });
+		};
+
 		bool last_operator_token = true;
 
-		// tokenize and apply shunting-yard
 		for (size_t i = 0; i < expression.size(); )
 		{
 			const char c = expression[i];
@@ -71,7 +196,7 @@ public:
 				const std::string_view view(expression.data() + i, expression.size() - i);
 				size_t offset = 0;
 				auto converted = (TType)ConvertString(view, &offset);
-				output.emplace(std::make_shared<TokenNumber>(converted));
+				emitOperand(CompiledExpression::OpType::kPushNumber, 0, converted);
 				i += offset;
 
 				last_operator_token = false;
@@ -100,8 +225,8 @@ public:
 					// todo skip whitespaces
 					if (j < expression.size() && expression[j] == '(')
 					{
-						operators.emplace(std::make_shared<TokenUnaryOperator>(TokenUnaryOperator::kFunction, view));
-						operators.emplace(std::make_shared<TokenParenthese>());
+						operators.push_back({ PendingOperator::kFunction, getSymbolSlot(view) });
+						operators.push_back({ PendingOperator::kParenthese });
 						i += len + 1;
 
 						last_operator_token = true;
@@ -109,19 +234,7 @@ public:
 					}
 				}
 
-				TType value;
-				const auto it = m_constants.find(std::string{ view });
-				if (it == m_constants.cend())
-				{
-					if (m_constant_callback == nullptr)
-						throw std::runtime_error(fmt::format("unknown constant found \"{}\" in expression: {}", view, expression));
-
-					value = m_constant_callback(view);
-				}
-				else
-					value = it->second;
-
-				output.emplace(std::make_shared<TokenNumber>(value));
+				emitOperand(CompiledExpression::OpType::kPushSymbol, getSymbolSlot(view), (TType)0);
 				i += len;
 
 				last_operator_token = false;
@@ -131,7 +244,7 @@ public:
 			// parenthese
 			if (c == '(')
 			{
-				operators.emplace(std::make_shared<TokenParenthese>());
+				operators.push_back({ PendingOperator::kParenthese });
 				++i;
 
 				last_operator_token = true;
@@ -143,15 +256,14 @@ public:
 				bool match = false;
 				while (!operators.empty())
 				{
-					const auto op = std::dynamic_pointer_cast<TokenParenthese>(operators.top());
-					if (!op)
+					if (operators.back().kind != PendingOperator::kParenthese)
 					{
-						output.emplace(operators.top());
-						operators.pop();
+						emitPending(operators.back());
+						operators.pop_back();
 						continue;
 					}
 
-					operators.pop();
+					operators.pop_back();
 					match = true;
 					break;
 				}
@@ -166,61 +278,61 @@ public:
 			}
 
 			// supported operations
-			std::shared_ptr<TokenOperator> operator_token;
+			std::optional<TokenOperator> operator_token;
 			switch (c)
 			{
 			case '+':
-				operator_token = std::make_shared<TokenOperator>(TokenOperator::kAddition, 2);
+				operator_token.emplace(TokenOperator::kAddition, 2);
 				break;
 			case '-':
-				operator_token = std::make_shared<TokenOperator>(TokenOperator::kSubtraction, 2);
+				operator_token.emplace(TokenOperator::kSubtraction, 2);
 				break;
 			case '*':
-				operator_token = std::make_shared<TokenOperator>(TokenOperator::kMultiplication, 3);
+				operator_token.emplace(TokenOperator::kMultiplication, 3);
 				break;
 			case '/':
-				operator_token = std::make_shared<TokenOperator>(TokenOperator::kDivision, 3);
+				operator_token.emplace(TokenOperator::kDivision, 3);
 				break;
 			case '^':
-				operator_token = std::make_shared<TokenOperator>(TokenOperator::kPow, 4, true);
+				operator_token.emplace(TokenOperator::kPow, 4, true);
 				break;
 			case '%':
-				operator_token = std::make_shared<TokenOperator>(TokenOperator::kModulo, 3);
+				operator_token.emplace(TokenOperator::kModulo, 3);
 				break;
 			case '=':
 				if ((i + 1) < expression.size() && expression[i + 1] == '=')
 				{
-					operator_token = std::make_shared<TokenOperator>(TokenOperator::kEqual, 1);
+					operator_token.emplace(TokenOperator::kEqual, 1);
 					++i;
 				}
 				break;
 			case '!':
 				if ((i + 1) < expression.size() && expression[i + 1] == '=')
 				{
-					operator_token = std::make_shared<TokenOperator>(TokenOperator::kNotEqual, 1);
+					operator_token.emplace(TokenOperator::kNotEqual, 1);
 					++i;
 				}
 				break;
 			case '<':
 				if ((i + 1) < expression.size() && expression[i + 1] == '=')
 				{
-					operator_token = std::make_shared<TokenOperator>(TokenOperator::kLessOrEqual, 1);
+					operator_token.emplace(TokenOperator::kLessOrEqual, 1);
 					++i;
 				}
 				else
 				{
-					operator_token = std::make_shared<TokenOperator>(TokenOperator::kLessThan, 1);
+					operator_token.emplace(TokenOperator::kLessThan, 1);
 				}
 				break;
 			case '>':
 				if ((i + 1) < expression.size() && expression[i + 1] == '=')
 				{
-					operator_token = std::make_shared<TokenOperator>(TokenOperator::kGreaterOrEqual, 1);
+					operator_token.emplace(TokenOperator::kGreaterOrEqual, 1);
 					++i;
 				}
 				else
 				{
-					operator_token = std::make_shared<TokenOperator>(TokenOperator::kGreaterThan, 1);
+					operator_token.emplace(TokenOperator::kGreaterThan, 1);
 				}
 				break;
 			}
@@ -228,137 +340,39 @@ public:
 			if (!operator_token)
 				throw std::runtime_error(fmt::format("invalid operator found in expression: {}", expression));
 
+			// only binary operators are popped here, a pending function call stays on the stack until a closing parenthese or the end of the expression
 			while (!operators.empty())
 			{
-				const auto op = std::dynamic_pointer_cast<TokenOperator>(operators.top());
-				if (op && ((!operator_token->right_ass && operator_token->prec <= op->prec) || (operator_token->right_ass && operator_token->prec < op->prec)))
+				const auto& op = operators.back();
+				if (op.kind == PendingOperator::kOperator && ((!operator_token->right_ass && operator_token->prec <= op.prec) || (operator_token->right_ass && operator_token->prec < op.prec)))
 				{
-					output.emplace(operators.top());
-					operators.pop();
+					emitPending(op);
+					operators.pop_back();
 					continue;
 				}
 
 				break;
 			}
 
-			operators.emplace(operator_token);
+			operators.push_back({ PendingOperator::kOperator, (uint32)operator_token->op, operator_token->prec });
 			++i;
 			last_operator_token = true;
 		}
 
 		while (!operators.empty())
 		{
-			const auto parenthese = std::dynamic_pointer_cast<TokenParenthese>(operators.top());
-			if (parenthese)
+			if (operators.back().kind == PendingOperator::kParenthese)
 			{
 				throw std::runtime_error(fmt::format("parentheses mismatch in expression: {}", expression));
 			}
 
-			output.push(operators.top());
-			operators.pop();
+			emitPending(operators.back());
+			operators.pop_back();
 		}
 
-		// evaluate tokens in output queue
-		std::stack<TType> evaluation;
-		while (!output.empty())
-		{
-			const auto number = std::dynamic_pointer_cast<TokenNumber>(output.front());
-			if (number)
-			{
-				evaluation.emplace(number->number);
-				output.pop();
-				continue;
-			}
-
-			if (const auto unop = std::dynamic_pointer_cast<TokenUnaryOperator>(output.front()))
-			{
-				if (evaluation.size() < 1)
-					throw std::runtime_error("not enough parameters for equation");
-
-				const auto parameter = evaluation.top();
-				evaluation.pop();
-
-				switch (unop->op)
-				{
-				case TokenUnaryOperator::kFunction:
-					evaluation.emplace(m_function_callback(unop->symbol, parameter));
-					break;
-				default:
-					throw std::runtime_error("unsupported operation constant");
-				}
-
-				output.pop();
-				continue;
-			}
-			else if (const auto op = std::dynamic_pointer_cast<TokenOperator>(output.front()))
-			{
-				if (evaluation.size() < 2)
-					throw std::runtime_error("not enough parameters for equation");
-
-				const auto rhs = evaluation.top();
-				evaluation.pop();
-
-				const auto lhs = evaluation.top();
-				evaluation.pop();
-
-				switch (op->op)
-				{
-				case TokenOperator::kAddition:
-					evaluation.emplace(lhs + rhs);
-					break;
-				case TokenOperator::kSubtraction:
-					evaluation.emplace(lhs - rhs);
-					break;
-				case TokenOperator::kMultiplication:
-					evaluation.emplace(lhs * rhs);
-					break;
-				case TokenOperator::kDivision:
-					if (rhs == 0.0) evaluation.emplace((TType)0.0);
-					else evaluation.emplace(lhs / rhs);
-					break;
-				case TokenOperator::kPow:
-					evaluation.emplace((TType)std::pow(lhs, rhs));
-					break;
-				case TokenOperator::kModulo:
-					if (std::round(rhs) == 0.0)
-						evaluation.emplace((TType)0.0);
-					else
-						evaluation.emplace((TType)((sint64)std::round(lhs) % (sint64)std::round(rhs)));
-					break;
-				case TokenOperator::kEqual:
-					if constexpr (std::is_floating_point_v<TType>)
-						evaluation.emplace((TType)(std::abs(lhs - rhs) <= 0.0000000001 ? 1 : 0));
-					else
-						evaluation.emplace(lhs == rhs ? 1 : 0);
-					break;
-				case TokenOperator::kNotEqual:
-					if constexpr (std::is_floating_point_v<TType>)
-						evaluation.emplace((TType)(std::abs(lhs - rhs) > 0.0000000001 ? 1 : 0));
-					else
-						evaluation.emplace(lhs != rhs ? 1 : 0);
-					break;
-				case TokenOperator::kLessThan:
-					evaluation.emplace((TType)(lhs < rhs ? 1 : 0));
-					break;
-				case TokenOperator::kLessOrEqual:
-					evaluation.emplace((TType)(lhs <= rhs ? 1 : 0));
-					break;
-				case TokenOperator::kGreaterThan:
-					evaluation.emplace((TType)(lhs > rhs ? 1 : 0));
-					break;
-				case TokenOperator::kGreaterOrEqual:
-					evaluation.emplace((TType)(lhs >= rhs ? 1 : 0));
-					break;
-				default:
-					throw std::runtime_error("unsupported operation constant");
-				}
-
-				output.pop();
-				continue;
-			}
-		}
-
-		return evaluation.top();
+		if (stackDepth == 0)
+			throw std::runtime_error("not enough parameters for equation");
+		return compiled;
 	}
 
 	[[nodiscard]] bool IsValidExpression(std::string_view expression) const
@@ -507,26 +521,7 @@ private:
 			throw std::runtime_error(fmt::format("can't parse number: {}", str));
 	}
 
-	struct TokenBase
-	{
-		virtual ~TokenBase() = default;
-	};
-
-	struct TokenUnaryOperator : TokenBase
-	{
-		enum Operator
-		{
-			kFunction,
-		};
-
-		TokenUnaryOperator(Operator op) : op(op) {}
-		TokenUnaryOperator(Operator op, std::string_view symbol) : op(op), symbol(symbol) {}
-
-		Operator op;
-		std::string_view symbol;
-	};
-
-	struct TokenOperator : TokenBase
+	struct TokenOperator
 	{
 		enum Operator
 		{
@@ -550,13 +545,103 @@ private:
 		bool right_ass;
 	};
 
-	struct TokenParenthese : TokenBase {};
-
-	struct TokenNumber : TokenBase
+	// entry of the shunting-yard operator stack
+	struct PendingOperator
 	{
-		TokenNumber(TType number) : number(number) {}
-		TType number;
+		enum Kind : uint8
+		{
+			kParenthese,
+			kFunction, // index = symbol slot
+			kOperator, // index = TokenOperator::Operator
+		};
+
+		Kind kind;
+		uint32 index{};
+		int prec{};
 	};
+
+	static TType _applyOperator(typename TokenOperator::Operator op, TType lhs, TType rhs)
+	{
+		switch (op)
+		{
+		case TokenOperator::kAddition:
+			return lhs + rhs;
+		case TokenOperator::kSubtraction:
+			return lhs - rhs;
+		case TokenOperator::kMultiplication:
+			return lhs * rhs;
+		case TokenOperator::kDivision:
+			if (rhs == 0.0) return (TType)0.0;
+			return lhs / rhs;
+		case TokenOperator::kPow:
+			return (TType)std::pow(lhs, rhs);
+		case TokenOperator::kModulo:
+			if (std::round(rhs) == 0.0)
+				return (TType)0.0;
+			return (TType)((sint64)std::round(lhs) % (sint64)std::round(rhs));
+		case TokenOperator::kEqual:
+			if constexpr (std::is_floating_point_v<TType>)
+				return (TType)(std::abs(lhs - rhs) <= 0.0000000001 ? 1 : 0);
+			else
+				return lhs == rhs ? 1 : 0;
+		case TokenOperator::kNotEqual:
+			if constexpr (std::is_floating_point_v<TType>)
+				return (TType)(std::abs(lhs - rhs) > 0.0000000001 ? 1 : 0);
+			else
+				return lhs != rhs ? 1 : 0;
+		case TokenOperator::kLessThan:
+			return (TType)(lhs < rhs ? 1 : 0);
+		case TokenOperator::kLessOrEqual:
+			return (TType)(lhs <= rhs ? 1 : 0);
+		case TokenOperator::kGreaterThan:
+			return (TType)(lhs > rhs ? 1 : 0);
+		case TokenOperator::kGreaterOrEqual:
+			return (TType)(lhs >= rhs ? 1 : 0);
+		default:
+			throw std::runtime_error("unsupported operation constant");
+		}
+	}
+
+	template<typename TResolver>
+	TType _evaluate(const CompiledExpression& expression, TResolver resolveSymbol) const
+	{
+		using OpType = typename CompiledExpression::OpType;
+		// nothing to evaluate, e.g. a default constructed expression
+		if (expression.IsEmpty())
+			return {};
+		// the stack size is known at compile time, avoid a heap allocation for typical expressions
+		TType localStack[16];
+		std::vector<TType> heapStack;
+		TType* stack = localStack;
+		if (expression.m_maxStackDepth > std::size(localStack))
+		{
+			heapStack.resize(expression.m_maxStackDepth);
+			stack = heapStack.data();
+		}
+		size_t sp = 0;
+		for (const auto& ins : expression.m_instructions)
+		{
+			switch (ins.type)
+			{
+			case OpType::kPushNumber:
+				stack[sp++] = ins.number;
+				break;
+			case OpType::kPushSymbol:
+				stack[sp++] = resolveSymbol(ins.index);
+				break;
+			case OpType::kFunction:
+				if (m_function_callback == nullptr)
+					throw std::runtime_error(fmt::format("no function callback set for expression: {}", expression.m_source));
+				stack[sp - 1] = m_function_callback(expression.m_symbols[ins.index], stack[sp - 1]);
+				break;
+			case OpType::kOperator:
+				sp--;
+				stack[sp - 1] = _applyOperator((typename TokenOperator::Operator)ins.index, stack[sp - 1], stack[sp]);
+				break;
+			}
+		}
+		return stack[sp - 1];
+	}
 };
 
 class ExpressionParser : public TExpressionParser<double> {};
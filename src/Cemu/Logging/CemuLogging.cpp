@@ -10,6 +10,7 @@
 #include <chrono>
 
 #include <fmt/printf.h>
+#include <fmt/args.h>
 
 uint64 s_loggingFlagMask = cemuLog_getFlag(LogType::Force);
 
@@ -71,6 +72,91 @@ void cemuLog_clearCallbacks()
 	s_loggingDispatcher.clearCallbacks();
 }
 
+// header of a deferred log record, followed by the encoded arguments (or the text for LOG_FORMAT_TEXT)
+struct LogRecordHeader
+{
+	uint32 size; // including header and alignment
+	uint32 formatId;
+	sint64 timestamp; // system clock in nanoseconds
+	LogType type;
+	uint32 argCount;
+};
+
+constexpr uint32 LOG_FORMAT_TEXT = 0xFFFFFFFE; // preformatted text
+constexpr uint32 LOG_RECORD_PADDING = 0xFFFFFFFF; // skip to the start of the ring buffer
+constexpr uint32 LOG_MAX_FORMAT_STRINGS = 0x10000;
+
+// single producer (the owning thread), single consumer (the log writer thread)
+class LogRingBuffer
+{
+public:
+	static constexpr size_t SIZE = 256 * 1024;
+	static constexpr size_t MAX_RECORD_SIZE = SIZE / 4;
+
+	// producer
+	uint8* Allocate(size_t size)
+	{
+		size_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+		const size_t readIndex = m_readIndex.load(std::memory_order_acquire);
+		const size_t contiguous = SIZE - (writeIndex & (SIZE - 1));
+		const size_t padding = size > contiguous ? contiguous : 0;
+		if (writeIndex + padding + size - readIndex > SIZE)
+			return nullptr;
+		if (padding)
+		{
+			// if the remaining space is too small for a header the consumer skips it implicitly
+			if (contiguous >= sizeof(LogRecordHeader))
+				((LogRecordHeader*)(m_data + (writeIndex & (SIZE - 1))))->formatId = LOG_RECORD_PADDING;
+			writeIndex += padding;
+		}
+		m_pendingWriteIndex = writeIndex + size;
+		return m_data + (writeIndex & (SIZE - 1));
+	}
+
+	void Commit()
+	{
+		m_writeIndex.store(m_pendingWriteIndex, std::memory_order_release);
+	}
+
+	// consumer
+	template<typename TFunc>
+	void ForEachRecord(TFunc&& func, size_t& endIndex)
+	{
+		size_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+		endIndex = m_writeIndex.load(std::memory_order_acquire);
+		while (readIndex < endIndex)
+		{
+			const size_t contiguous = SIZE - (readIndex & (SIZE - 1));
+			LogRecordHeader* header = (LogRecordHeader*)(m_data + (readIndex & (SIZE - 1)));
+			if (contiguous < sizeof(LogRecordHeader) || header->formatId == LOG_RECORD_PADDING)
+			{
+				readIndex += contiguous;
+				continue;
+			}
+			func(header);
+			readIndex += header->size;
+		}
+	}
+
+	void Release(size_t endIndex)
+	{
+		m_readIndex.store(endIndex, std::memory_order_release);
+	}
+
+	bool IsEmpty() const
+	{
+		return m_readIndex.load(std::memory_order_acquire) == m_writeIndex.load(std::memory_order_acquire);
+	}
+
+	std::atomic_bool inUse{false}; // owned by a thread
+
+private:
+	alignas(64) std::atomic<size_t> m_writeIndex{0};
+	size_t m_pendingWriteIndex{0};
+	alignas(64) std::atomic<size_t> m_readIndex{0};
+	alignas(64) uint8 m_data[SIZE];
+};
+
 struct _LogContext
 {
 	std::condition_variable_any log_condition;
@@ -79,6 +165,14 @@ struct _LogContext
 	std::vector<std::string> text_cache;
 	std::thread log_writer;
 	std::atomic<bool> threadRunning = false;
+	std::atomic<bool> writerSleeping = false; // set by the writer thread before it waits for new records
+
+	// deferred logging
+	std::mutex ring_mutex;
+	std::vector<std::unique_ptr<LogRingBuffer>> ring_buffers; // never freed, rings of exited threads are reused
+	std::mutex format_mutex;
+	std::deque<std::string> format_strings; // indexed by format id
+	std::unordered_map<std::string_view, uint32> format_lookup;
 
 	~_LogContext()
 	{
@@ -86,12 +180,34 @@ struct _LogContext
 		threadRunning.store(false);
 		if (log_writer.joinable())
 		{
-			log_condition.notify_one();
+			writerSleeping.store(false);
+			{
+				std::unique_lock _l(log_mutex);
+				log_condition.notify_one();
+			}
 			log_writer.join();
 		}
 	}
 }LogContext;
 
+thread_local bool s_isLogWriterThread = false;
+
+static bool _ringBuffersEmpty()
+{
+	std::unique_lock _l(LogContext.ring_mutex);
+	return std::all_of(LogContext.ring_buffers.cbegin(), LogContext.ring_buffers.cend(), [](const auto& ring) { return ring->IsEmpty(); });
+}
+
+// wakes the writer thread if it is waiting for new records
+// the mutex is taken so the wakeup can't get lost between the writer's last check and its wait
+static void _wakeLogWriter()
+{
+	if (!LogContext.writerSleeping.load(std::memory_order_relaxed) || !LogContext.writerSleeping.exchange(false))
+		return;
+	std::unique_lock _l(LogContext.log_mutex);
+	LogContext.log_condition.notify_one();
+}
+
 const std::map<LogType, std::string> g_logging_window_mapping
 {
 	{LogType::UnsupportedAPI,     "Unsupported API calls"},
@@ -125,17 +241,154 @@ bool cemuLog_advancedPPCLoggingEnabled()
 	return GetConfig().advanced_ppc_logging;
 }
 
+static void _dispatchLogLine(LogType type, std::string_view text)
+{
+	if (LaunchSettings::Verbose())
+		std::cout << text << std::endl;
+
+	const auto it = std::find_if(g_logging_window_mapping.cbegin(), g_logging_window_mapping.cend(),
+		[type](const auto& entry) { return entry.first == type; });
+	if (it == g_logging_window_mapping.cend())
+		s_loggingDispatcher.Log(text);
+	else
+		s_loggingDispatcher.Log(it->second, text);
+}
+
+static std::string _formatTimestamp(std::chrono::system_clock::time_point now)
+{
+	const auto temp_time = std::chrono::system_clock::to_time_t(now);
+	const auto& time = *std::localtime(&temp_time);
+	return fmt::format("[{:02d}:{:02d}:{:02d}.{:03d}] ", time.tm_hour, time.tm_min, time.tm_sec,
+		std::chrono::duration_cast<std::chrono::milliseconds>(now - std::chrono::time_point_cast<std::chrono::seconds>(now)).count());
+}
+
+static std::string _formatRecord(const LogRecordHeader* header)
+{
+	const uint8* p = (const uint8*)(header + 1);
+	if (header->formatId == LOG_FORMAT_TEXT)
+		return std::string((const char*)p, header->argCount);
+	const std::string* format;
+	{
+		std::unique_lock _l(LogContext.format_mutex);
+		format = &LogContext.format_strings[header->formatId];
+	}
+	fmt::dynamic_format_arg_store<fmt::format_context> args;
+	for (uint32 i = 0; i < header->argCount; i++)
+	{
+		const auto type = (cemuLog_detail::ArgType)*p;
+		if (type == cemuLog_detail::ArgType::String)
+		{
+			uint32 length;
+			memcpy(&length, p + 1, sizeof(uint32));
+			args.push_back(std::string_view((const char*)p + 1 + sizeof(uint32), length));
+			p += 1 + sizeof(uint32) + length;
+			continue;
+		}
+		uint64 v;
+		memcpy(&v, p + 1, sizeof(uint64));
+		p += 1 + sizeof(uint64);
+		switch (type)
+		{
+		case cemuLog_detail::ArgType::Bool:
+			args.push_back(v != 0);
+			break;
+		case cemuLog_detail::ArgType::Char:
+			args.push_back((char)v);
+			break;
+		case cemuLog_detail::ArgType::SInt:
+			args.push_back((long long)v);
+			break;
+		case cemuLog_detail::ArgType::UInt:
+			args.push_back((unsigned long long)v);
+			break;
+		case cemuLog_detail::ArgType::Float:
+		{
+			float f;
+			memcpy(&f, &v, sizeof(float));
+			args.push_back(f);
+			break;
+		}
+		case cemuLog_detail::ArgType::Double:
+		{
+			double d;
+			memcpy(&d, &v, sizeof(double));
+			args.push_back(d);
+			break;
+		}
+		case cemuLog_detail::ArgType::Pointer:
+			args.push_back((const void*)(uintptr_t)v);
+			break;
+		default:
+			cemu_assert_suspicious();
+		}
+	}
+	try
+	{
+		return fmt::vformat(*format, args);
+	}
+	catch (const std::exception& e)
+	{
+		return fmt::format("{} (log format error: {})", *format, e.what());
+	}
+}
+
+// formats and writes all deferred records. Records of different threads are merged by their timestamp
+// note: this does not respect cemuLog_acquire(), lines from other threads may be interleaved
+static bool _flushRingBuffers()
+{
+	std::vector<LogRingBuffer*> rings;
+	LogContext.ring_mutex.lock();
+	for (auto& ring : LogContext.ring_buffers)
+		rings.emplace_back(ring.get());
+	LogContext.ring_mutex.unlock();
+
+	std::vector<const LogRecordHeader*> records;
+	std::vector<size_t> endIndices(rings.size());
+	for (size_t i = 0; i < rings.size(); i++)
+		rings[i]->ForEachRecord([&](const LogRecordHeader* header) { records.emplace_back(header); }, endIndices[i]);
+	if (records.empty())
+		return false;
+	std::stable_sort(records.begin(), records.end(), [](const LogRecordHeader* a, const LogRecordHeader* b) { return a->timestamp < b->timestamp; });
+
+	std::string lines;
+	for (const LogRecordHeader* header : records)
+	{
+		const std::string text = _formatRecord(header);
+		lines.append(_formatTimestamp(std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(header->timestamp)))));
+		lines.append(text);
+		lines.push_back('\n');
+		_dispatchLogLine(header->type, text);
+	}
+	for (size_t i = 0; i < rings.size(); i++)
+		rings[i]->Release(endIndices[i]);
+	LogContext.file_stream.write(lines.data(), lines.size());
+	return true;
+}
+
 void cemuLog_thread()
 {
 	SetThreadName("cemuLog_thread");
+	s_isLogWriterThread = true;
 	while (true)
 	{
+		const bool hasRecords = _flushRingBuffers();
+
 		std::unique_lock lock(LogContext.log_mutex);
-		while (LogContext.text_cache.empty())
+		if (LogContext.text_cache.empty())
 		{
-			LogContext.log_condition.wait(lock);
+			if (hasRecords)
+				LogContext.file_stream.flush();
 			if (!LogContext.threadRunning.load(std::memory_order::relaxed))
 				return;
+			// producers of deferred records only signal the writer once it announced that it is going to sleep, see _wakeLogWriter()
+			LogContext.writerSleeping.store(true);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			LogContext.log_condition.wait(lock, []()
+			{
+				return !LogContext.writerSleeping.load() || !LogContext.text_cache.empty() || !LogContext.threadRunning.load() || !_ringBuffersEmpty();
+			});
+			LogContext.writerSleeping.store(false, std::memory_order_relaxed);
+			continue;
 		}
 
 		std::vector<std::string> cache_copy;
@@ -149,6 +402,113 @@ void cemuLog_thread()
 	}
 }
 
+namespace cemuLog_detail
+{
+	struct ThreadRingBuffer
+	{
+		LogRingBuffer* ring{};
+		std::unordered_map<const char*, std::pair<uint32, const std::string*>> formatCache;
+
+		~ThreadRingBuffer()
+		{
+			if (ring)
+				ring->inUse.store(false, std::memory_order_release);
+		}
+
+		LogRingBuffer* Get()
+		{
+			if (ring)
+				return ring;
+			std::unique_lock _l(LogContext.ring_mutex);
+			for (auto& it : LogContext.ring_buffers)
+			{
+				bool expected = false;
+				if (it->inUse.compare_exchange_strong(expected, true))
+				{
+					ring = it.get();
+					return ring;
+				}
+			}
+			ring = LogContext.ring_buffers.emplace_back(std::make_unique<LogRingBuffer>()).get();
+			ring->inUse.store(true);
+			return ring;
+		}
+
+		uint32 GetFormatId(std::string_view format)
+		{
+			// the pointer is only a hint, format strings are not required to be string literals
+			auto it = formatCache.find(format.data());
+			if (it != formatCache.end() && *it->second.second == format)
+				return it->second.first;
+			std::unique_lock _l(LogContext.format_mutex);
+			uint32 formatId;
+			auto lookupIt = LogContext.format_lookup.find(format);
+			if (lookupIt != LogContext.format_lookup.end())
+				formatId = lookupIt->second;
+			else
+			{
+				if (LogContext.format_strings.size() >= LOG_MAX_FORMAT_STRINGS)
+					return LOG_FORMAT_TEXT; // format strings are probably generated at runtime
+				formatId = (uint32)LogContext.format_strings.size();
+				const std::string& str = LogContext.format_strings.emplace_back(format);
+				LogContext.format_lookup.emplace(str, formatId);
+			}
+			if (formatCache.size() >= 1024)
+				formatCache.clear();
+			formatCache[format.data()] = { formatId, &LogContext.format_strings[formatId] };
+			return formatId;
+		}
+	};
+
+	thread_local ThreadRingBuffer s_threadRingBuffer;
+
+	static uint8* _allocateRecord(LogType type, uint32 formatId, uint32 argCount, size_t dataSize)
+	{
+		const size_t recordSize = (sizeof(LogRecordHeader) + dataSize + 7) & ~(size_t)7;
+		if (recordSize > LogRingBuffer::MAX_RECORD_SIZE)
+			return nullptr;
+		LogRingBuffer* ring = s_threadRingBuffer.Get();
+		uint8* p;
+		while ((p = ring->Allocate(recordSize)) == nullptr)
+		{
+			// ring is full, wait for the writer thread to catch up
+			_wakeLogWriter();
+			std::this_thread::yield();
+		}
+		LogRecordHeader* header = (LogRecordHeader*)p;
+		header->size = (uint32)recordSize;
+		header->formatId = formatId;
+		header->timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		header->type = type;
+		header->argCount = argCount;
+		return p + sizeof(LogRecordHeader);
+	}
+
+	static bool _isDeferredLoggingAvailable()
+	{
+		// the writer thread itself (e.g. logging callbacks) must never wait for ring buffer space
+		return LogContext.threadRunning.load(std::memory_order_relaxed) && !s_isLogWriterThread;
+	}
+
+	uint8* AllocateRecord(LogType type, std::string_view format, uint32 argCount, size_t argDataSize)
+	{
+		if (!_isDeferredLoggingAvailable())
+			return nullptr;
+		const uint32 formatId = s_threadRingBuffer.GetFormatId(format);
+		if (formatId == LOG_FORMAT_TEXT)
+			return nullptr;
+		return _allocateRecord(type, formatId, argCount, argDataSize);
+	}
+
+	void CommitRecord()
+	{
+		s_threadRingBuffer.ring->Commit();
+		// pairs with the store of writerSleeping in the writer thread, either the writer sees the record or we see that it sleeps
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		_wakeLogWriter();
+	}
+}
+
 fs::path cemuLog_GetLogFilePath()
 {
     return ActiveSettings::GetUserDataPath("log.txt");
@@ -178,16 +538,7 @@ void cemuLog_writeLineToLog(std::string_view text, bool date, bool new_line)
 	std::unique_lock lock(LogContext.log_mutex);
 
 	if (date)
-	{
-		const auto now = std::chrono::system_clock::now();
-		const auto temp_time = std::chrono::system_clock::to_time_t(now);
-		const auto& time = *std::localtime(&temp_time);
-
-		auto time_str = fmt::format("[{:02d}:{:02d}:{:02d}.{:03d}] ", time.tm_hour, time.tm_min, time.tm_sec,
-			std::chrono::duration_cast<std::chrono::milliseconds>(now - std::chrono::time_point_cast<std::chrono::seconds>(now)).count());
-
-		LogContext.text_cache.emplace_back(std::move(time_str));
-	}
+		LogContext.text_cache.emplace_back(_formatTimestamp(std::chrono::system_clock::now()));
 
 	LogContext.text_cache.emplace_back(text);
 
@@ -203,18 +554,19 @@ bool cemuLog_log(LogType type, std::string_view text)
 	if (!cemuLog_isLoggingEnabled(type))
 		return false;
 
-	if (LaunchSettings::Verbose())
-		std::cout << text << std::endl;
+	if (cemuLog_detail::_isDeferredLoggingAvailable())
+	{
+		// for text records argCount stores the length
+		if (uint8* p = cemuLog_detail::_allocateRecord(type, LOG_FORMAT_TEXT, (uint32)text.size(), text.size()))
+		{
+			memcpy(p, text.data(), text.size());
+			cemuLog_detail::CommitRecord();
+			return true;
+		}
+	}
 
 	cemuLog_writeLineToLog(text);
-
-	const auto it = std::find_if(g_logging_window_mapping.cbegin(), g_logging_window_mapping.cend(),
-		[type](const auto& entry) { return entry.first == type; });
-	if (it == g_logging_window_mapping.cend())
-		s_loggingDispatcher.Log(text);
-	else
-		s_loggingDispatcher.Log(it->second, text);
-
+	_dispatchLogLine(type, text);
 	return true;
 }
 
@@ -228,8 +580,9 @@ void cemuLog_waitForFlush()
 {
 	cemuLog_createLogFile(false);
 	std::unique_lock lock(LogContext.log_mutex);
-	while(!LogContext.text_cache.empty())
+	while(!LogContext.text_cache.empty() || !_ringBuffersEmpty())
 	{
+		_wakeLogWriter();
 		lock.unlock();
 		std::this_thread::sleep_for(std::chrono::milliseconds(1));
 		std::this_thread::yield();
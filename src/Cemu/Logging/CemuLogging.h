@@ -78,6 +78,118 @@ bool cemuLog_log(LogType type, std::string_view text);
 bool cemuLog_log(LogType type, std::u8string_view text);
 void cemuLog_waitForFlush(); // wait until all log lines are written
 
+// once the log writer thread is running, log calls whose arguments are all plain values or strings are not formatted on the calling thread
+// instead the format string id and the raw arguments are appended to a lock-free per-thread ring buffer and formatted by the writer thread
+namespace cemuLog_detail
+{
+	enum class ArgType : uint8
+	{
+		Bool,
+		Char,
+		SInt,
+		UInt,
+		Float,
+		Double,
+		Pointer,
+		String,
+	};
+
+	template<typename T, typename D = std::decay_t<T>>
+	constexpr bool isDeferrableArg =
+		(std::is_arithmetic_v<D> && !std::is_same_v<D, wchar_t> && !std::is_same_v<D, char8_t> && !std::is_same_v<D, char16_t> && !std::is_same_v<D, char32_t> && !std::is_same_v<D, long double>) ||
+		std::is_same_v<D, void*> || std::is_same_v<D, const void*> ||
+		std::is_same_v<D, char*> || std::is_same_v<D, const char*> ||
+		std::is_same_v<D, std::string> || std::is_same_v<D, std::string_view>;
+
+	// returns pointer to the argument storage of a new record in the ring buffer of the current thread or nullptr if deferred logging is not available
+	uint8* AllocateRecord(LogType type, std::string_view format, uint32 argCount, size_t argDataSize);
+	void CommitRecord();
+
+	template<typename T>
+	size_t GetArgSize(const T& arg)
+	{
+		using D = std::decay_t<T>;
+		if constexpr (std::is_same_v<D, std::string> || std::is_same_v<D, std::string_view>)
+			return 1 + sizeof(uint32) + arg.size();
+		else if constexpr (std::is_array_v<T>)
+			return 1 + sizeof(uint32) + strlen(arg); // char arrays can't be null, testing them would trigger -Waddress
+		else if constexpr (std::is_same_v<D, char*> || std::is_same_v<D, const char*>)
+			return 1 + sizeof(uint32) + (arg ? strlen(arg) : 0);
+		else
+			return 1 + sizeof(uint64);
+	}
+
+	template<typename T>
+	uint8* WriteArg(uint8* p, const T& arg)
+	{
+		using D = std::decay_t<T>;
+		if constexpr (std::is_same_v<D, std::string> || std::is_same_v<D, std::string_view> || std::is_same_v<D, char*> || std::is_same_v<D, const char*>)
+		{
+			std::string_view str;
+			if constexpr (std::is_array_v<T>)
+				str = std::string_view(arg);
+			else if constexpr (std::is_pointer_v<D>)
+				str = arg ? std::string_view(arg) : std::string_view();
+			else
+				str = arg;
+			uint32 length = (uint32)str.size();
+			*p = (uint8)ArgType::String;
+			memcpy(p + 1, &length, sizeof(uint32));
+			memcpy(p + 1 + sizeof(uint32), str.data(), length);
+			return p + 1 + sizeof(uint32) + length;
+		}
+		else
+		{
+			ArgType type;
+			uint64 v = 0;
+			if constexpr (std::is_same_v<D, bool>)
+			{
+				type = ArgType::Bool;
+				v = arg ? 1 : 0;
+			}
+			else if constexpr (std::is_same_v<D, char>)
+			{
+				type = ArgType::Char;
+				v = (uint8)arg;
+			}
+			else if constexpr (std::is_floating_point_v<D>)
+			{
+				type = sizeof(D) == sizeof(float) ? ArgType::Float : ArgType::Double;
+				memcpy(&v, &arg, sizeof(D));
+			}
+			else if constexpr (std::is_pointer_v<D>)
+			{
+				type = ArgType::Pointer;
+				v = (uint64)(uintptr_t)arg;
+			}
+			else if constexpr (std::is_signed_v<D>)
+			{
+				type = ArgType::SInt;
+				v = (uint64)(sint64)arg;
+			}
+			else
+			{
+				type = ArgType::UInt;
+				v = (uint64)arg;
+			}
+			*p = (uint8)type;
+			memcpy(p + 1, &v, sizeof(uint64));
+			return p + 1 + sizeof(uint64);
+		}
+	}
+
+	template<typename ... TArgs>
+	bool LogDeferred(LogType type, std::string_view format, const TArgs&... args)
+	{
+		uint8* p = AllocateRecord(type, format, (uint32)sizeof...(TArgs), (GetArgSize(args) + ...));
+		if (!p)
+			return false;
+		((p = WriteArg(p, args)), ...);
+		CommitRecord();
+		return true;
+	}
+}
+
 template<typename T, typename ... TArgs>
 bool cemuLog_log(LogType type, std::basic_string<T> formatStr, TArgs&&... args)
 {
@@ -90,6 +202,11 @@ bool cemuLog_log(LogType type, std::basic_string<T> formatStr, TArgs&&... args)
 	}
 	else
 	{
+		if constexpr (std::is_same_v<T, char> && (cemuLog_detail::isDeferrableArg<TArgs> && ...))
+		{
+			if (cemuLog_detail::LogDeferred(type, std::string_view(formatStr), args...))
+				return true;
+		}
 		const auto format_view = fmt::basic_string_view<T>(formatStr);
 #if FMT_VERSION >= 110000
 		const auto text = fmt::vformat(format_view, fmt::make_format_args<fmt::buffered_context<T>>(args...));
@@ -106,6 +223,12 @@ bool cemuLog_log(LogType type, const T* format, TArgs&&... args)
 {
 	if (!cemuLog_isLoggingEnabled(type))
 		return false;
+	if constexpr (std::is_same_v<T, char> && sizeof...(TArgs) > 0 && (cemuLog_detail::isDeferrableArg<TArgs> && ...))
+	{
+		// skips the temporary string
+		if (cemuLog_detail::LogDeferred(type, std::string_view(format), args...))
+			return true;
+	}
 	auto format_str = std::basic_string<T>(format);
 	return cemuLog_log(type, format_str, std::forward<TArgs>(args)...);
 }
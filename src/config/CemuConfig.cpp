@@ -135,6 +135,7 @@ XMLConfigParser CemuConfig::Load(XMLConfigParser& parser)
 	fullscreen_scaling = graphic.get("FullscreenScaling", kKeepAspectRatio);
 	async_compile = graphic.get("AsyncCompile", async_compile);
 	vk_accurate_barriers = graphic.get("vkAccurateBarriers", true); // this used to be "VulkanAccurateBarriers" but because we changed the default to true in 1.27.1 the option name had to be changed
+	convert_vertex_streams = graphic.get("ConvertVertexStreams", false);
 
 	auto overlay_node = graphic.get("Overlay");
 	if(overlay_node.valid())
@@ -353,6 +354,7 @@ XMLConfigParser CemuConfig::Save(XMLConfigParser& parser)
 	graphic.set("FullscreenScaling", fullscreen_scaling);
 	graphic.set("AsyncCompile", async_compile.GetValue());
 	graphic.set("vkAccurateBarriers", vk_accurate_barriers);
+	graphic.set("ConvertVertexStreams", convert_vertex_streams);
 
 	auto overlay_node = graphic.set("Overlay");
 	overlay_node.set("Position", overlay.position);
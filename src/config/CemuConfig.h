@@ -390,6 +390,7 @@ struct CemuConfig
 	ConfigValue<bool> async_compile{ true };
 
 	ConfigValue<bool> vk_accurate_barriers{ true };
+	ConfigValue<bool> convert_vertex_streams{ false }; // byte swap static vertex data on the CPU instead of in every vertex shader invocation
 
 	struct
 	{
@@ -13,9 +13,19 @@
 
 #include "Cafe/Filesystem/FST/FST.h"
 #include "util/helpers/StringHelpers.h"
+#include "tools/Tools.h"
 
 void requireConsole();
 
+// runs a console tool in place of the emulator
+template<typename TFunc>
+static bool _RunTool(TFunc&& tool)
+{
+	requireConsole();
+	tool();
+	return false;
+}
+
 bool LaunchSettings::HandleCommandline(const wchar_t* lpCmdLine)
 {
 	#if BOOST_OS_WINDOWS
@@ -79,6 +89,13 @@ bool LaunchSettings::HandleCommandline(const std::vector<std::wstring>& args)
 	hidden.add_options()
 		("nsight", po::value<bool>()->implicit_value(true), "NSight debugging options")
 		("legacy", po::value<bool>()->implicit_value(true), "Intel legacy graphic mode")
+		("null-renderer", po::value<bool>()->implicit_value(true), "Use a renderer without GPU output for measuring CPU performance")
+		("replay-gpu-capture", po::wvalue<std::wstring>(), "Replay a GPU command stream capture instead of launching a game")
+		("benchmark-shader-cache", po::wvalue<std::wstring>(), "Decompile all shaders of a transferable shader cache file and print timings")
+		("benchmark-iterations", po::value<uint32>()->default_value(1), "Number of passes over the shader cache for --benchmark-shader-cache")
+		("benchmark-fibers", po::value<uint32>()->implicit_value(1000000), "Measure the cost of a fiber switch")
+		("benchmark-heaps", po::value<uint32>()->implicit_value(1000000), "Replay a randomized allocation trace and compare heap allocators")
+		("check-texture-decoders", po::value<bool>()->implicit_value(true), "Compare the table generated texture decoders against the previous per-texel decoders")
 		("ppcrec-lower-addr", po::value<std::string>(), "For debugging: Lower address allowed for PPC recompilation")
 		("ppcrec-upper-addr", po::value<std::string>(), "For debugging: Upper address allowed for PPC recompilation");
 
@@ -180,6 +197,12 @@ bool LaunchSettings::HandleCommandline(const std::vector<std::wstring>& args)
 		if (vm.count("nsight"))
 			s_nsight_mode = vm["nsight"].as<bool>();
 
+		if (vm.count("replay-gpu-capture"))
+			s_replay_gpu_capture_file = vm["replay-gpu-capture"].as<std::wstring>();
+
+		if (vm.count("null-renderer"))
+			s_null_renderer = vm["null-renderer"].as<bool>();
+
 		if(vm.count("force-interpreter"))
 			s_force_interpreter = vm["force-interpreter"].as<bool>();
 
@@ -218,6 +241,15 @@ bool LaunchSettings::HandleCommandline(const std::vector<std::wstring>& args)
 			return false;
 		}
 
+		if (vm.count("benchmark-shader-cache"))
+			return _RunTool([&] { ToolShaderCacheBenchmark(vm["benchmark-shader-cache"].as<std::wstring>(), std::max<uint32>(vm["benchmark-iterations"].as<uint32>(), 1)); });
+		if (vm.count("benchmark-fibers"))
+			return _RunTool([&] { ToolFiberBenchmark(std::max<uint32>(vm["benchmark-fibers"].as<uint32>(), 1)); });
+		if (vm.count("benchmark-heaps"))
+			return _RunTool([&] { ToolHeapBenchmark(std::max<uint32>(vm["benchmark-heaps"].as<uint32>(), 1)); });
+		if (vm.count("check-texture-decoders"))
+			return _RunTool([] { ToolCheckTextureDecoders(); });
+
 		return true;
 	}
 	catch (const std::exception& ex)
@@ -16,6 +16,7 @@ public:
 	static bool HandleCommandline(const std::vector<std::wstring>& args);
 
 	static std::optional<fs::path> GetLoadFile() { return s_load_game_file; }
+	static std::optional<fs::path> GetGPUCaptureReplayFile() { return s_replay_gpu_capture_file; }
     static std::optional<uint64> GetLoadTitleID() {return s_load_title_id;}
 	static std::optional<fs::path> GetMLCPath() { return s_mlc_path; }
 
@@ -26,6 +27,7 @@ public:
 
 	static bool GDBStubEnabled() { return s_enable_gdbstub; }
 	static bool NSightModeEnabled() { return s_nsight_mode; }
+	static bool NullRendererEnabled() { return s_null_renderer; }
 
 	static bool ForceInterpreter() { return s_force_interpreter; };
 	static bool ForceMultiCoreInterpreter() { return s_force_multicore_interpreter; }
@@ -37,6 +39,7 @@ public:
 
 private:
 	inline static std::optional<fs::path> s_load_game_file{};
+	inline static std::optional<fs::path> s_replay_gpu_capture_file{};
     inline static std::optional<uint64> s_load_title_id{};
 	inline static std::optional<fs::path> s_mlc_path{};
 
@@ -47,6 +50,7 @@ private:
 	
 	inline static bool s_enable_gdbstub = false;
 	inline static bool s_nsight_mode = false;
+	inline static bool s_null_renderer = false;
 
 	inline static bool s_force_interpreter = false;
 	inline static bool s_force_multicore_interpreter = false;
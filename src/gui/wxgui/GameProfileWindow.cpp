@@ -81,6 +81,10 @@ GameProfileWindow::GameProfileWindow(wxWindow* parent, uint64_t title_id)
 
 			box_sizer->Add(first_row, 0, wxEXPAND, 5);
 
+			m_skip_spin_loops = new wxCheckBox(box, wxID_ANY, _("Skip spin loops"));
+			m_skip_spin_loops->SetToolTip(_("EXPERT OPTION\nThreads which busy-wait on memory give up their time slice early. Only affects the recompiler"));
+			box_sizer->Add(m_skip_spin_loops, 0, wxALL, 5);
+
 
 			sizer->Add(box_sizer, 0, wxEXPAND, 5);
 		}
@@ -262,6 +266,7 @@ void GameProfileWindow::ApplyProfile()
 	}
 	
 	m_thread_quantum->SetStringSelection(fmt::format("{}", m_game_profile.m_threadQuantum));
+	m_skip_spin_loops->SetValue(m_game_profile.m_skipSpinLoops);
 
 	// gpu
 	if (!m_game_profile.m_graphics_api.has_value())
@@ -325,6 +330,7 @@ void GameProfileWindow::SaveProfile()
 		m_game_profile.m_threadQuantum = std::min<uint32>(m_game_profile.m_threadQuantum, 536870912);
 		m_game_profile.m_threadQuantum = std::max<uint32>(m_game_profile.m_threadQuantum, 5000);
 	}
+	m_game_profile.m_skipSpinLoops = m_skip_spin_loops->GetValue();
 
 	// gpu
 	m_game_profile.m_accurateShaderMul = (AccurateShaderMulOption)m_shader_mul_accuracy->GetSelection();
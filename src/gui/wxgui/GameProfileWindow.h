@@ -33,6 +33,7 @@ private:
 	// cpu
 	wxChoice *m_cpu_mode;
 	wxChoice* m_thread_quantum;
+	wxCheckBox* m_skip_spin_loops;
 
 	// gpu
 	//wxCheckBox* m_extended_texture_readback;
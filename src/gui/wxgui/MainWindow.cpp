@@ -12,6 +12,7 @@
 #include "wxgui/windows/TextureRelationViewer/TextureRelationWindow.h"
 #include "wxgui/windows/PPCThreadsViewer/DebugPPCThreadsWindow.h"
 #include "AudioDebuggerWindow.h"
+#include "wxgui/canvas/NullCanvas.h"
 #include "wxgui/canvas/OpenGLCanvas.h"
 #include "wxgui/canvas/VulkanCanvas.h"
 #include "Cafe/OS/libs/nfc/nfc.h"
@@ -41,6 +42,7 @@
 #include "wxgui/GettingStartedDialog.h"
 #include "wxgui/helpers/wxHelpers.h"
 #include "Cafe/HW/Latte/Renderer/Vulkan/VsyncDriver.h"
+#include "Cafe/HW/Latte/Core/LatteCapture.h"
 #include "wxgui/input/InputSettings2.h"
 #include "wxgui/input/HotkeySettings.h"
 #include "input/InputManager.h"
@@ -154,6 +156,7 @@ enum
 	MAINFRAME_MENU_ID_DEBUG_DUMP_RAM,
 	MAINFRAME_MENU_ID_DEBUG_DUMP_FST,
 	MAINFRAME_MENU_ID_DEBUG_DUMP_CURL_REQUESTS,
+	MAINFRAME_MENU_ID_DEBUG_DUMP_GPU_CAPTURE,
 	// help
 	MAINFRAME_MENU_ID_HELP_ABOUT = 21700,
 	MAINFRAME_MENU_ID_HELP_UPDATE,
@@ -219,6 +222,7 @@ EVT_MENU(MAINFRAME_MENU_ID_DEBUG_DUMP_TEXTURES, MainWindow::OnDebugDumpGeneric)
 EVT_MENU(MAINFRAME_MENU_ID_DEBUG_DUMP_SHADERS, MainWindow::OnDebugDumpGeneric)
 EVT_MENU(MAINFRAME_MENU_ID_DEBUG_DUMP_RECOMPILER_FUNCTIONS, MainWindow::OnDebugDumpGeneric)
 EVT_MENU(MAINFRAME_MENU_ID_DEBUG_DUMP_CURL_REQUESTS, MainWindow::OnDebugSetting)
+EVT_MENU(MAINFRAME_MENU_ID_DEBUG_DUMP_GPU_CAPTURE, MainWindow::OnDebugSetting)
 // debug -> Other options
 EVT_MENU(MAINFRAME_MENU_ID_DEBUG_RENDER_UPSIDE_DOWN, MainWindow::OnDebugSetting)
 EVT_MENU(MAINFRAME_MENU_ID_DEBUG_AUDIO_AUX_ONLY, MainWindow::OnDebugSetting)
@@ -344,6 +348,17 @@ MainWindow::MainWindow()
 
         }
     }
+    else if (auto replay_file = LaunchSettings::GetGPUCaptureReplayFile())
+    {
+        // replaying a GPU capture only needs the render canvas
+        quick_launch = true;
+        CallAfter([this, path = replay_file.value()]()
+        {
+            CreateCanvas();
+            if (!LatteReplay_Start(path))
+                wxMessageBox(_("Failed to open GPU capture file"), _("Error"), wxOK | wxCENTRE | wxICON_ERROR);
+        });
+    }
     SetSizer(main_sizer);
     if (!quick_launch)
     {
@@ -446,6 +461,7 @@ void MainWindow::OnClose(wxCloseEvent& event)
 
 	event.Skip();
 
+	LatteReplay_Stop();
     CafeSystem::Shutdown();
 	DestroyCanvas();
 }
@@ -1068,6 +1084,13 @@ void MainWindow::OnDebugSetting(wxCommandEvent& event)
 			}
 		}
 	}
+	else if (event.GetId() == MAINFRAME_MENU_ID_DEBUG_DUMP_GPU_CAPTURE)
+	{
+		if (event.IsChecked())
+			LatteCapture_RequestStart(ActiveSettings::GetUserDataPath("dump/capture/{:016x}_{}.lcap", CafeSystem::GetForegroundTitleId(), (uint32)time(nullptr)));
+		else
+			LatteCapture_RequestStop();
+	}
 	else if (event.GetId() == MAINFRAME_MENU_ID_TIMER_SPEED_8X)
 		ActiveSettings::SetTimerShiftFactor(0);
 	else if (event.GetId() == MAINFRAME_MENU_ID_TIMER_SPEED_4X)
@@ -1591,7 +1614,9 @@ void MainWindow::CreateCanvas()
     this->GetSizer()->Add(m_game_panel, 1, wxEXPAND, 0, nullptr);
 
     // create canvas
-    if (ActiveSettings::GetGraphicsAPI() == kVulkan)
+    if (LaunchSettings::NullRendererEnabled())
+		m_render_canvas = new NullCanvas(m_game_panel, wxSize(1280, 720), true);
+	else if (ActiveSettings::GetGraphicsAPI() == kVulkan)
 		m_render_canvas = new VulkanCanvas(m_game_panel, wxSize(1280, 720), true);
 	else
 		m_render_canvas = GLCanvas_Create(m_game_panel, wxSize(1280, 720), true);
@@ -2285,6 +2310,7 @@ void MainWindow::RecreateMenu()
 	debugDumpMenu->AppendCheckItem(MAINFRAME_MENU_ID_DEBUG_DUMP_SHADERS, _("&Shaders"), wxEmptyString)->Check(ActiveSettings::DumpShadersEnabled());
 	debugDumpMenu->AppendCheckItem(MAINFRAME_MENU_ID_DEBUG_DUMP_RECOMPILER_FUNCTIONS, _("&Recompiled functions"), wxEmptyString)->Check(ActiveSettings::DumpRecompilerFunctionsEnabled());
 	debugDumpMenu->AppendCheckItem(MAINFRAME_MENU_ID_DEBUG_DUMP_CURL_REQUESTS, _("&nlibcurl HTTP/HTTPS requests"), wxEmptyString);
+	debugDumpMenu->AppendCheckItem(MAINFRAME_MENU_ID_DEBUG_DUMP_GPU_CAPTURE, _("&GPU command stream"), wxEmptyString)->Check(LatteCapture_IsRecording());
 	// debug submenu
 	wxMenu* debugMenu = new wxMenu();
 	m_debugMenu = debugMenu;
@@ -6,6 +6,7 @@
 
 #include "config/ActiveSettings.h"
 #include "Cafe/OS/libs/swkbd/swkbd.h"
+#include "wxgui/canvas/NullCanvas.h"
 #include "wxgui/canvas/OpenGLCanvas.h"
 #include "wxgui/canvas/VulkanCanvas.h"
 #include "config/CemuConfig.h"
@@ -72,7 +73,9 @@ void PadViewFrame::InitializeRenderCanvas()
 {
 	auto sizer = new wxBoxSizer(wxVERTICAL);
 	{
-		if (ActiveSettings::GetGraphicsAPI() == kVulkan)
+		if (LaunchSettings::NullRendererEnabled())
+			m_render_canvas = new NullCanvas(this, wxSize(854, 480), false);
+		else if (ActiveSettings::GetGraphicsAPI() == kVulkan)
 			m_render_canvas = new VulkanCanvas(this, wxSize(854, 480), false);
 		else
 			m_render_canvas = GLCanvas_Create(this, wxSize(854, 480), false);
@@ -0,0 +1,9 @@
+#include "wxgui/canvas/NullCanvas.h"
+#include "Cafe/HW/Latte/Renderer/Null/NullRenderer.h"
+
+NullCanvas::NullCanvas(wxWindow* parent, const wxSize& size, bool is_main_window)
+	: IRenderCanvas(is_main_window), wxWindow(parent, wxID_ANY, wxDefaultPosition, size, wxNO_FULL_REPAINT_ON_RESIZE | wxWANTS_CHARS)
+{
+	if (is_main_window)
+		g_renderer = std::make_unique<NullRenderer>();
+}
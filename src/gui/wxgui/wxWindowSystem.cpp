@@ -101,6 +101,9 @@ void WindowSystem::UpdateWindowTitles(bool isIdle, bool isLoading, double fps)
 		case RendererAPI::Vulkan:
 			renderer = "[Vulkan]";
 			break;
+		case RendererAPI::Null:
+			renderer = "[Null]";
+			break;
 		default:;
 		}
 	}
@@ -154,6 +154,7 @@ void gx2CopySurfaceTest();
 void ExpressionParser_test();
 void FSTVolumeTest();
 void CRCTest();
+void PPCInterpreterSlim_benchmark();
 
 void UnitTests()
 {
@@ -162,6 +163,7 @@ void UnitTests()
 	ppcAsmTest();
 	FSTVolumeTest();
 	CRCTest();
+	PPCInterpreterSlim_benchmark();
 }
 
 bool isConsoleConnected = false;
@@ -0,0 +1,73 @@
+#include "tools/Tools.h"
+#include "util/Fiber/Fiber.h"
+#include "util/highresolutiontimer/HighResolutionTimer.h"
+#if BOOST_OS_UNIX
+#include <ucontext.h>
+#endif
+
+// measures the cost of switching between two fibers. On Unix the result is compared against a plain swapcontext() ping-pong
+
+struct FiberBenchmarkState
+{
+	Fiber* mainFiber;
+	Fiber* workerFiber;
+};
+
+static void _fiberBenchmarkEntry(void* userParam)
+{
+	FiberBenchmarkState* state = (FiberBenchmarkState*)userParam;
+	while (true)
+		Fiber::Switch(*state->mainFiber);
+}
+
+static double _measureSwitchesPerSecond(uint32 numRoundTrips, const std::function<void()>& roundTrip)
+{
+	HRTick startTick = HighResolutionTimer::now().getTick();
+	for (uint32 i = 0; i < numRoundTrips; i++)
+		roundTrip();
+	HRTick endTick = HighResolutionTimer::now().getTick();
+	double seconds = (double)(endTick - startTick) / (double)HighResolutionTimer::getFrequency();
+	return (double)numRoundTrips * 2.0 / seconds;
+}
+
+#if BOOST_OS_UNIX
+static ucontext_t s_ucontextMain;
+static ucontext_t s_ucontextWorker;
+
+static void _ucontextBenchmarkEntry()
+{
+	while (true)
+		swapcontext(&s_ucontextWorker, &s_ucontextMain);
+}
+#endif
+
+bool ToolFiberBenchmark(uint32 numRoundTrips)
+{
+	// run on a fresh thread since Fiber::PrepareCurrentThread() can only be called once per thread
+	std::thread benchmarkThread([numRoundTrips]()
+	{
+		FiberBenchmarkState state{};
+		state.mainFiber = Fiber::PrepareCurrentThread();
+		state.workerFiber = new Fiber(_fiberBenchmarkEntry, &state, nullptr);
+		Fiber::Switch(*state.workerFiber); // warm up, touches the stack
+		double fiberSwitches = _measureSwitchesPerSecond(numRoundTrips, [&]() { Fiber::Switch(*state.workerFiber); });
+		printf("Fiber::Switch   %12.0f switches/s  %8.2fns per switch\n", fiberSwitches, 1000000000.0 / fiberSwitches);
+		delete state.workerFiber;
+
+#if BOOST_OS_UNIX
+		const size_t stackSize = 256 * 1024;
+		std::vector<uint8> stack(stackSize);
+		getcontext(&s_ucontextWorker);
+		s_ucontextWorker.uc_stack.ss_sp = stack.data();
+		s_ucontextWorker.uc_stack.ss_size = stackSize;
+		s_ucontextWorker.uc_link = nullptr;
+		makecontext(&s_ucontextWorker, _ucontextBenchmarkEntry, 0);
+		swapcontext(&s_ucontextMain, &s_ucontextWorker);
+		double ucontextSwitches = _measureSwitchesPerSecond(numRoundTrips, []() { swapcontext(&s_ucontextMain, &s_ucontextWorker); });
+		printf("swapcontext     %12.0f switches/s  %8.2fns per switch\n", ucontextSwitches, 1000000000.0 / ucontextSwitches);
+		printf("Speedup: %.2fx\n", fiberSwitches / ucontextSwitches);
+#endif
+	});
+	benchmarkThread.join();
+	return true;
+}
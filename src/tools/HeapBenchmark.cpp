@@ -0,0 +1,218 @@
+#include "tools/Tools.h"
+#include "util/TLSFHeap/TLSFHeap.h"
+#include "util/ChunkedHeap/ChunkedHeap.h"
+#include "util/highresolutiontimer/HighResolutionTimer.h"
+#include <random>
+
+// replays a randomized allocation trace against the TLSF heap and the range allocators it replaced
+// first-fit: walks all allocations in address order, like the previous VirtualBufferHeap
+// bucketed: scans power of two buckets of free ranges, like the previous VHeap (ChunkedHeap still uses this scheme)
+
+constexpr uint32 HEAP_BENCHMARK_SIZE = 64 * 1024 * 1024;
+constexpr uint32 HEAP_BENCHMARK_ALIGNMENT = 256;
+
+struct HeapTraceOp
+{
+	bool isAlloc;
+	uint32 id;
+	uint32 size;
+};
+
+// the trace keeps the heap around 70% occupied. Sizes are log-uniform between 256 bytes and 1MB, freed allocations are picked at random
+static std::vector<HeapTraceOp> _generateTrace(uint32 numOps, uint32& numIdsOut)
+{
+	std::mt19937 rng(0x7F4A7C15);
+	std::uniform_real_distribution<double> sizeLog2(8.0, 20.0);
+	std::uniform_real_distribution<double> chance(0.0, 1.0);
+	std::vector<HeapTraceOp> trace;
+	trace.reserve(numOps);
+	std::vector<std::pair<uint32, uint32>> liveIds; // id, size
+	uint64 liveBytes = 0;
+	uint32 nextId = 0;
+	for (uint32 i = 0; i < numOps; i++)
+	{
+		double allocChance = liveBytes < (uint64)HEAP_BENCHMARK_SIZE * 7 / 10 ? 0.6 : 0.4;
+		if (liveIds.empty() || chance(rng) < allocChance)
+		{
+			uint32 size = (uint32)std::exp2(sizeLog2(rng));
+			trace.push_back({ true, nextId, size });
+			liveIds.emplace_back(nextId, size);
+			liveBytes += size;
+			nextId++;
+		}
+		else
+		{
+			size_t index = std::uniform_int_distribution<size_t>(0, liveIds.size() - 1)(rng);
+			trace.push_back({ false, liveIds[index].first, 0 });
+			liveBytes -= liveIds[index].second;
+			liveIds[index] = liveIds.back();
+			liveIds.pop_back();
+		}
+	}
+	numIdsOut = nextId;
+	return trace;
+}
+
+class HeapBenchmarkFirstFit
+{
+public:
+	bool Alloc(uint32 size, uint32& offsetOut)
+	{
+		size = (size + HEAP_BENCHMARK_ALIGNMENT - 1) & ~(HEAP_BENCHMARK_ALIGNMENT - 1);
+		uint32 currentOffset = 0;
+		auto it = m_allocations.begin();
+		for (; it != m_allocations.end(); ++it)
+		{
+			if (currentOffset + size <= it->first)
+				break;
+			currentOffset = it->second;
+		}
+		if (currentOffset + size > HEAP_BENCHMARK_SIZE)
+			return false;
+		m_allocations.emplace_hint(it, currentOffset, currentOffset + size);
+		offsetOut = currentOffset;
+		return true;
+	}
+
+	void Free(uint32 offset)
+	{
+		m_allocations.erase(offset);
+	}
+
+private:
+	std::map<uint32, uint32> m_allocations; // start and end offset
+};
+
+class HeapBenchmarkBucketed : public ChunkedHeap<HEAP_BENCHMARK_ALIGNMENT>
+{
+	uint32 allocateNewChunk(uint32 chunkIndex, uint32 minimumAllocationSize) override
+	{
+		return chunkIndex == 0 ? HEAP_BENCHMARK_SIZE : 0;
+	}
+};
+
+struct HeapBenchmarkResult
+{
+	std::vector<uint64> allocTicks;
+	std::vector<uint64> freeTicks;
+	uint32 numFailed{};
+	uint32 highWaterMark{};
+};
+
+static double _ticksToNanoseconds(uint64 ticks)
+{
+	return (double)ticks * 1000000000.0 / (double)HighResolutionTimer::getFrequency();
+}
+
+template<typename TAlloc, typename TFree>
+static HeapBenchmarkResult _runTrace(const std::vector<HeapTraceOp>& trace, uint32 numIds, TAlloc allocFunc, TFree freeFunc)
+{
+	HeapBenchmarkResult result;
+	result.allocTicks.reserve(trace.size());
+	result.freeTicks.reserve(trace.size());
+	std::vector<bool> isAllocated(numIds);
+	for (auto& op : trace)
+	{
+		if (op.isAlloc)
+		{
+			uint32 offset, size;
+			HRTick startTick = HighResolutionTimer::now().getTick();
+			bool r = allocFunc(op.id, op.size, offset, size);
+			result.allocTicks.emplace_back(HighResolutionTimer::now().getTick() - startTick);
+			isAllocated[op.id] = r;
+			if (r)
+				result.highWaterMark = std::max(result.highWaterMark, offset + size);
+			else
+				result.numFailed++;
+		}
+		else if (isAllocated[op.id])
+		{
+			HRTick startTick = HighResolutionTimer::now().getTick();
+			freeFunc(op.id);
+			result.freeTicks.emplace_back(HighResolutionTimer::now().getTick() - startTick);
+			isAllocated[op.id] = false;
+		}
+	}
+	return result;
+}
+
+static void _printResult(const char* name, HeapBenchmarkResult& result)
+{
+	auto printLatency = [](const char* opName, std::vector<uint64>& ticks)
+	{
+		if (ticks.empty())
+			return;
+		std::sort(ticks.begin(), ticks.end());
+		uint64 sumTicks = 0;
+		for (uint64 t : ticks)
+			sumTicks += t;
+		printf("  %s avg %8.1fns  p50 %8.1fns  p99 %8.1fns  max %10.1fns\n", opName, _ticksToNanoseconds(sumTicks) / (double)ticks.size(),
+			_ticksToNanoseconds(ticks[ticks.size() / 2]), _ticksToNanoseconds(ticks[std::min(ticks.size() * 99 / 100, ticks.size() - 1)]), _ticksToNanoseconds(ticks.back()));
+	};
+	printf("%s:\n", name);
+	printLatency("alloc", result.allocTicks);
+	printLatency("free ", result.freeTicks);
+	printf("  failed allocations %u  high water mark %.2fMB\n", result.numFailed, (double)result.highWaterMark / (1024.0 * 1024.0));
+}
+
+bool ToolHeapBenchmark(uint32 numOps)
+{
+	uint32 numIds;
+	std::vector<HeapTraceOp> trace = _generateTrace(numOps, numIds);
+	printf("Replaying %u heap operations (%u allocations) on a %uMB heap\n", numOps, numIds, HEAP_BENCHMARK_SIZE / (1024 * 1024));
+	std::vector<uint32> idOffsets(numIds);
+	// TLSF
+	{
+		TLSFHeap heap(HEAP_BENCHMARK_SIZE, HEAP_BENCHMARK_ALIGNMENT);
+		std::vector<TLSFHeap::Block*> blocks(numIds);
+		HeapBenchmarkResult result = _runTrace(trace, numIds,
+			[&](uint32 id, uint32 size, uint32& offsetOut, uint32& sizeOut)
+			{
+				blocks[id] = heap.alloc(size, HEAP_BENCHMARK_ALIGNMENT);
+				if (!blocks[id])
+					return false;
+				offsetOut = blocks[id]->offset;
+				sizeOut = blocks[id]->size;
+				return true;
+			},
+			[&](uint32 id) { heap.free(blocks[id]); });
+		heap.verifyHeap();
+		_printResult("TLSF", result);
+		TLSFHeap::Stats stats;
+		heap.getStats(stats);
+		printf("  final state: %u allocations  %u free blocks  largest free block %.2fMB  fragmentation %.1f%%\n", stats.numAllocations, stats.numFreeBlocks, (double)stats.largestFreeBlock / (1024.0 * 1024.0), stats.GetFragmentation() * 100.0f);
+	}
+	// bucketed free lists
+	{
+		HeapBenchmarkBucketed heap;
+		std::vector<CHAddr> addrs(numIds);
+		HeapBenchmarkResult result = _runTrace(trace, numIds,
+			[&](uint32 id, uint32 size, uint32& offsetOut, uint32& sizeOut)
+			{
+				addrs[id] = heap.alloc(size, HEAP_BENCHMARK_ALIGNMENT);
+				if (!addrs[id].isValid())
+					return false;
+				offsetOut = addrs[id].offset;
+				sizeOut = size;
+				return true;
+			},
+			[&](uint32 id) { heap.free(addrs[id]); });
+		_printResult("Bucketed (previous VHeap)", result);
+	}
+	// first-fit
+	{
+		HeapBenchmarkFirstFit heap;
+		HeapBenchmarkResult result = _runTrace(trace, numIds,
+			[&](uint32 id, uint32 size, uint32& offsetOut, uint32& sizeOut)
+			{
+				if (!heap.Alloc(size, idOffsets[id]))
+					return false;
+				offsetOut = idOffsets[id];
+				sizeOut = size;
+				return true;
+			},
+			[&](uint32 id) { heap.Free(idOffsets[id]); });
+		_printResult("First-fit (previous VirtualBufferHeap)", result);
+	}
+	return true;
+}
@@ -0,0 +1,119 @@
+#include "tools/Tools.h"
+#include "Cemu/FileCache/FileCache.h"
+#include "Cafe/HW/Latte/Core/LatteShaderCache.h"
+#include "Cafe/HW/Latte/Core/LatteShader.h"
+#include "Cafe/HW/Latte/LegacyShaderDecompiler/LatteDecompiler.h"
+#include "Cafe/HW/Latte/Renderer/Null/NullRenderer.h"
+#include "util/highresolutiontimer/HighResolutionTimer.h"
+#include <cinttypes>
+
+// offline benchmark for the shader decompiler
+// decompiles every entry of a transferable shader cache (*_shaders.bin) without compiling it for any graphics API
+
+struct ShaderBenchmarkStats
+{
+	uint32 count{};
+	uint32 errorCount{};
+	uint64 parseCF{};
+	uint64 parseClauses{};
+	uint64 analyze{};
+	uint64 emitGLSL{};
+	std::vector<uint64> totalTicks; // per shader, includes deserialization and post processing
+};
+
+static double _ticksToMicroseconds(uint64 ticks)
+{
+	return (double)ticks * 1000000.0 / (double)HighResolutionTimer::getFrequency();
+}
+
+static void _PrintStats(const char* name, ShaderBenchmarkStats& stats)
+{
+	if (stats.count == 0)
+		return;
+	std::sort(stats.totalTicks.begin(), stats.totalTicks.end());
+	auto percentile = [&](uint32 p) -> double
+	{
+		size_t index = std::min<size_t>((stats.totalTicks.size() * p) / 100, stats.totalTicks.size() - 1);
+		return _ticksToMicroseconds(stats.totalTicks[index]);
+	};
+	uint64 sumTicks = 0;
+	for (uint64 t : stats.totalTicks)
+		sumTicks += t;
+	double n = (double)stats.count;
+	printf("%s: %u shaders (%u with errors)\n", name, stats.count, stats.errorCount);
+	printf("  total   %10.2fms  avg %8.2fus\n", _ticksToMicroseconds(sumTicks) / 1000.0, _ticksToMicroseconds(sumTicks) / n);
+	printf("  CF      %10.2fms  avg %8.2fus\n", _ticksToMicroseconds(stats.parseCF) / 1000.0, _ticksToMicroseconds(stats.parseCF) / n);
+	printf("  clauses %10.2fms  avg %8.2fus\n", _ticksToMicroseconds(stats.parseClauses) / 1000.0, _ticksToMicroseconds(stats.parseClauses) / n);
+	printf("  analyze %10.2fms  avg %8.2fus\n", _ticksToMicroseconds(stats.analyze) / 1000.0, _ticksToMicroseconds(stats.analyze) / n);
+	printf("  emit    %10.2fms  avg %8.2fus\n", _ticksToMicroseconds(stats.emitGLSL) / 1000.0, _ticksToMicroseconds(stats.emitGLSL) / n);
+	printf("  latency p50 %.2fus  p90 %.2fus  p99 %.2fus  max %.2fus\n", percentile(50), percentile(90), percentile(99), _ticksToMicroseconds(stats.totalTicks.back()));
+}
+
+bool ToolShaderCacheBenchmark(const fs::path& cachePath, uint32 numIterations)
+{
+	FileCache* shaderCache = FileCache::Open(cachePath);
+	if (!shaderCache)
+	{
+		printf("Unable to open shader cache \"%s\"\n", _pathToUtf8(cachePath).c_str());
+		return false;
+	}
+	// decompiler options and shader post processing depend on the active renderer
+	if (!g_renderer)
+		g_renderer = std::make_unique<NullRenderer>();
+	// load all entries upfront so file IO is not part of the measurement
+	std::vector<std::vector<uint8>> entries;
+	for (sint32 i = 0; i < shaderCache->GetMaximumFileIndex(); i++)
+	{
+		uint64 name1, name2;
+		std::vector<uint8> fileData;
+		if (shaderCache->GetFileByIndex(i, &name1, &name2, fileData))
+			entries.emplace_back(std::move(fileData));
+	}
+	delete shaderCache;
+	printf("Decompiling %d shaders from \"%s\" (%u iterations)\n", (sint32)entries.size(), _pathToUtf8(cachePath).c_str(), numIterations);
+
+	ShaderBenchmarkStats statsVS, statsGS, statsPS;
+	uint32 numInvalid = 0;
+	for (uint32 iteration = 0; iteration < numIterations; iteration++)
+	{
+		for (auto& entry : entries)
+		{
+			LatteDecompilerOutput_t decompilerOutput{};
+			uint64 shaderBaseHash, shaderAuxHash;
+			HRTick startTick = HighResolutionTimer::now().getTick();
+			LatteDecompilerShader* shader = LatteShaderCache_decompileSeparableShader(entry.data(), (sint32)entry.size(), decompilerOutput, shaderBaseHash, shaderAuxHash);
+			HRTick endTick = HighResolutionTimer::now().getTick();
+			if (!shader)
+			{
+				if (iteration == 0)
+					numInvalid++;
+				continue;
+			}
+			ShaderBenchmarkStats* stats;
+			if (shader->shaderType == LatteConst::ShaderType::Vertex)
+				stats = &statsVS;
+			else if (shader->shaderType == LatteConst::ShaderType::Geometry)
+				stats = &statsGS;
+			else
+				stats = &statsPS;
+			stats->count++;
+			if (shader->hasError)
+				stats->errorCount++;
+			stats->parseCF += decompilerOutput.stageTimings.parseCF;
+			stats->parseClauses += decompilerOutput.stageTimings.parseClauses;
+			stats->analyze += decompilerOutput.stageTimings.analyze;
+			stats->emitGLSL += decompilerOutput.stageTimings.emitGLSL;
+			stats->totalTicks.emplace_back(endTick - startTick);
+			// release through the same path as a shader loaded at runtime
+			LatteSHRC_RegisterShader(shader, shaderBaseHash, shaderAuxHash);
+			LatteShader_CleanupAfterCompile(shader);
+			LatteShader_free(shader);
+		}
+	}
+	if (numInvalid > 0)
+		printf("Skipped %u invalid entries\n", numInvalid);
+	_PrintStats("Vertex", statsVS);
+	_PrintStats("Geometry", statsGS);
+	_PrintStats("Pixel", statsPS);
+	return true;
+}
@@ -0,0 +1,183 @@
+#include "tools/Tools.h"
+#include "Cafe/HW/Latte/Core/LatteTextureLoader.h"
+
+// checks every possible input texel of each g_packedTexelConvTable entry against the per-texel code of the decoders the table replaced
+// the untiling is shared with all other decoders, so only the texel conversion is compared
+
+// previous decoders, reduced to the conversion of a single texel
+static void _refR4G4ToRGBA4Swapped(uint8* blockData, uint8* outputData)
+{
+	uint8 v = (*(uint8*)(blockData + 0));
+	*(uint8*)(outputData + 0) = 0;
+	*(uint8*)(outputData + 1) = ((v >> 4) & 0xF) | ((v << 4) & 0xF0);
+}
+
+static void _refR4G4ToRGBA4(uint8* blockData, uint8* outputData)
+{
+	uint8 v = (*(uint8*)(blockData + 0));
+	*(uint8*)(outputData + 0) = 0;
+	*(uint8*)(outputData + 1) = v;
+}
+
+static void _refR4G4ToRGBA8(uint8* blockData, uint8* outputData)
+{
+	uint8 v0 = (*(uint8*)(blockData + 0));
+	uint8 red4 = (v0 >> 4) & 0xF;
+	uint8 green4 = (v0 & 0xF);
+	red4 = (red4 << 4) | red4;
+	green4 = (green4 << 4) | green4;
+	*(uint8*)(outputData + 0) = red4;
+	*(uint8*)(outputData + 1) = green4;
+	*(uint8*)(outputData + 2) = 0;
+	*(uint8*)(outputData + 3) = 255;
+}
+
+static void _refR4G4B4A4Swapped(uint8* blockData, uint8* outputData)
+{
+	uint8 v0 = (*(uint8*)(blockData + 0));
+	uint8 v1 = (*(uint8*)(blockData + 1));
+	*(uint8*)(outputData + 0) = ((v1 >> 4) & 0xF) | ((v1 << 4) & 0xF0);
+	*(uint8*)(outputData + 1) = ((v0 >> 4) & 0xF) | ((v0 << 4) & 0xF0);
+}
+
+static void _refR4G4B4A4ToRGBA8(uint8* blockData, uint8* outputData)
+{
+	uint8 v0 = (*(uint8*)(blockData + 0));
+	uint8 v1 = (*(uint8*)(blockData + 1));
+	uint8 red4 = (v0 & 0xF);
+	uint8 green4 = (v0 >> 4) & 0xF;
+	uint8 blue4 = (v1) & 0xF;
+	uint8 alpha4 = (v1 >> 4) & 0xF;
+	*(uint8*)(outputData + 0) = (red4 << 4) | red4;
+	*(uint8*)(outputData + 1) = (green4 << 4) | green4;
+	*(uint8*)(outputData + 2) = (blue4 << 4) | blue4;
+	*(uint8*)(outputData + 3) = (alpha4 << 4) | alpha4;
+}
+
+static void _refR5G6B5SwappedRB(uint8* blockData, uint8* outputData)
+{
+	uint16 colorData = (*(uint16*)(blockData + 0));
+	colorData = ((colorData >> 11) & 0x1F) | (colorData & (0x3F << 5)) | ((colorData << 11) & (0x1F << 11));
+	*(uint16*)(outputData + 0) = colorData;
+}
+
+// the previous decoder expanded red and blue with c >> 3 instead of c >> 2, so full intensity came out as 251
+static void _refR5G6B5ToRGBA8(uint8* blockData, uint8* outputData)
+{
+	uint16 v0 = (*(uint16*)(blockData + 0));
+	uint8 c0 = (v0 & 0x1F);
+	uint8 c1 = (v0 >> 5) & 0x3F;
+	uint8 c2 = (v0 >> 11) & 0x1F;
+	c0 = (c0 << 3) | c0 >> 2;
+	c1 = (c1 << 2) | c1 >> 4;
+	c2 = (c2 << 3) | c2 >> 2;
+	*(uint8*)(outputData + 0) = c0;
+	*(uint8*)(outputData + 1) = c1;
+	*(uint8*)(outputData + 2) = c2;
+	*(uint8*)(outputData + 3) = 255;
+}
+
+static void _refR5G5B5A1SwappedRB(uint8* blockData, uint8* outputData)
+{
+	uint16 v = (*(uint16*)(blockData + 0));
+	*(uint16*)(outputData + 0) = ((v >> 10) & (0x1F << 0)) | ((v << 10) & (0x1F << 10)) | (v & ((0x1F << 5) | 0x8000));
+}
+
+static void _refR5G5B5A1SwappedOpenGL(uint8* blockData, uint8* outputData)
+{
+	uint16 v = (*(uint16*)(blockData + 0));
+	uint16 red = (v >> 0) & 0x1F;
+	uint16 green = (v >> 5) & 0x1F;
+	uint16 blue = (v >> 10) & 0x1F;
+	uint16 alpha = (v >> 15) & 0x1;
+	*(uint16*)(outputData + 0) = (red << 11) | (green << 6) | (blue << 1) | alpha;
+}
+
+static void _refR5G5B5A1ToRGBA8(uint8* blockData, uint8* outputData)
+{
+	uint32 colorData = (*(uint16*)(blockData + 0));
+	uint8 red = (colorData >> 0) & 0x1F;
+	uint8 green = (colorData >> 5) & 0x1F;
+	uint8 blue = (colorData >> 10) & 0x1F;
+	uint8 alpha = (colorData >> 15) & 0x1;
+	red = red << 3 | red >> 2;
+	green = green << 3 | green >> 2;
+	blue = blue << 3 | blue >> 2;
+	alpha = alpha * 0xff;
+	colorData = (alpha << 24) | (blue << 16) | (green << 8) | red;
+	*(uint32*)(outputData + 0) = colorData;
+}
+
+static void _refA1B5G5R5ToR5G5B5A1(uint8* blockData, uint8* outputData)
+{
+	uint16 colorData = (*(uint16*)(blockData + 0));
+	uint8 red5 = (colorData >> 11) & 0x1F;
+	uint8 green5 = (colorData >> 6) & 0x1F;
+	uint8 blue5 = (colorData >> 1) & 0x1F;
+	uint8 alpha1 = (colorData >> 0) & 0x1;
+	colorData = blue5 | (green5 << 5) | (red5 << 10) | (alpha1 << 15);
+	*(uint16*)(outputData + 0) = colorData;
+}
+
+static void _refA1B5G5R5ToRGBA8(uint8* blockData, uint8* outputData)
+{
+	uint32 colorData = (*(uint16*)(blockData + 0));
+	uint8 red = (colorData >> 11) & 0x1F;
+	uint8 green = (colorData >> 6) & 0x1F;
+	uint8 blue = (colorData >> 1) & 0x1F;
+	uint8 alpha = (colorData >> 0) & 0x1;
+	red = red << 3 | red >> 2;
+	green = green << 3 | green >> 2;
+	blue = blue << 3 | blue >> 2;
+	alpha = alpha * 0xff;
+	colorData = red | (green << 8) | (blue << 16) | (alpha << 24);
+	*(uint32*)(outputData + 0) = colorData;
+}
+
+template<PackedTexelConv TConv>
+static bool _checkPackedTexelConv(const char* name, void(*refConvert)(uint8* blockData, uint8* outputData))
+{
+	constexpr PackedTexelConvDesc desc = g_packedTexelConvTable[(size_t)TConv];
+	uint32 numInputs = 1u << (desc.srcBytes * 8);
+	uint32 numMismatches = 0;
+	for (uint32 v = 0; v < numInputs; v++)
+	{
+		uint8 input[2];
+		if (desc.srcBytes == 1)
+			*(uint8*)input = (uint8)v;
+		else
+			*(uint16*)input = (uint16)v;
+		uint8 expected[4]{};
+		refConvert(input, expected);
+		auto converted = TextureDecoder_PackedTexel<TConv>::convertTexel(v);
+		uint8 result[4]{};
+		memcpy(result, &converted, sizeof(converted));
+		if (memcmp(expected, result, desc.dstBytes) == 0)
+			continue;
+		if (numMismatches < 4)
+			printf("  %s: input %04x expected %02x%02x%02x%02x got %02x%02x%02x%02x\n", name, v, expected[3], expected[2], expected[1], expected[0], result[3], result[2], result[1], result[0]);
+		numMismatches++;
+	}
+	printf("%-28s %6u inputs  %s\n", name, numInputs, numMismatches == 0 ? "OK" : "MISMATCH");
+	return numMismatches == 0;
+}
+
+bool ToolCheckTextureDecoders()
+{
+	bool success = true;
+	success &= _checkPackedTexelConv<PackedTexelConv::R4_G4_TO_RGBA4_SWAPPED>("R4_G4_TO_RGBA4_SWAPPED", _refR4G4ToRGBA4Swapped);
+	success &= _checkPackedTexelConv<PackedTexelConv::R4_G4_TO_RGBA4>("R4_G4_TO_RGBA4", _refR4G4ToRGBA4);
+	success &= _checkPackedTexelConv<PackedTexelConv::R4_G4_TO_RGBA8>("R4_G4_TO_RGBA8", _refR4G4ToRGBA8);
+	success &= _checkPackedTexelConv<PackedTexelConv::R4_G4_B4_A4_SWAPPED>("R4_G4_B4_A4_SWAPPED", _refR4G4B4A4Swapped);
+	success &= _checkPackedTexelConv<PackedTexelConv::R4_G4_B4_A4_TO_RGBA8>("R4_G4_B4_A4_TO_RGBA8", _refR4G4B4A4ToRGBA8);
+	success &= _checkPackedTexelConv<PackedTexelConv::R5_G6_B5_SWAPPED_RB>("R5_G6_B5_SWAPPED_RB", _refR5G6B5SwappedRB);
+	success &= _checkPackedTexelConv<PackedTexelConv::R5_G6_B5_TO_RGBA8>("R5_G6_B5_TO_RGBA8", _refR5G6B5ToRGBA8);
+	success &= _checkPackedTexelConv<PackedTexelConv::R5_G5_B5_A1_SWAPPED_RB>("R5_G5_B5_A1_SWAPPED_RB", _refR5G5B5A1SwappedRB);
+	success &= _checkPackedTexelConv<PackedTexelConv::R5_G5_B5_A1_SWAPPED_OPENGL>("R5_G5_B5_A1_SWAPPED_OPENGL", _refR5G5B5A1SwappedOpenGL);
+	success &= _checkPackedTexelConv<PackedTexelConv::R5_G5_B5_A1_TO_RGBA8>("R5_G5_B5_A1_TO_RGBA8", _refR5G5B5A1ToRGBA8);
+	success &= _checkPackedTexelConv<PackedTexelConv::A1_B5_G5_R5_TO_R5_G5_B5_A1>("A1_B5_G5_R5_TO_R5_G5_B5_A1", _refA1B5G5R5ToR5G5B5A1);
+	success &= _checkPackedTexelConv<PackedTexelConv::A1_B5_G5_R5_TO_RGBA8>("A1_B5_G5_R5_TO_RGBA8", _refA1B5G5R5ToRGBA8);
+	static_assert((size_t)PackedTexelConv::COUNT == 12, "add a reference conversion for new table entries");
+	printf(success ? "All packed texel conversions match\n" : "Packed texel conversions differ from the reference\n");
+	return success;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+// standalone command line tools, these run instead of the emulator and print their results to the console
+
+bool ToolShaderCacheBenchmark(const fs::path& cachePath, uint32 numIterations);
+bool ToolFiberBenchmark(uint32 numRoundTrips);
+bool ToolHeapBenchmark(uint32 numOps);
+bool ToolCheckTextureDecoders();
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <util/helpers/MemoryPool.h>
+#include "util/TLSFHeap/TLSFHeap.h"
+#include "util/containers/robin_hood.h"
 
 struct CHAddr
 {
@@ -315,48 +317,17 @@ public:
 	virtual void free(void* addr) = 0;
 };
 
+// address based wrapper around TLSFHeap
 class VHeap : public VGenericHeap
 {
-	struct allocRange_t
-	{
-		allocRange_t* nextFree{};
-		allocRange_t* prevFree{};
-		allocRange_t* prevOrdered{};
-		allocRange_t* nextOrdered{};
-		uint32 offset;
-		uint32 size;
-		bool isFree;
-		allocRange_t(uint32 _offset, uint32 _size, bool _isFree) : offset(_offset), size(_size), isFree(_isFree), nextFree(nullptr) {};
-	};
-
-	struct chunk_t
-	{
-		std::unordered_map<uint32, allocRange_t*> map_allocatedRange;
-	};
-
 public:
-	VHeap(void* heapBase, uint32 heapSize) : m_heapBase((uint8*)heapBase), m_heapSize(heapSize)
+	VHeap(void* heapBase, uint32 heapSize) : m_heapBase((uint8*)heapBase), m_heap(heapSize, 4)
 	{
-		allocRange_t* range = new allocRange_t(0, heapSize, true);
-		trackFreeRange(range);
-	}
-
-	~VHeap()
-	{
-		for (auto freeRange : bucketFreeRange)
-		{
-			while (freeRange)
-			{
-				auto temp = freeRange;
-				freeRange = freeRange->nextFree;
-				delete temp;
-			}
-		}
 	}
 
 	void setHeapBase(void* heapBase)
 	{
-		cemu_assert_debug(map_allocatedRange.empty()); // heap base can only be changed when there are no active allocations
+		cemu_assert_debug(!m_heap.hasAllocations()); // heap base can only be changed when there are no active allocations
 		m_heapBase = (uint8*)heapBase;
 	}
 
@@ -393,108 +364,30 @@ public:
 	uint32 getAllocationSizeFromAddr(void* addr)
 	{
 		uint32 addrOffset = (uint32)((uint8*)addr - m_heapBase);
-		auto it = map_allocatedRange.find(addrOffset);
-		if (it == map_allocatedRange.end())
+		auto it = m_allocatedBlocks.find(addrOffset);
+		if (it == m_allocatedBlocks.end())
 			assert_dbg();
 		return it->second->size;
 	}
 
 	bool hasAllocations()
 	{
-		return !map_allocatedRange.empty();
+		return m_heap.hasAllocations();
 	}
 
 	void getStats(uint32& heapSize, uint32& allocationSize, uint32& allocNum)
 	{
-		heapSize = m_heapSize;
-		allocationSize = m_statsMemAllocated;
-		allocNum = (uint32)map_allocatedRange.size();
-	}
-
-private:
-	unsigned ulog2(uint32 v)
-	{
-		static const unsigned MUL_DE_BRUIJN_BIT[] =
-		{
-		   0,  9,  1, 10, 13, 21,  2, 29, 11, 14, 16, 18, 22, 25,  3, 30,
-		   8, 12, 20, 28, 15, 17, 24,  7, 19, 27, 23,  6, 26,  5,  4, 31
-		};
-
-		v |= v >> 1;
-		v |= v >> 2;
-		v |= v >> 4;
-		v |= v >> 8;
-		v |= v >> 16;
-
-		return MUL_DE_BRUIJN_BIT[(v * 0x07C4ACDDu) >> 27];
-	}
-
-	void trackFreeRange(allocRange_t* range)
-	{
-		// get index of msb
-		if (range->size == 0)
-			assert_dbg(); // not allowed
-		uint32 bucketIndex = ulog2(range->size);
-		range->nextFree = bucketFreeRange[bucketIndex];
-		if (bucketFreeRange[bucketIndex])
-			bucketFreeRange[bucketIndex]->prevFree = range;
-		range->prevFree = nullptr;
-		bucketFreeRange[bucketIndex] = range;
-	}
-
-	void forgetFreeRange(allocRange_t* range, uint32 bucketIndex)
-	{
-		allocRange_t* prevRange = range->prevFree;
-		allocRange_t* nextRange = range->nextFree;
-		if (prevRange)
-		{
-			prevRange->nextFree = nextRange;
-			if (nextRange)
-				nextRange->prevFree = prevRange;
-		}
-		else
-		{
-			if (bucketFreeRange[bucketIndex] != range)
-				assert_dbg();
-			bucketFreeRange[bucketIndex] = nextRange;
-			if (nextRange)
-				nextRange->prevFree = nullptr;
-		}
+		heapSize = m_heap.getHeapSize();
+		allocationSize = m_heap.getAllocatedBytes();
+		allocNum = m_heap.getNumAllocations();
 	}
 
-	void _allocFrom(allocRange_t* range, uint32 bucketIndex, uint32 allocOffset, uint32 allocSize)
+	void getStats(TLSFHeap::Stats& statsOut)
 	{
-		// remove the range from the chain of free ranges
-		forgetFreeRange(range, bucketIndex);
-		// split head, allocation and tail into separate ranges
-		if (allocOffset > range->offset)
-		{
-			// alignment padding -> create free range
-			allocRange_t* head = new allocRange_t(range->offset, allocOffset - range->offset, true);
-			trackFreeRange(head);
-			if (range->prevOrdered)
-				range->prevOrdered->nextOrdered = head;
-			head->prevOrdered = range->prevOrdered;
-			head->nextOrdered = range;
-			range->prevOrdered = head;
-		}
-		if ((allocOffset + allocSize) < (range->offset + range->size)) // todo - create only if it's more than a couple of bytes?
-		{
-			// tail -> create free range
-			allocRange_t* tail = new allocRange_t((allocOffset + allocSize), (range->offset + range->size) - (allocOffset + allocSize), true);
-			trackFreeRange(tail);
-			if (range->nextOrdered)
-				range->nextOrdered->prevOrdered = tail;
-			tail->prevOrdered = range;
-			tail->nextOrdered = range->nextOrdered;
-			range->nextOrdered = tail;
-		}
-		range->offset = allocOffset;
-		range->size = allocSize;
-		range->isFree = false;
-		m_statsMemAllocated += allocSize;
+		m_heap.getStats(statsOut);
 	}
 
+private:
 	bool _alloc(uint32 size, uint32 alignment, uint32& allocOffsetOut)
 	{
 		if(size == 0)
@@ -502,101 +395,31 @@ private:
 			size = 1; // zero-sized allocations are not supported
 			cemu_assert_suspicious();
 		}
-		// find smallest bucket to scan
-		uint32 alignmentM1 = alignment - 1;
-		uint32 bucketIndex = ulog2(size);
-		while (bucketIndex < 32)
-		{
-			allocRange_t* range = bucketFreeRange[bucketIndex];
-			while (range)
-			{
-				if (range->size >= size)
-				{
-					// verify if aligned allocation fits
-					uint32 alignedOffset = (range->offset + alignmentM1) & ~alignmentM1;
-					uint32 alignmentLoss = alignedOffset - range->offset;
-					if (alignmentLoss < range->size && (range->size - alignmentLoss) >= size)
-					{
-						_allocFrom(range, bucketIndex, alignedOffset, size);
-						map_allocatedRange.emplace(alignedOffset, range);
-						allocOffsetOut = alignedOffset;
-						return true;
-					}
-				}
-				range = range->nextFree;
-			}
-			bucketIndex++; // try higher bucket
-		}
-		return false;
+		TLSFHeap::Block* block = m_heap.alloc(size, alignment);
+		if (!block)
+			return false;
+		m_allocatedBlocks.emplace(block->offset, block);
+		allocOffsetOut = block->offset;
+		return true;
 	}
 
 	void _free(uint32 addrOffset)
 	{
-		auto it = map_allocatedRange.find(addrOffset);
-		if (it == map_allocatedRange.end())
+		auto it = m_allocatedBlocks.find(addrOffset);
+		if (it == m_allocatedBlocks.end())
 		{
 			cemuLog_log(LogType::Force, "VHeap internal error");
 			cemu_assert(false);
 		}
-		allocRange_t* range = it->second;
-		map_allocatedRange.erase(it);
-		m_statsMemAllocated -= range->size;
-		// try merge left or right
-		allocRange_t* prevRange = range->prevOrdered;
-		allocRange_t* nextRange = range->nextOrdered;
-		if (prevRange && prevRange->isFree)
-		{
-			if (nextRange && nextRange->isFree)
-			{
-				forgetFreeRange(nextRange, ulog2(nextRange->size));
-				uint32 newSize = (nextRange->offset + nextRange->size) - prevRange->offset;
-				prevRange->nextOrdered = nextRange->nextOrdered;
-				if (nextRange->nextOrdered)
-					nextRange->nextOrdered->prevOrdered = prevRange;
-				forgetFreeRange(prevRange, ulog2(prevRange->size));
-				prevRange->size = newSize;
-				trackFreeRange(prevRange);
-				delete range;
-				delete nextRange;
-			}
-			else
-			{
-				uint32 newSize = (range->offset + range->size) - prevRange->offset;
-				prevRange->nextOrdered = nextRange;
-				if (nextRange)
-					nextRange->prevOrdered = prevRange;
-				forgetFreeRange(prevRange, ulog2(prevRange->size));
-				prevRange->size = newSize;
-				trackFreeRange(prevRange);
-				delete range;
-			}
-		}
-		else if (nextRange && nextRange->isFree)
-		{
-			uint32 newOffset = range->offset;
-			uint32 newSize = (nextRange->offset + nextRange->size) - newOffset;
-			forgetFreeRange(nextRange, ulog2(nextRange->size));
-			nextRange->offset = newOffset;
-			nextRange->size = newSize;
-			if (range->prevOrdered)
-				range->prevOrdered->nextOrdered = nextRange;
-			nextRange->prevOrdered = range->prevOrdered;
-			trackFreeRange(nextRange);
-			delete range;
-		}
-		else
-		{
-			range->isFree = true;
-			trackFreeRange(range);
-		}
+		TLSFHeap::Block* block = it->second;
+		m_allocatedBlocks.erase(it);
+		m_heap.free(block);
 	}
 
 private:
-	allocRange_t* bucketFreeRange[32]{};
-	std::unordered_map<uint32, allocRange_t*> map_allocatedRange;
 	uint8* m_heapBase;
-	const uint32 m_heapSize;
-	uint32 m_statsMemAllocated{ 0 };
+	TLSFHeap m_heap;
+	robin_hood::unordered_flat_map<uint32, TLSFHeap::Block*> m_allocatedBlocks; // the API is address based, block headers are looked up by offset
 };
 
 template<uint32 TChunkSize>
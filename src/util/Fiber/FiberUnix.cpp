@@ -1,42 +1,219 @@
 #include "Fiber.h"
-#include <ucontext.h>
 #include <atomic>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(ARCH_X86_64) || defined(__x86_64__) || defined(__aarch64__) || defined(__arm64__)
+#define FIBER_USE_ASM_SWITCH
+#else
+#include <ucontext.h>
+#endif
 
 thread_local Fiber* sCurrentFiber{};
 
+constexpr size_t FIBER_STACK_SIZE = 2 * 1024 * 1024;
+
+#ifdef FIBER_USE_ASM_SWITCH
+// swapcontext() saves and restores the signal mask which costs a syscall on every switch
+// fibers only ever switch at a function call, so it is enough to save the callee-saved registers and the floating point control state on the stack
+
+// saves the current context on the stack, stores the stack pointer in *saveSp and resumes the context stored at loadSp
+extern "C" void cemu_fiber_switch(void** saveSp, void* loadSp);
+// first code executed by a new fiber. Entry point and parameter are passed in callee-saved registers
+extern "C" void cemu_fiber_start();
+
+#if BOOST_OS_MACOS
+#define FIBER_ASM_FUNC_BEGIN(name) ".text\n.globl _" #name "\n.p2align 4\n_" #name ":\n"
+#define FIBER_ASM_FUNC_END(name) ""
+#else
+#define FIBER_ASM_FUNC_BEGIN(name) ".text\n.globl " #name "\n.type " #name ", %function\n.p2align 4\n" #name ":\n"
+#define FIBER_ASM_FUNC_END(name) ".size " #name ", .-" #name "\n"
+#endif
+
+#if defined(__aarch64__) || defined(__arm64__)
+// frame layout: x19-x28, x29 (fp), x30 (lr), d8-d15, fpcr
+constexpr size_t FIBER_FRAME_SIZE = 176;
+constexpr size_t FIBER_FRAME_X19 = 0;
+constexpr size_t FIBER_FRAME_X20 = 8;
+constexpr size_t FIBER_FRAME_X29 = 80;
+constexpr size_t FIBER_FRAME_X30 = 88;
+constexpr size_t FIBER_FRAME_FPCR = 160;
+
+asm(
+	FIBER_ASM_FUNC_BEGIN(cemu_fiber_switch)
+	"sub sp, sp, #176\n"
+	"stp x19, x20, [sp, #0]\n"
+	"stp x21, x22, [sp, #16]\n"
+	"stp x23, x24, [sp, #32]\n"
+	"stp x25, x26, [sp, #48]\n"
+	"stp x27, x28, [sp, #64]\n"
+	"stp x29, x30, [sp, #80]\n"
+	"stp d8, d9, [sp, #96]\n"
+	"stp d10, d11, [sp, #112]\n"
+	"stp d12, d13, [sp, #128]\n"
+	"stp d14, d15, [sp, #144]\n"
+	"mrs x9, fpcr\n"
+	"str x9, [sp, #160]\n"
+	"mov x9, sp\n"
+	"str x9, [x0]\n"
+	"mov sp, x1\n"
+	"ldr x9, [sp, #160]\n"
+	"msr fpcr, x9\n"
+	"ldp x19, x20, [sp, #0]\n"
+	"ldp x21, x22, [sp, #16]\n"
+	"ldp x23, x24, [sp, #32]\n"
+	"ldp x25, x26, [sp, #48]\n"
+	"ldp x27, x28, [sp, #64]\n"
+	"ldp x29, x30, [sp, #80]\n"
+	"ldp d8, d9, [sp, #96]\n"
+	"ldp d10, d11, [sp, #112]\n"
+	"ldp d12, d13, [sp, #128]\n"
+	"ldp d14, d15, [sp, #144]\n"
+	"add sp, sp, #176\n"
+	"ret\n"
+	FIBER_ASM_FUNC_END(cemu_fiber_switch)
+	FIBER_ASM_FUNC_BEGIN(cemu_fiber_start)
+	"mov x0, x20\n"
+	"blr x19\n"
+	"brk #0\n" // fiber entry points never return
+	FIBER_ASM_FUNC_END(cemu_fiber_start)
+);
+
+static void* _initFiberStack(uint8* stackTop, void(*entryPoint)(void*), void* userParam)
+{
+	uint8* frame = stackTop - FIBER_FRAME_SIZE;
+	memset(frame, 0, FIBER_FRAME_SIZE);
+	uint64 fpcr;
+	asm volatile("mrs %0, fpcr" : "=r"(fpcr));
+	*(uint64*)(frame + FIBER_FRAME_X19) = (uint64)entryPoint;
+	*(uint64*)(frame + FIBER_FRAME_X20) = (uint64)userParam;
+	*(uint64*)(frame + FIBER_FRAME_X29) = 0;
+	*(uint64*)(frame + FIBER_FRAME_X30) = (uint64)&cemu_fiber_start;
+	*(uint64*)(frame + FIBER_FRAME_FPCR) = fpcr;
+	return frame;
+}
+#else
+// frame layout: mxcsr, x87 control word, r15, r14, r13, r12, rbx, rbp, return address
+constexpr size_t FIBER_FRAME_SIZE = 64;
+constexpr size_t FIBER_FRAME_MXCSR = 0;
+constexpr size_t FIBER_FRAME_X87CW = 4;
+constexpr size_t FIBER_FRAME_R13 = 24;
+constexpr size_t FIBER_FRAME_R12 = 32;
+constexpr size_t FIBER_FRAME_RET = 56;
+
+asm(
+	FIBER_ASM_FUNC_BEGIN(cemu_fiber_switch)
+	"pushq %rbp\n"
+	"pushq %rbx\n"
+	"pushq %r12\n"
+	"pushq %r13\n"
+	"pushq %r14\n"
+	"pushq %r15\n"
+	"subq $8, %rsp\n"
+	"stmxcsr (%rsp)\n"
+	"fnstcw 4(%rsp)\n"
+	"movq %rsp, (%rdi)\n"
+	"movq %rsi, %rsp\n"
+	"ldmxcsr (%rsp)\n"
+	"fldcw 4(%rsp)\n"
+	"addq $8, %rsp\n"
+	"popq %r15\n"
+	"popq %r14\n"
+	"popq %r13\n"
+	"popq %r12\n"
+	"popq %rbx\n"
+	"popq %rbp\n"
+	"ret\n"
+	FIBER_ASM_FUNC_END(cemu_fiber_switch)
+	FIBER_ASM_FUNC_BEGIN(cemu_fiber_start)
+	"movq %r13, %rdi\n"
+	"callq *%r12\n"
+	"ud2\n" // fiber entry points never return
+	FIBER_ASM_FUNC_END(cemu_fiber_start)
+);
+
+static void* _initFiberStack(uint8* stackTop, void(*entryPoint)(void*), void* userParam)
+{
+	// after the final ret of cemu_fiber_switch the stack pointer equals stackTop (16 byte aligned), as expected before a call
+	uint8* frame = stackTop - FIBER_FRAME_SIZE;
+	memset(frame, 0, FIBER_FRAME_SIZE);
+	uint32 mxcsr;
+	uint16 x87cw;
+	asm volatile("stmxcsr %0" : "=m"(mxcsr));
+	asm volatile("fnstcw %0" : "=m"(x87cw));
+	*(uint32*)(frame + FIBER_FRAME_MXCSR) = mxcsr;
+	*(uint16*)(frame + FIBER_FRAME_X87CW) = x87cw;
+	*(uint64*)(frame + FIBER_FRAME_R13) = (uint64)userParam;
+	*(uint64*)(frame + FIBER_FRAME_R12) = (uint64)entryPoint;
+	*(uint64*)(frame + FIBER_FRAME_RET) = (uint64)&cemu_fiber_start;
+	return frame;
+}
+#endif
+#endif
+
+// reserves the stack with a guard page at the bottom. Physical memory is only committed once a page is touched
+static uint8* _allocateFiberStack(size_t stackSize)
+{
+	const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+	int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+#ifdef MAP_STACK
+	flags |= MAP_STACK;
+#endif
+	void* mem = mmap(nullptr, stackSize + pageSize, PROT_READ | PROT_WRITE, flags, -1, 0);
+	if (mem == MAP_FAILED)
+	{
+		cemuLog_log(LogType::Force, "Failed to allocate fiber stack");
+		cemu_assert(false);
+	}
+	mprotect(mem, pageSize, PROT_NONE);
+	return (uint8*)mem;
+}
+
+static void _freeFiberStack(void* stack, size_t stackSize)
+{
+	munmap(stack, stackSize + (size_t)sysconf(_SC_PAGESIZE));
+}
+
 Fiber::Fiber(void(*FiberEntryPoint)(void* userParam), void* userParam, void* privateData) : m_privateData(privateData)
 {
+	const size_t stackSize = FIBER_STACK_SIZE;
+	uint8* stackBase = _allocateFiberStack(stackSize);
+	m_stackPtr = stackBase;
+	uint8* stackTop = stackBase + (size_t)sysconf(_SC_PAGESIZE) + stackSize;
+#ifdef FIBER_USE_ASM_SWITCH
+	// m_implData holds the saved stack pointer of the suspended fiber
+	this->m_implData = _initFiberStack(stackTop, FiberEntryPoint, userParam);
+#else
 	ucontext_t* ctx = (ucontext_t*)malloc(sizeof(ucontext_t));
-	
-	const size_t stackSize = 2 * 1024 * 1024;
-	m_stackPtr = malloc(stackSize);
 
 	getcontext(ctx);
-	ctx->uc_stack.ss_sp = m_stackPtr;
+	ctx->uc_stack.ss_sp = stackTop - stackSize;
 	ctx->uc_stack.ss_size = stackSize;
 	ctx->uc_link = &ctx[0];
-#ifdef __arm64__
-	// https://www.man7.org/linux/man-pages/man3/makecontext.3.html#NOTES
-	makecontext(ctx, (void(*)())FiberEntryPoint, 2, (uint64) userParam >> 32, userParam);
-#else
 	makecontext(ctx, (void(*)())FiberEntryPoint, 1, userParam);
-#endif
 	this->m_implData = (void*)ctx;
+#endif
 }
 
 Fiber::Fiber(void* privateData) : m_privateData(privateData)
 {
+#ifdef FIBER_USE_ASM_SWITCH
+	this->m_implData = nullptr; // set when switching away from this fiber
+#else
 	ucontext_t* ctx = (ucontext_t*)malloc(sizeof(ucontext_t));
 	getcontext(ctx);
 	this->m_implData = (void*)ctx;
+#endif
 	m_stackPtr = nullptr;
 }
 
 Fiber::~Fiber()
 {
 	if(m_stackPtr)
-		free(m_stackPtr);
+		_freeFiberStack(m_stackPtr, FIBER_STACK_SIZE);
+#ifndef FIBER_USE_ASM_SWITCH
 	free(m_implData);
+#endif
 }
 
 Fiber* Fiber::PrepareCurrentThread(void* privateData)
@@ -51,7 +228,11 @@ void Fiber::Switch(Fiber& targetFiber)
     Fiber* leavingFiber = sCurrentFiber;
     sCurrentFiber = &targetFiber;
 	std::atomic_thread_fence(std::memory_order_seq_cst);
+#ifdef FIBER_USE_ASM_SWITCH
+	cemu_fiber_switch(&leavingFiber->m_implData, targetFiber.m_implData);
+#else
 	swapcontext((ucontext_t*)(leavingFiber->m_implData), (ucontext_t*)(targetFiber.m_implData));
+#endif
 	std::atomic_thread_fence(std::memory_order_seq_cst);
 }
 
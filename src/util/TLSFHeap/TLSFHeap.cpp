@@ -0,0 +1,290 @@
+#include "TLSFHeap.h"
+
+TLSFHeap::TLSFHeap(uint32 heapSize, uint32 granularity) : m_granularity(granularity), m_heapSize(heapSize & ~(granularity - 1))
+{
+	cemu_assert_debug(std::has_single_bit(granularity));
+	cemu_assert_debug(m_heapSize != 0);
+	m_firstBlock = m_blockPool.allocObj(0, m_heapSize, true);
+	trackFreeBlock(m_firstBlock);
+}
+
+TLSFHeap::~TLSFHeap()
+{
+	Block* block = m_firstBlock;
+	while (block)
+	{
+		Block* nextBlock = block->nextPhys;
+		m_blockPool.freeObj(block);
+		block = nextBlock;
+	}
+}
+
+void TLSFHeap::mapSize(uint32 size, uint32& fl, uint32& sl)
+{
+	if (size < TLSF_SL_COUNT)
+	{
+		fl = 0;
+		sl = size;
+		return;
+	}
+	uint32 msb = 31 - std::countl_zero(size);
+	fl = msb - (TLSF_SL_BITS - 1);
+	sl = (size >> (msb - TLSF_SL_BITS)) & (TLSF_SL_COUNT - 1);
+}
+
+void TLSFHeap::trackFreeBlock(Block* block)
+{
+	uint32 fl, sl;
+	mapSize(block->size, fl, sl);
+	Block*& listHead = m_freeLists[fl][sl];
+	block->isFree = true;
+	block->prevFree = nullptr;
+	block->nextFree = listHead;
+	if (listHead)
+		listHead->prevFree = block;
+	listHead = block;
+	m_slBitmap[fl] |= (1u << sl);
+	m_flBitmap |= (1u << fl);
+	m_numFreeBlocks++;
+}
+
+void TLSFHeap::forgetFreeBlock(Block* block)
+{
+	cemu_assert_debug(block->isFree);
+	if (block->nextFree)
+		block->nextFree->prevFree = block->prevFree;
+	if (block->prevFree)
+		block->prevFree->nextFree = block->nextFree;
+	else
+	{
+		uint32 fl, sl;
+		mapSize(block->size, fl, sl);
+		cemu_assert_debug(m_freeLists[fl][sl] == block);
+		m_freeLists[fl][sl] = block->nextFree;
+		if (!block->nextFree)
+		{
+			m_slBitmap[fl] &= ~(1u << sl);
+			if (m_slBitmap[fl] == 0)
+				m_flBitmap &= ~(1u << fl);
+		}
+	}
+	block->prevFree = nullptr;
+	block->nextFree = nullptr;
+	block->isFree = false;
+	m_numFreeBlocks--;
+}
+
+// rounds size up to the next size class boundary, so that every block in the size class of the result is at least size bytes large
+uint64 TLSFHeap::roundUpToSizeClass(uint64 size)
+{
+	if (size < TLSF_SL_COUNT)
+		return size;
+	uint32 msb = 63 - std::countl_zero(size);
+	return size + (1ull << (msb - TLSF_SL_BITS)) - 1;
+}
+
+// returns the head of the first non-empty size class in which every block is at least size bytes large
+TLSFHeap::Block* TLSFHeap::findFreeBlock(uint32 size)
+{
+	uint64 searchSize = roundUpToSizeClass(size);
+	if (searchSize > 0xFFFFFFFFull)
+		return nullptr;
+	uint32 fl, sl;
+	mapSize((uint32)searchSize, fl, sl);
+	uint32 slMap = m_slBitmap[fl] & (~0u << sl);
+	if (slMap == 0)
+	{
+		uint32 flMap = m_flBitmap & (~0u << (fl + 1));
+		if (flMap == 0)
+			return nullptr;
+		fl = std::countr_zero(flMap);
+		slMap = m_slBitmap[fl];
+	}
+	sl = std::countr_zero(slMap);
+	return m_freeLists[fl][sl];
+}
+
+// the rounding in findFreeBlock() skips blocks which are large enough for the allocation but not for the worst case alignment padding
+// only used once the heap is close to full, scans every size class from the one of the unpadded size up to the one findFreeBlock() started at
+TLSFHeap::Block* TLSFHeap::findFreeBlockSlow(uint32 size, uint32 alignment, uint64 paddedSize)
+{
+	uint32 fl, sl;
+	mapSize(size, fl, sl);
+	uint32 lastFl = TLSF_FL_COUNT - 1, lastSl = TLSF_SL_COUNT - 1;
+	uint64 searchSize = roundUpToSizeClass(paddedSize);
+	if (searchSize <= 0xFFFFFFFFull)
+		mapSize((uint32)searchSize, lastFl, lastSl);
+	while (true)
+	{
+		uint32 slMap = m_slBitmap[fl] & (~0u << sl);
+		if (slMap == 0)
+		{
+			if (fl >= lastFl)
+				return nullptr;
+			uint32 flMap = m_flBitmap & (~0u << (fl + 1));
+			if (flMap == 0)
+				return nullptr;
+			fl = std::countr_zero(flMap);
+			slMap = m_slBitmap[fl];
+		}
+		sl = std::countr_zero(slMap);
+		if (fl > lastFl || (fl == lastFl && sl > lastSl))
+			return nullptr;
+		for (Block* block = m_freeLists[fl][sl]; block; block = block->nextFree)
+		{
+			uint32 alignedOffset = (block->offset + alignment - 1) & ~(alignment - 1);
+			if (alignedOffset - block->offset < block->size && block->size - (alignedOffset - block->offset) >= size)
+				return block;
+		}
+		if (fl == lastFl && sl == lastSl)
+			return nullptr;
+		sl++;
+		if (sl == TLSF_SL_COUNT)
+		{
+			fl++;
+			sl = 0;
+		}
+	}
+}
+
+// splits off the first headSize bytes of an unlinked block as a new free block
+TLSFHeap::Block* TLSFHeap::splitHead(Block* block, uint32 headSize)
+{
+	Block* head = m_blockPool.allocObj(block->offset, headSize, true);
+	head->prevPhys = block->prevPhys;
+	head->nextPhys = block;
+	if (block->prevPhys)
+		block->prevPhys->nextPhys = head;
+	else
+		m_firstBlock = head;
+	block->prevPhys = head;
+	block->offset += headSize;
+	block->size -= headSize;
+	trackFreeBlock(head);
+	return head;
+}
+
+// shrinks an unlinked block to size bytes, the remainder becomes a new free block
+void TLSFHeap::splitTail(Block* block, uint32 size)
+{
+	Block* tail = m_blockPool.allocObj(block->offset + size, block->size - size, true);
+	tail->prevPhys = block;
+	tail->nextPhys = block->nextPhys;
+	if (block->nextPhys)
+		block->nextPhys->prevPhys = tail;
+	block->nextPhys = tail;
+	block->size = size;
+	trackFreeBlock(tail);
+}
+
+TLSFHeap::Block* TLSFHeap::alloc(uint32 size, uint32 alignment)
+{
+	cemu_assert_debug(std::has_single_bit(alignment));
+	if (size == 0) [[unlikely]]
+		size = m_granularity;
+	if (size > m_heapSize)
+		return nullptr;
+	size = (size + (m_granularity - 1)) & ~(m_granularity - 1);
+	alignment = std::max(alignment, m_granularity);
+	// every block offset is a multiple of the granularity, so larger alignments need at most alignment-granularity bytes of padding
+	uint64 paddedSize = (uint64)size + (alignment - m_granularity);
+	Block* block = nullptr;
+	if (paddedSize <= m_heapSize)
+		block = findFreeBlock((uint32)paddedSize);
+	if (!block)
+	{
+		block = findFreeBlockSlow(size, alignment, paddedSize);
+		if (!block)
+			return nullptr;
+	}
+	forgetFreeBlock(block);
+	uint32 alignedOffset = (block->offset + alignment - 1) & ~(alignment - 1);
+	if (alignedOffset != block->offset)
+		splitHead(block, alignedOffset - block->offset);
+	if (block->size > size)
+		splitTail(block, size);
+	m_allocatedBytes += block->size;
+	m_numAllocations++;
+	return block;
+}
+
+void TLSFHeap::free(Block* block)
+{
+	cemu_assert_debug(!block->isFree);
+	m_allocatedBytes -= block->size;
+	m_numAllocations--;
+	// free neighbours are merged immediately, so there are never two adjacent free blocks
+	Block* prevBlock = block->prevPhys;
+	if (prevBlock && prevBlock->isFree)
+	{
+		forgetFreeBlock(prevBlock);
+		prevBlock->size += block->size;
+		prevBlock->nextPhys = block->nextPhys;
+		if (block->nextPhys)
+			block->nextPhys->prevPhys = prevBlock;
+		m_blockPool.freeObj(block);
+		block = prevBlock;
+	}
+	Block* nextBlock = block->nextPhys;
+	if (nextBlock && nextBlock->isFree)
+	{
+		forgetFreeBlock(nextBlock);
+		block->size += nextBlock->size;
+		block->nextPhys = nextBlock->nextPhys;
+		if (nextBlock->nextPhys)
+			nextBlock->nextPhys->prevPhys = block;
+		m_blockPool.freeObj(nextBlock);
+	}
+	trackFreeBlock(block);
+}
+
+void TLSFHeap::getStats(Stats& statsOut) const
+{
+	statsOut.heapSize = m_heapSize;
+	statsOut.allocatedBytes = m_allocatedBytes;
+	statsOut.numAllocations = m_numAllocations;
+	statsOut.freeBytes = m_heapSize - m_allocatedBytes;
+	statsOut.numFreeBlocks = m_numFreeBlocks;
+	statsOut.largestFreeBlock = 0;
+	if (m_flBitmap == 0)
+		return;
+	// the largest free block is in the highest non-empty size class
+	uint32 fl = 31 - std::countl_zero(m_flBitmap);
+	uint32 sl = 31 - std::countl_zero(m_slBitmap[fl]);
+	for (Block* block = m_freeLists[fl][sl]; block; block = block->nextFree)
+		statsOut.largestFreeBlock = std::max(statsOut.largestFreeBlock, block->size);
+}
+
+void TLSFHeap::verifyHeap() const
+{
+	uint32 expectedOffset = 0;
+	uint32 allocatedBytes = 0;
+	uint32 numAllocations = 0;
+	uint32 numFreeBlocks = 0;
+	const Block* prevBlock = nullptr;
+	for (const Block* block = m_firstBlock; block; block = block->nextPhys)
+	{
+		cemu_assert(block->prevPhys == prevBlock);
+		cemu_assert(block->offset == expectedOffset);
+		cemu_assert(block->size != 0 && (block->size % m_granularity) == 0);
+		if (block->isFree)
+		{
+			cemu_assert(!prevBlock || !prevBlock->isFree); // adjacent free blocks should have been merged
+			uint32 fl, sl;
+			mapSize(block->size, fl, sl);
+			cemu_assert((m_slBitmap[fl] & (1u << sl)) != 0);
+			numFreeBlocks++;
+		}
+		else
+		{
+			allocatedBytes += block->size;
+			numAllocations++;
+		}
+		expectedOffset += block->size;
+		prevBlock = block;
+	}
+	cemu_assert(expectedOffset == m_heapSize);
+	cemu_assert(allocatedBytes == m_allocatedBytes);
+	cemu_assert(numAllocations == m_numAllocations);
+	cemu_assert(numFreeBlocks == m_numFreeBlocks);
+}
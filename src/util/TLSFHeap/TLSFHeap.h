@@ -0,0 +1,88 @@
+#pragma once
+
+#include "util/helpers/MemoryPool.h"
+
+// two-level segregated fit allocator for a range of offsets
+// the first level splits free blocks by the power of two of their size, the second level divides every power of two range into TLSF_SL_COUNT linear size classes
+// a bitmap for each level allows finding a free block of sufficient size with two bit scans, so alloc and free run in constant time
+// block headers are kept outside of the managed range. This allows using the heap for GPU memory or guest memory which the host should not write to
+
+class TLSFHeap
+{
+	static constexpr uint32 TLSF_SL_BITS = 4;
+	static constexpr uint32 TLSF_SL_COUNT = 1 << TLSF_SL_BITS;
+	static constexpr uint32 TLSF_FL_COUNT = 32 - TLSF_SL_BITS + 1; // first level 0 holds all blocks smaller than TLSF_SL_COUNT
+
+public:
+	struct Block
+	{
+		Block* prevPhys{}; // neighbour blocks in address order
+		Block* nextPhys{};
+		Block* prevFree{}; // free list of the size class
+		Block* nextFree{};
+		uint32 offset;
+		uint32 size;
+		bool isFree;
+		Block(uint32 _offset, uint32 _size, bool _isFree) : offset(_offset), size(_size), isFree(_isFree) {};
+	};
+
+	struct Stats
+	{
+		uint32 heapSize;
+		uint32 allocatedBytes;
+		uint32 numAllocations;
+		uint32 freeBytes;
+		uint32 numFreeBlocks;
+		uint32 largestFreeBlock;
+
+		// 0.0 if all free memory is contiguous, approaches 1.0 as free memory is split into many small blocks
+		float GetFragmentation() const
+		{
+			if (freeBytes == 0)
+				return 0.0f;
+			return 1.0f - (float)largestFreeBlock / (float)freeBytes;
+		}
+	};
+
+	TLSFHeap(uint32 heapSize, uint32 granularity = 16);
+	~TLSFHeap();
+
+	TLSFHeap(const TLSFHeap&) = delete;
+	TLSFHeap& operator=(const TLSFHeap&) = delete;
+
+	// returns nullptr if there is no free block which can hold the allocation
+	// sizes are rounded up to the granularity and alignment must be a power of two
+	Block* alloc(uint32 size, uint32 alignment);
+	void free(Block* block);
+
+	bool hasAllocations() const { return m_numAllocations != 0; }
+	uint32 getHeapSize() const { return m_heapSize; }
+	uint32 getAllocatedBytes() const { return m_allocatedBytes; }
+	uint32 getNumAllocations() const { return m_numAllocations; }
+	void getStats(Stats& statsOut) const;
+
+	void verifyHeap() const;
+
+private:
+	static void mapSize(uint32 size, uint32& fl, uint32& sl);
+	static uint64 roundUpToSizeClass(uint64 size);
+	Block* findFreeBlock(uint32 size);
+	Block* findFreeBlockSlow(uint32 size, uint32 alignment, uint64 paddedSize);
+
+	void trackFreeBlock(Block* block);
+	void forgetFreeBlock(Block* block);
+	Block* splitHead(Block* block, uint32 headSize);
+	void splitTail(Block* block, uint32 size);
+
+	const uint32 m_granularity;
+	const uint32 m_heapSize;
+	uint32 m_flBitmap{};
+	uint32 m_slBitmap[TLSF_FL_COUNT]{};
+	Block* m_freeLists[TLSF_FL_COUNT][TLSF_SL_COUNT]{};
+	Block* m_firstBlock;
+	MemoryPool<Block> m_blockPool{256};
+	// statistics
+	uint32 m_allocatedBytes{};
+	uint32 m_numAllocations{};
+	uint32 m_numFreeBlocks{};
+};
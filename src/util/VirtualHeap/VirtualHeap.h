@@ -1,24 +1,24 @@
 #pragma once
+#include "util/helpers/MemoryPool.h"
 
 // virtual heap
 
+class TLSFHeap;
+
 struct VirtualBufferHeapEntry_t
 {
 	uint32 startOffset;
 	uint32 endOffset;
-	VirtualBufferHeapEntry_t* next;
-	VirtualBufferHeapEntry_t* previous;
+	void* internal; // TLSFHeap::Block
 };
 
 struct VirtualBufferHeap_t
 {
 	uint32 virtualSize;
 	void* baseAddress; // base address for _allocateAddr and _freeAddr
-	VirtualBufferHeapEntry_t* firstEntry;
-	// unused entries
-	VirtualBufferHeapEntry_t* firstUnusedEntry;
-	// update tracking
-	uint32 updateTrackIndex;
+	TLSFHeap* heap;
+	MemoryPool<VirtualBufferHeapEntry_t> entryPool{1024};
+	std::unordered_map<uint32, VirtualBufferHeapEntry_t*> addrEntries; // entries allocated via _allocateAddr
 	// stats
 	struct  
 	{
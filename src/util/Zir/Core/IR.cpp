@@ -12,6 +12,8 @@ namespace ZpIR
 		{
 		case IR::OpCode::ADD:
 			return "ADD";
+		case IR::OpCode::SUB:
+			return "SUB";
 		case IR::OpCode::MOV:
 			return "MOV";
 		case IR::OpCode::MUL:
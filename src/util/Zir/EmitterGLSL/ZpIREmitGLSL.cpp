@@ -261,6 +261,13 @@ namespace ZirEmitter
 			appendSourceString(expressionBuf, ins->rC);
 			break;
 		}
+		case ZpIR::IR::OpCode::SUB:
+		{
+			appendSourceString(expressionBuf, ins->rB);
+			expressionBuf->append(" - ");
+			appendSourceString(expressionBuf, ins->rC);
+			break;
+		}
 		case ZpIR::IR::OpCode::MUL:
 		{
 			appendSourceString(expressionBuf, ins->rB);